@@ -24,10 +24,12 @@
  *
  *******************************************************************************/
 #include "include_inliner.hpp"
+#include <miopen/md5.hpp>
 #include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -183,8 +185,14 @@ void Process(const std::string& sourcePath,
         source = &inlinerTemp;
     }
 
+    // The digest of the text as embedded lets the library identify a source without reading it.
+    const std::string text{std::istreambuf_iterator<char>(*source), {}};
+    std::istringstream text_stream(text);
+
     std::transform(variable.begin(), variable.end(), variable.begin(), ::toupper);
-    Bin2Hex(*source, target, variable, true, bufferSize, lineSize);
+    target << "const char " << variable << "_MD5[] = \"" << miopen::md5(text) << "\";"
+           << std::endl;
+    Bin2Hex(text_stream, target, variable, true, bufferSize, lineSize);
 }
 
 int main(int argsn, char** args)
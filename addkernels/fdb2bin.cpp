@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/find_db_image.hpp>
+#include <miopen/md5.hpp>
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+void PrintHelp()
+{
+    std::cout << "Usage: fdb2bin {<option>}" << std::endl;
+    std::cout << "Converts a find-db text file into the binary image loaded by MIOpen."
+              << std::endl;
+    std::cout << "Option format: -<option name>[ <option value>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "[REQUIRED] -s[ource] <path>: find-db text file." << std::endl;
+    std::cout << "[REQUIRED] -t[arget] <path>: image file to write." << std::endl;
+}
+
+[[gnu::noreturn]] void WrongUsage(const std::string& error)
+{
+    std::cout << "Wrong usage: " << error << std::endl;
+    std::cout << std::endl;
+    PrintHelp();
+    std::exit(1);
+}
+
+int main(int argsn, char** args)
+{
+    if(argsn == 1)
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    std::string source_path;
+    std::string target_path;
+
+    for(int i = 1; i < argsn; ++i)
+    {
+        std::string arg(args[i] + 1);
+        std::transform(arg.begin(), arg.end(), arg.begin(), ::tolower);
+
+        if(i + 1 >= argsn)
+            WrongUsage("value is missing for " + arg);
+
+        if(arg == "s" || arg == "source")
+            source_path = args[++i];
+        else if(arg == "t" || arg == "target")
+            target_path = args[++i];
+        else
+            WrongUsage("unknown argument - " + arg);
+    }
+
+    if(source_path.empty() || target_path.empty())
+        WrongUsage("source and target are required");
+
+    std::ifstream source(source_path, std::ios::in | std::ios::binary);
+    if(!source)
+    {
+        std::cerr << "File not found: " << source_path << std::endl;
+        return 1;
+    }
+
+    std::stringstream text;
+    text << source.rdbuf();
+
+    miopen::find_db_image::Writer writer;
+    std::string error;
+
+    if(!writer.Parse(text, error))
+    {
+        std::cerr << source_path << ": " << error << std::endl;
+        return 1;
+    }
+
+    struct stat source_stat = {};
+    if(stat(source_path.c_str(), &source_stat) != 0)
+    {
+        std::cerr << "Unable to stat: " << source_path << std::endl;
+        return 1;
+    }
+
+    const auto source_text = text.str();
+    writer.SetSource(source_text.size(), source_stat.st_mtime, miopen::md5(source_text));
+
+    std::ofstream target(target_path, std::ios::out | std::ios::binary);
+    writer.Write(target);
+
+    if(!target)
+    {
+        std::cerr << "Unable to write: " << target_path << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -39,6 +39,7 @@
 #include "ctc_driver.hpp"
 #include "dropout_driver.hpp"
 #include "tensorop_driver.hpp"
+#include "warmup_driver.hpp"
 #include "miopen/config.h"
 
 int main(int argc, char* argv[])
@@ -165,6 +166,10 @@ int main(int argc, char* argv[])
     {
         drv = new TensorOpDriver<float16, float>();
     }
+    else if(base_arg == "warmup")
+    {
+        drv = new WarmUpDriver();
+    }
     else
     {
         printf("Incorrect BaseArg\n");
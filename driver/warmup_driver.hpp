@@ -0,0 +1,486 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_WARMUP_DRIVER_HPP
+#define GUARD_MIOPEN_WARMUP_DRIVER_HPP
+
+#include "InputFlags.hpp"
+#include "driver.hpp"
+#include "tensor_driver.hpp"
+#include "timer.hpp"
+#include <miopen/miopen.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// Warms up the convolution problems listed in a file, one per line, ahead of running a model.
+/// A line is either an MIOpenDriver conv command, as printed with MIOPEN_ENABLE_LOGGING_CMD=1,
+/// or a find-db line, i.e. a find-db key optionally followed by '=' and the record.
+class WarmUpDriver : public Driver
+{
+    public:
+    WarmUpDriver() : Driver() {}
+
+    int AddCmdLineArgs();
+    int ParseCmdLineArgs(int argc, char* argv[]);
+    InputFlags& GetInputFlags() { return inflags; }
+
+    int GetandSetData();
+    int AllocateBuffersAndCopy() { return 0; }
+
+    int RunForwardGPU();
+    int VerifyForward() { return 0; }
+    int RunBackwardGPU() { return 0; }
+    int VerifyBackward() { return 0; }
+
+    ~WarmUpDriver()
+    {
+        for(auto desc : xDescs)
+            miopenDestroyTensorDescriptor(desc);
+        for(auto desc : wDescs)
+            miopenDestroyTensorDescriptor(desc);
+        for(auto desc : yDescs)
+            miopenDestroyTensorDescriptor(desc);
+        for(auto desc : convDescs)
+            miopenDestroyConvolutionDescriptor(desc);
+    }
+
+    private:
+    InputFlags inflags;
+
+    std::vector<miopenConvDirection_t> directions;
+    std::vector<miopenTensorDescriptor_t> xDescs;
+    std::vector<miopenTensorDescriptor_t> wDescs;
+    std::vector<miopenConvolutionDescriptor_t> convDescs;
+    std::vector<miopenTensorDescriptor_t> yDescs;
+
+    bool ParseDriverCommand(std::istringstream& tokens);
+    bool ParseDbKey(const std::string& key);
+    void AddProblems(int directions_mask,
+                     std::vector<int> x_len,
+                     miopenDataType_t x_type,
+                     std::vector<int> w_len,
+                     miopenDataType_t w_type,
+                     std::vector<int> y_len,
+                     miopenDataType_t y_type,
+                     std::vector<int> pads,
+                     std::vector<int> strides,
+                     std::vector<int> dilations,
+                     std::vector<int> trans_output_pads,
+                     miopenConvolutionMode_t mode,
+                     int group_count);
+};
+
+int WarmUpDriver::AddCmdLineArgs()
+{
+    inflags.AddInputFlag("input",
+                         'i',
+                         "",
+                         "File with the problems to warm up, one per line: MIOpenDriver conv "
+                         "commands or find-db keys",
+                         "string");
+    inflags.AddInputFlag("forw", 'F', "1", "Run the warm-up (Default=1)", "int");
+    inflags.AddInputFlag("verify", 'V', "0", "Unused (Default=0)", "int");
+    return miopenStatusSuccess;
+}
+
+int WarmUpDriver::ParseCmdLineArgs(int argc, char* argv[])
+{
+    inflags.Parse(argc, argv);
+    if(inflags.GetValueStr("input").empty())
+    {
+        std::cout << "No input file given" << std::endl;
+        return miopenStatusBadParm;
+    }
+    return miopenStatusSuccess;
+}
+
+int WarmUpDriver::GetandSetData()
+{
+    std::ifstream file(inflags.GetValueStr("input"));
+    if(!file)
+    {
+        std::cout << "Unable to open " << inflags.GetValueStr("input") << std::endl;
+        return miopenStatusBadParm;
+    }
+
+    std::string line;
+    auto line_number = 0;
+    while(std::getline(file, line))
+    {
+        ++line_number;
+        if(line.empty() || line[0] == '#')
+            continue;
+
+        auto parsed = false;
+        if(line.find("MIOpenDriver") != std::string::npos)
+        {
+            std::istringstream tokens(line.substr(line.find("MIOpenDriver")));
+            std::string driver;
+            tokens >> driver;
+            parsed = ParseDriverCommand(tokens);
+        }
+        else
+        {
+            parsed = ParseDbKey(line.substr(0, line.find('=')));
+        }
+
+        if(!parsed)
+            std::cout << "Skipping line " << line_number << ": " << line << std::endl;
+    }
+
+    std::cout << "Read " << directions.size() << " problems" << std::endl;
+    return miopenStatusSuccess;
+}
+
+bool WarmUpDriver::ParseDriverCommand(std::istringstream& tokens)
+{
+    static const std::map<std::string, std::string> long_names = {
+        {"_", "spatial_dim"},
+        {"F", "forw"},
+        {"n", "batchsize"},
+        {"c", "in_channels"},
+        {"!", "in_d"},
+        {"H", "in_h"},
+        {"W", "in_w"},
+        {"k", "out_channels"},
+        {"@", "fil_d"},
+        {"y", "fil_h"},
+        {"x", "fil_w"},
+        {"#", "conv_stride_d"},
+        {"u", "conv_stride_h"},
+        {"v", "conv_stride_w"},
+        {"$", "pad_d"},
+        {"p", "pad_h"},
+        {"q", "pad_w"},
+        {"^", "dilation_d"},
+        {"l", "dilation_h"},
+        {"j", "dilation_w"},
+        {"%", "trans_output_pad_d"},
+        {"Y", "trans_output_pad_h"},
+        {"X", "trans_output_pad_w"},
+        {"m", "mode"},
+        {"g", "group_count"},
+        {"Z", "tensor_vect"}};
+
+    std::string base;
+    tokens >> base;
+
+    miopenDataType_t type;
+    if(base == "conv")
+        type = miopenFloat;
+    else if(base == "convfp16")
+        type = miopenHalf;
+    else if(base == "convbfp16")
+        type = miopenBFloat16;
+    else if(base == "convint8")
+        type = miopenInt8;
+    else
+        return false;
+
+    // Flags that do not describe the problem, e.g. -t or -S, are ignored.
+    std::map<std::string, std::string> args;
+    std::string flag, value;
+    while(tokens >> flag >> value)
+    {
+        if(flag.size() < 2 || flag[0] != '-')
+            return false;
+        if(flag[1] == '-')
+        {
+            args[flag.substr(2)] = value;
+        }
+        else
+        {
+            const auto name = long_names.find(flag.substr(1));
+            if(name != long_names.end())
+                args[name->second] = value;
+        }
+    }
+
+    const auto get = [&](const std::string& name, int default_value) {
+        const auto arg = args.find(name);
+        return arg == args.end() ? default_value : std::atoi(arg->second.c_str());
+    };
+
+    const auto spatial_dim = get("spatial_dim", 2);
+    if(spatial_dim != 2 && spatial_dim != 3)
+        return false;
+    const auto is_3d = spatial_dim == 3;
+
+    const auto mode =
+        (args.count("mode") != 0 && args["mode"] == "trans") ? miopenTranspose : miopenConvolution;
+    const auto in_c        = get("in_channels", 3);
+    const auto out_c       = get("out_channels", 32);
+    const auto group_count = std::max(get("group_count", 1), 1);
+    if(in_c % group_count != 0 || out_c % group_count != 0)
+        return false;
+    if(type == miopenInt8 && get("tensor_vect", 0) == 1)
+        type = miopenInt8x4;
+
+    std::vector<int> x_len = {get("batchsize", 100), in_c};
+    std::vector<int> w_len = mode == miopenTranspose
+                                 ? std::vector<int>{in_c, out_c / group_count}
+                                 : std::vector<int>{out_c, in_c / group_count};
+    std::vector<int> pads, strides, dilations, trans_output_pads;
+    if(is_3d)
+    {
+        x_len.push_back(get("in_d", 32));
+        w_len.push_back(get("fil_d", 3));
+        pads.push_back(get("pad_d", 0));
+        strides.push_back(get("conv_stride_d", 1));
+        dilations.push_back(get("dilation_d", 1));
+        trans_output_pads.push_back(get("trans_output_pad_d", 0));
+    }
+    x_len.push_back(get("in_h", 32));
+    x_len.push_back(get("in_w", 32));
+    w_len.push_back(get("fil_h", 3));
+    w_len.push_back(get("fil_w", 3));
+    pads.push_back(get("pad_h", 0));
+    pads.push_back(get("pad_w", 0));
+    strides.push_back(get("conv_stride_h", 1));
+    strides.push_back(get("conv_stride_w", 1));
+    dilations.push_back(get("dilation_h", 1));
+    dilations.push_back(get("dilation_w", 1));
+    trans_output_pads.push_back(get("trans_output_pad_h", 0));
+    trans_output_pads.push_back(get("trans_output_pad_w", 0));
+
+    const auto forw   = get("forw", 0);
+    const auto y_type = (type == miopenInt8 || type == miopenInt8x4) ? miopenFloat : type;
+    AddProblems(forw == 0 ? 7 : forw,
+                x_len,
+                type,
+                w_len,
+                type,
+                {},
+                y_type,
+                pads,
+                strides,
+                dilations,
+                trans_output_pads,
+                mode,
+                group_count);
+    return true;
+}
+
+// 2D: C-H-W-FyxFx-K-OH-OW-N-PHxPW-SHxSW-DHxDW-bias-LAYOUT-TYPES-DIR[_gG]
+// 3D: C-D-H-W-FdxFyxFx-K-OD-OH-OW-N-PDxPHxPW-SDxSHxSW-DDxDHxDW-bias-LAYOUT-TYPES-DIR[_gG]
+bool WarmUpDriver::ParseDbKey(const std::string& key)
+{
+    const auto split = [](const std::string& str, char sep) {
+        std::vector<std::string> parts;
+        std::istringstream ss(str);
+        std::string part;
+        while(std::getline(ss, part, sep))
+            parts.push_back(part);
+        return parts;
+    };
+    const auto to_ints = [&](const std::string& str) {
+        std::vector<int> values;
+        for(const auto& part : split(str, 'x'))
+            values.push_back(std::atoi(part.c_str()));
+        return values;
+    };
+
+    const auto fields = split(key, '-');
+    if(fields.size() != 15 && fields.size() != 17)
+        return false;
+    const auto is_3d       = fields.size() == 17;
+    const std::size_t dims = is_3d ? 3 : 2;
+    std::size_t i          = 0;
+    const auto next        = [&]() { return fields[i++]; };
+
+    const auto in_c = std::atoi(next().c_str());
+    std::vector<int> in_spatial;
+    for(std::size_t d = 0; d < dims; ++d)
+        in_spatial.push_back(std::atoi(next().c_str()));
+    const auto filter = to_ints(next());
+    const auto out_c  = std::atoi(next().c_str());
+    std::vector<int> out_spatial;
+    for(std::size_t d = 0; d < dims; ++d)
+        out_spatial.push_back(std::atoi(next().c_str()));
+    const auto n         = std::atoi(next().c_str());
+    const auto pads      = to_ints(next());
+    const auto strides   = to_ints(next());
+    const auto dilations = to_ints(next());
+    const auto bias      = next();
+    const auto layout    = next();
+    auto types           = next();
+    const auto dir_group = split(next(), '_');
+
+    if(filter.size() != dims || pads.size() != dims || strides.size() != dims ||
+       dilations.size() != dims || bias != "0" || (layout != "NCHW" && layout != "NCDHW") ||
+       dir_group.empty() || dir_group[0].size() != 1)
+        return false;
+
+    auto group_count = 1;
+    if(dir_group.size() > 1)
+    {
+        if(dir_group[1].size() < 2 || dir_group[1][0] != 'g')
+            return false;
+        group_count = std::atoi(dir_group[1].c_str() + 1);
+    }
+
+    // The types are either one name or the in, weights and out names concatenated.
+    static const std::vector<std::pair<std::string, miopenDataType_t>> type_names = {
+        {"INT8x4", miopenInt8x4},
+        {"INT8", miopenInt8},
+        {"INT32", miopenInt32},
+        {"FP32", miopenFloat},
+        {"FP16", miopenHalf},
+        {"BF16", miopenBFloat16}};
+    std::vector<miopenDataType_t> data_types;
+    while(!types.empty())
+    {
+        const auto name =
+            std::find_if(type_names.begin(), type_names.end(), [&](const auto& type_name) {
+                return types.compare(0, type_name.first.size(), type_name.first) == 0;
+            });
+        if(name == type_names.end())
+            return false;
+        data_types.push_back(name->second);
+        types = types.substr(name->first.size());
+    }
+    if(data_types.size() == 1)
+        data_types.resize(3, data_types[0]);
+    if(data_types.size() != 3 || group_count < 1)
+        return false;
+
+    // The db key describes the input and output of the direction: for the backward directions
+    // these are the output and the input of the convolution respectively.
+    const auto direction = dir_group[0][0];
+    const auto forward   = direction == 'F';
+    if(!forward && direction != 'B' && direction != 'W')
+        return false;
+
+    std::vector<int> key_in_len  = {n, in_c};
+    std::vector<int> key_out_len = {n, out_c};
+    key_in_len.insert(key_in_len.end(), in_spatial.begin(), in_spatial.end());
+    key_out_len.insert(key_out_len.end(), out_spatial.begin(), out_spatial.end());
+
+    const auto x_c = forward ? in_c : out_c;
+    const auto y_c = forward ? out_c : in_c;
+    if(x_c % group_count != 0)
+        return false;
+    std::vector<int> w_len = {y_c, x_c / group_count};
+    w_len.insert(w_len.end(), filter.begin(), filter.end());
+
+    AddProblems(direction == 'F' ? 1 : direction == 'B' ? 2 : 4,
+                forward ? key_in_len : key_out_len,
+                forward ? data_types[0] : data_types[2],
+                w_len,
+                data_types[1],
+                forward ? key_out_len : key_in_len,
+                forward ? data_types[2] : data_types[0],
+                pads,
+                strides,
+                dilations,
+                std::vector<int>(dims, 0),
+                miopenConvolution,
+                group_count);
+    return true;
+}
+
+void WarmUpDriver::AddProblems(int directions_mask,
+                               std::vector<int> x_len,
+                               miopenDataType_t x_type,
+                               std::vector<int> w_len,
+                               miopenDataType_t w_type,
+                               std::vector<int> y_len,
+                               miopenDataType_t y_type,
+                               std::vector<int> pads,
+                               std::vector<int> strides,
+                               std::vector<int> dilations,
+                               std::vector<int> trans_output_pads,
+                               miopenConvolutionMode_t mode,
+                               int group_count)
+{
+    const auto spatial_dim = static_cast<int>(pads.size());
+
+    for(const auto direction : {miopenConvDirectionForward,
+                                miopenConvDirectionBackwardData,
+                                miopenConvDirectionBackwardWeights})
+    {
+        if((directions_mask & (1 << direction)) == 0)
+            continue;
+
+        miopenTensorDescriptor_t x, w, y;
+        miopenConvolutionDescriptor_t conv;
+        miopenCreateTensorDescriptor(&x);
+        miopenCreateTensorDescriptor(&w);
+        miopenCreateTensorDescriptor(&y);
+        miopenCreateConvolutionDescriptor(&conv);
+
+        SetTensorNd(x, x_len, x_type);
+        SetTensorNd(w, w_len, w_type);
+        miopenInitConvolutionNdDescriptor(
+            conv, spatial_dim, pads.data(), strides.data(), dilations.data(), mode);
+        miopenSetConvolutionGroupCount(conv, group_count);
+        if(mode == miopenTranspose)
+            miopenSetTransposeConvNdOutputPadding(conv, spatial_dim, trans_output_pads.data());
+
+        if(y_len.empty())
+        {
+            auto ndim = static_cast<int>(x_len.size());
+            y_len.resize(ndim);
+            miopenGetConvolutionNdForwardOutputDim(conv, x, w, &ndim, y_len.data());
+        }
+        SetTensorNd(y, y_len, y_type);
+
+        directions.push_back(direction);
+        xDescs.push_back(x);
+        wDescs.push_back(w);
+        convDescs.push_back(conv);
+        yDescs.push_back(y);
+    }
+}
+
+int WarmUpDriver::RunForwardGPU()
+{
+    Timer t;
+    t.start();
+    size_t prepared = 0;
+    const auto status = miopenConvolutionWarmUp(GetHandle(),
+                                                directions.size(),
+                                                directions.data(),
+                                                xDescs.data(),
+                                                wDescs.data(),
+                                                convDescs.data(),
+                                                yDescs.data(),
+                                                &prepared);
+    t.stop();
+
+    if(status != miopenStatusSuccess)
+        return status;
+    std::cout << "Prepared " << prepared << " solutions for " << directions.size()
+              << " problems in " << t.gettime_ms() << " ms" << std::endl;
+    return miopenStatusSuccess;
+}
+
+#endif // GUARD_MIOPEN_WARMUP_DRIVER_HPP
@@ -243,6 +243,76 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
 */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+/*! @enum miopenCacheType_t
+ * In-memory caches of a handle
+ */
+typedef enum {
+    miopenInvokerCache = 0, /*!< Invokers prepared for convolution problems */
+    miopenKernelCache  = 1, /*!< Programs and kernels built or loaded from the binary cache */
+} miopenCacheType_t;
+
+/*! @brief Usage counters of an in-memory cache of a handle
+ */
+typedef struct
+{
+    size_t hits;      /*!< Lookups that found an entry */
+    size_t misses;    /*!< Lookups that did not find an entry */
+    size_t evictions; /*!< Entries removed to stay within the capacity */
+    size_t entries;   /*!< Entries currently held */
+    size_t capacity;  /*!< Maximum number of entries, 0 if unbounded */
+    size_t bytes;     /*!< Approximate memory held by the entries */
+} miopenCacheStats_t;
+
+/*! @brief Get usage counters of an in-memory cache
+ *
+ * @param handle     MIOpen handle (input)
+ * @param cache      Cache to query (input)
+ * @param stats      Pointer to the counters (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetCacheStats(miopenHandle_t handle,
+                                                 miopenCacheType_t cache,
+                                                 miopenCacheStats_t* stats);
+
+/*! @brief Limit the number of entries of an in-memory cache
+ *
+ * The least recently used entries are evicted when the cache grows beyond the capacity.
+ * Evicted entries are rebuilt from the binary kernel cache when they are needed again.
+ * The initial capacities are read from the MIOPEN_INVOKER_CACHE_CAPACITY and
+ * MIOPEN_KERNEL_CACHE_CAPACITY environment variables.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param cache      Cache to limit (input)
+ * @param capacity   Maximum number of entries, 0 removes the limit (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetCacheCapacity(miopenHandle_t handle,
+                                                    miopenCacheType_t cache,
+                                                    size_t capacity);
+
+/*! @brief Start or stop recording trace events
+ *
+ * When tracing is on, MIOpen records the time spent in database lookups, solver selection,
+ * kernel compilation, binary cache loads and invoker preparation, on every thread. Tracing is
+ * process-wide and off by default; setting the MIOPEN_TRACE environment variable to a file name
+ * turns it on at startup and writes the trace to that file at exit.
+ *
+ * @param enable     Start (true) or stop (false) recording (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenEnableTracing(bool enable);
+
+/*! @brief Write the recorded trace events to a file
+ *
+ * The file uses the Chrome trace event JSON format, which can be opened with chrome://tracing
+ * or https://ui.perfetto.dev. Only the most recent events of each thread are kept, up to the
+ * number set by the MIOPEN_TRACE_BUFFER_SIZE environment variable (16384 by default).
+ *
+ * @param path       Name of the file to write (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenWriteTrace(const char* path);
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -1416,6 +1486,44 @@ miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
                                           size_t workSpaceSize,
                                           const uint64_t solution_id);
 
+/*! @enum miopenConvDirection_t
+ * Direction of a convolution problem
+ */
+typedef enum {
+    miopenConvDirectionForward         = 0, /*!< Forward convolution */
+    miopenConvDirectionBackwardData    = 1, /*!< Backward data convolution */
+    miopenConvDirectionBackwardWeights = 2, /*!< Backward weights convolution */
+} miopenConvDirection_t;
+
+/*! @brief Prepares the convolution problems of a model ahead of their first immediate mode call
+ *
+ *   For every problem the find has already been run on, the solutions stored to the find-db are
+ * prepared and their kernels are loaded from the kernel cache, or compiled if missing. The kernel
+ * binaries of all the problems are looked up at once. Problems without find results are skipped.
+ *
+ *   The problems are described the same way for all directions: x is the input and y the output
+ * of the convolution layer.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param problemCount   Number of problems (input)
+ * @param directions     Directions of the problems (input)
+ * @param xDescs         Tensor descriptors for the data tensors x of the problems (input)
+ * @param wDescs         Tensor descriptors for the weight tensors w of the problems (input)
+ * @param convDescs      Convolution layer descriptors of the problems (input)
+ * @param yDescs         Tensor descriptors for the data tensors y of the problems (input)
+ * @param preparedCount  Number of solutions prepared, may be NULL (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionWarmUp(miopenHandle_t handle,
+                        size_t problemCount,
+                        const miopenConvDirection_t* directions,
+                        const miopenTensorDescriptor_t* xDescs,
+                        const miopenTensorDescriptor_t* wDescs,
+                        const miopenConvolutionDescriptor_t* convDescs,
+                        const miopenTensorDescriptor_t* yDescs,
+                        size_t* preparedCount);
+
 /*! @brief Query the workspace size required for a forward convolution layer
  *
  * This call is required and must be executed once before running
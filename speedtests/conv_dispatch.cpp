@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/context.hpp>
+#include <miopen/conv/dispatch_cache.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/invoker_cache.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+namespace miopen {
+namespace speedtests {
+
+/// Measures how long an immediate mode call takes to resolve its invoker, without running any
+/// kernel. The invoker is a stub that is never called, as running it costs the same on both
+/// paths. The slow path is what a call did before the dispatch cache: build a context, build the
+/// problem key and look it up in the InvokerCache. The fast path is a DispatchCache hit.
+struct ConvDispatchSpeedTestDriver : public test_driver
+{
+    ConvDispatchSpeedTestDriver()
+    {
+        add(calls, "calls");
+        add(problems, "problems");
+    }
+
+    void run()
+    {
+        const auto solver_id = solver::Id{"ConvOclDirectFwd"};
+        const auto conv      = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+        const auto weights   = TensorDescriptor{miopenFloat, {64, 64, 3, 3}};
+        const Invoker stub   = [](const Handle&, const boost::any&) {};
+
+        std::vector<TensorDescriptor> ins;
+        std::vector<TensorDescriptor> outs;
+        for(std::size_t i = 0; i < problems; ++i)
+        {
+            ins.emplace_back(miopenFloat, std::vector<std::size_t>{i + 1, 64, 56, 56});
+            outs.push_back(conv.GetForwardOutputTensor(ins.back(), weights));
+        }
+
+        auto invokers = InvokerCache{};
+        auto dispatch = conv::DispatchCache{};
+        for(std::size_t i = 0; i < problems; ++i)
+        {
+            const auto ctx = ConvolutionContext{
+                ins[i], weights, outs[i], conv, conv::Direction::Forward};
+            invokers.Register({ctx.MakeKey(), solver_id.ToString()}, stub);
+            dispatch.Store(MakeKey(solver_id, ins[i], weights, outs[i], conv), stub);
+        }
+
+        std::size_t found = 0;
+        const auto slow   = Measure([&](std::size_t i) {
+            const auto ctx = ConvolutionContext{
+                ins[i], weights, outs[i], conv, conv::Direction::Forward};
+            found += invokers[{ctx.MakeKey(), solver_id.ToString()}] ? 1 : 0;
+        });
+        if(found != calls)
+            MIOPEN_THROW("Some invokers were not found");
+
+        // Problems that collide in the direct-mapped cache miss, and would take the slow path.
+        std::size_t hits = 0;
+        const auto fast  = Measure([&](std::size_t i) {
+            hits += dispatch.Find(MakeKey(solver_id, ins[i], weights, outs[i], conv)) ? 1 : 0;
+        });
+
+        std::cout << "problems, invoker cache (ns/call), dispatch cache (ns/call), hit rate"
+                  << std::endl;
+        std::cout << problems << ", " << slow << ", " << fast << ", "
+                  << static_cast<double>(hits) / calls << std::endl;
+    }
+
+    private:
+    std::size_t calls    = 100000;
+    std::size_t problems = 8;
+
+    static conv::DispatchKey MakeKey(solver::Id solver_id,
+                                     const TensorDescriptor& in,
+                                     const TensorDescriptor& weights,
+                                     const TensorDescriptor& out,
+                                     const ConvolutionDescriptor& conv)
+    {
+        return {conv::Direction::Forward, solver_id, in, weights, out, conv};
+    }
+
+    template <class TCall>
+    double Measure(const TCall& call) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < calls; ++i)
+            call(i % problems);
+        const auto time = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start);
+        return time.count() / calls;
+    }
+};
+
+} // namespace speedtests
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::speedtests::ConvDispatchSpeedTestDriver>(argc, argv);
+    return 0;
+}
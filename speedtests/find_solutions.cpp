@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv_solution.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/find_controls.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+#include <get_handle.hpp>
+#include <network_data.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace miopen {
+namespace speedtests {
+
+/// Measures the host side of the solution lookup done by Find and immediate mode calls over the
+/// convolution shapes used by the tests. No kernels are compiled or run. Run with
+/// MIOPEN_FIND_SOLVERS_PARALLEL_LEVEL=<threads> to compare against the serial default.
+struct FindSolutionsSpeedTestDriver : public test_driver
+{
+    FindSolutionsSpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(batch_factor, "batch-factor");
+    }
+
+    void run()
+    {
+        const auto contexts = MakeContexts();
+
+        // The first pass loads the databases.
+        Measure(contexts);
+
+        auto time      = 0.0;
+        auto solutions = std::size_t{0};
+        for(auto i = 0; i < iterations; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            solutions        = Measure(contexts);
+            time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        std::cout << "threads: " << GetFindSolversParallelLevel()
+                  << ", problems: " << contexts.size() << ", solutions: " << solutions
+                  << ", ms per problem: " << time * 1000 / iterations / contexts.size()
+                  << std::endl;
+    }
+
+    private:
+    int iterations   = 4;
+    int batch_factor = 0;
+
+    std::vector<ConvolutionContext> MakeContexts() const
+    {
+        auto& handle       = get_handle();
+        const auto conv    = ConvolutionDescriptor{};
+        const auto weights = get_weights(batch_factor);
+        auto contexts      = std::vector<ConvolutionContext>{};
+
+        for(const auto& in : get_inputs(batch_factor))
+        {
+            for(const auto& wei : weights)
+            {
+                if(in[1] != wei[1] || in[2] < wei[2] || in[3] < wei[3])
+                    continue;
+
+                const auto x = TensorDescriptor{miopenFloat, in};
+                const auto w = TensorDescriptor{miopenFloat, wei};
+                const auto y = conv.GetForwardOutputTensor(x, w);
+
+                for(const auto direction : {conv::Direction::Forward,
+                                            conv::Direction::BackwardData,
+                                            conv::Direction::BackwardWeights})
+                {
+                    auto ctx = direction == conv::Direction::BackwardData
+                                   ? ConvolutionContext{y, w, x, conv, direction}
+                                   : ConvolutionContext{x, w, y, conv, direction};
+                    ctx.general_compile_options = "";
+                    ctx.SetStream(&handle);
+                    ctx.DetectRocm();
+                    ctx.SetupFloats();
+                    contexts.push_back(ctx);
+                }
+            }
+        }
+        return contexts;
+    }
+
+    static std::size_t Measure(const std::vector<ConvolutionContext>& contexts)
+    {
+        auto solutions = std::size_t{0};
+        for(const auto& ctx : contexts)
+        {
+            if(ctx.direction.IsBackwardWrW())
+            {
+                solutions += FindAllBwdWrW2DSolutions(ctx).size();
+                solutions += FindWinogradWrWAllSolutions(ctx).size();
+                solutions += FindImplicitGemmWrWAllSolutions(ctx).size();
+            }
+            else
+            {
+                solutions += FindAllDirectSolutions(ctx).size();
+                solutions += FindAllWinogradSolutions(ctx).size();
+                solutions += FindAllImplicitGemmSolutions(ctx).size();
+            }
+        }
+        return solutions;
+    }
+};
+
+} // namespace speedtests
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::speedtests::FindSolutionsSpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/fast_hash.hpp>
+#include <miopen/md5.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace speedtests {
+
+/// Compares the hashes used for cache keys on strings the size of kernel sources and build
+/// options: MD5 as used for the on-disk kernel cache, the fast 128-bit hash used for in-process
+/// keys, and std::hash for reference.
+struct HashSpeedTestDriver : public test_driver
+{
+    HashSpeedTestDriver()
+    {
+        add(sizes, "sizes");
+        add(iterations, "iterations");
+    }
+
+    void run()
+    {
+        std::cout << "size, md5 MB/s, md5 of pieces MB/s, fast hash MB/s, std::hash MB/s"
+                  << std::endl;
+        for(const auto size : sizes)
+        {
+            auto args = std::string{};
+            while(args.size() < static_cast<std::size_t>(size))
+                args += " -DMIOPEN_PARAM_" + std::to_string(args.size()) + "=1";
+            args.resize(size);
+            const auto device = std::string{"gfx906"};
+
+            std::cout << size << ", " << Measure(size, [&]() {
+                return md5(device + ":" + args).size();
+            }) << ", " << Measure(size, [&]() {
+                return Md5Hasher{}.Update(device).Update(":").Update(args).HexDigest().size();
+            }) << ", " << Measure(size, [&]() {
+                return static_cast<std::size_t>(
+                    FastHasher{}.Update(device).Update(":").Update(args).Finalize().low);
+            }) << ", " << Measure(size, [&]() {
+                return std::hash<std::string>{}(device + ":" + args);
+            }) << std::endl;
+        }
+    }
+
+    private:
+    std::vector<int> sizes = {64, 1024, 16 * 1024};
+    int iterations         = 16 * 1024;
+
+    template <class F>
+    double Measure(int size, const F& f) const
+    {
+        auto sink        = std::size_t{0};
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; ++i)
+            sink += f();
+        const auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+        if(sink == 1)
+            std::cerr << "Unexpected hash sum" << std::endl;
+        return static_cast<double>(size) * iterations / time.count() / (1024 * 1024);
+    }
+};
+
+} // namespace speedtests
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::speedtests::HashSpeedTestDriver>(argc, argv);
+    return 0;
+}
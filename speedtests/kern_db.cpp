@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+#include <miopen/kern_db.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if MIOPEN_ENABLE_SQLITE
+namespace miopen {
+namespace speedtests {
+
+/// Measures kernel binary lookups in the SQLite kernel cache, as done for each kernel when a
+/// model is loaded. Run with MIOPEN_DEBUG_SQLITE_STATEMENT_CACHE=0 to get the numbers without
+/// prepared statement reuse.
+struct KernDbSpeedTestDriver : public test_driver
+{
+    KernDbSpeedTestDriver()
+    {
+        add(kernels, "kernels");
+        add(lookups, "lookups");
+        add(blob_size, "blob-size");
+    }
+
+    void run()
+    {
+        TempFile file{"miopen.speedtests.kern_db"};
+        const auto configs = MakeConfigs();
+        {
+            KernDb db{file.Path(), false, "gfx906", 64};
+            for(const auto& config : configs)
+                db.StoreRecordUnsafe(config);
+        }
+
+        std::cout << "connection, lookups/s" << std::endl;
+        std::cout << "per lookup, " << Measure(configs, [&]() {
+            return std::make_unique<KernDb>(file.Path(), false, "gfx906", 64);
+        }) << std::endl;
+
+        const auto shared = std::make_shared<KernDb>(file.Path(), false, "gfx906", 64);
+        std::cout << "shared, " << Measure(configs, [&]() {
+            return std::shared_ptr<KernDb>{shared};
+        }) << std::endl;
+    }
+
+    private:
+    int kernels   = 512;
+    int lookups   = 16 * 1024;
+    int blob_size = 4 * 1024;
+
+    std::vector<KernelConfig> MakeConfigs() const
+    {
+        auto configs = std::vector<KernelConfig>{};
+        for(auto i = 0; i < kernels; ++i)
+        {
+            auto config        = KernelConfig{};
+            config.kernel_name = "kernel" + std::to_string(i) + ".o";
+            config.kernel_args = " -DMIOPEN_USE_FP32=1 -DMIOPEN_KERNEL_ID=" + std::to_string(i);
+            config.kernel_blob = std::string(blob_size, static_cast<char>('a' + i % 26));
+            configs.push_back(config);
+        }
+        return configs;
+    }
+
+    template <class TDbGetter>
+    double Measure(const std::vector<KernelConfig>& configs, const TDbGetter& get_db) const
+    {
+        auto found       = 0;
+        const auto start = std::chrono::steady_clock::now();
+
+        for(auto i = 0; i < lookups; ++i)
+        {
+            const auto db = get_db();
+            if(db->FindRecordUnsafe(configs[i % configs.size()]))
+                ++found;
+        }
+
+        const auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+        if(found != lookups)
+            std::cerr << "Unexpected lookup result count: " << found << std::endl;
+
+        return lookups / time.count();
+    }
+};
+
+} // namespace speedtests
+} // namespace miopen
+#endif
+
+int main(int argc, const char* argv[])
+{
+#if MIOPEN_ENABLE_SQLITE
+    test_drive<miopen::speedtests::KernDbSpeedTestDriver>(argc, argv);
+#else
+    (void)(argc);
+    (void)(argv);
+#endif
+    return 0;
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+#include <miopen/kern_db.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if MIOPEN_ENABLE_SQLITE
+namespace miopen {
+namespace speedtests {
+
+/// Compares the kernel database compression codecs on a synthetic corpus of kernel binaries:
+/// the compression ratio, and the time to load all the kernels from a freshly opened database,
+/// as done when a model is loaded.
+struct KernDbCodecSpeedTestDriver : public test_driver
+{
+    KernDbCodecSpeedTestDriver()
+    {
+        add(kernels, "kernels");
+        add(code_size, "code-size");
+        add(runs, "runs");
+    }
+
+    void run()
+    {
+        const auto configs = MakeConfigs();
+        auto total_size    = std::size_t{0};
+        for(const auto& config : configs)
+            total_size += config.kernel_blob.size();
+
+        std::cout << "codec, compression ratio, store MB/s, load kernels/s" << std::endl;
+        for(const auto codec : {CompressionCodec::Bzip2, CompressionCodec::Lz4})
+        {
+            TempFile file{"miopen.speedtests.kern_db_codec"};
+            auto compressed_size = std::size_t{0};
+            const auto compress_fn = [&](const std::string& s, bool* compressed) {
+                auto blob = compress_blob(s, compressed, codec);
+                compressed_size += blob.size();
+                return blob;
+            };
+
+            const auto store_start = std::chrono::steady_clock::now();
+            {
+                KernDb db{file.Path(), false, "gfx906", 64, compress_fn, decompress_blob};
+                for(const auto& config : configs)
+                    db.StoreRecordUnsafe(config);
+            }
+            const auto store_time =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - store_start);
+
+            const auto load_start = std::chrono::steady_clock::now();
+            for(auto i = 0; i < runs; ++i)
+            {
+                KernDb db{file.Path(), false, "gfx906", 64};
+                for(const auto& blob : db.FindRecordsUnsafe(configs))
+                    if(!blob)
+                        std::cerr << "Unexpected lookup miss" << std::endl;
+            }
+            const auto load_time =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - load_start);
+
+            std::cout << ToCString(codec) << ", "
+                      << static_cast<double>(total_size) / compressed_size << ", "
+                      << total_size / store_time.count() / (1024 * 1024) << ", "
+                      << configs.size() * runs / load_time.count() << std::endl;
+        }
+    }
+
+    private:
+    int kernels   = 256;
+    int code_size = 64 * 1024;
+    int runs      = 4;
+
+    /// Code objects mostly consist of instruction words drawn from a small set of opcodes with
+    /// varying operands, plus symbol names and metadata text shared between kernels.
+    std::vector<KernelConfig> MakeConfigs() const
+    {
+        auto rng     = std::mt19937{42};
+        auto opcodes = std::vector<std::uint32_t>(96);
+        for(auto& opcode : opcodes)
+            opcode = rng() & 0xffff0000U;
+
+        auto configs = std::vector<KernelConfig>{};
+        for(auto i = 0; i < kernels; ++i)
+        {
+            auto config        = KernelConfig{};
+            config.kernel_name = "kernel" + std::to_string(i) + ".o";
+            config.kernel_args = " -DMIOPEN_USE_FP32=1 -DMIOPEN_KERNEL_ID=" + std::to_string(i);
+
+            auto& blob = config.kernel_blob;
+            blob       = "\x7f"
+                   "ELF";
+            while(blob.size() < static_cast<std::size_t>(code_size))
+            {
+                const auto word = opcodes[rng() % opcodes.size()] | (rng() % 64) |
+                                  ((rng() % 64) << 8U);
+                blob.append(reinterpret_cast<const char*>(&word), sizeof(word));
+            }
+            for(auto j = 0; j < 16; ++j)
+                blob += "  - .name: MIOpenConvKernel" + std::to_string(i) + "_arg" +
+                        std::to_string(j) + "\n    .size: 8\n    .value_kind: global_buffer\n";
+            configs.push_back(config);
+        }
+        return configs;
+    }
+};
+
+} // namespace speedtests
+} // namespace miopen
+#endif
+
+int main(int argc, const char* argv[])
+{
+#if MIOPEN_ENABLE_SQLITE
+    test_drive<miopen::speedtests::KernDbCodecSpeedTestDriver>(argc, argv);
+#else
+    (void)(argc);
+    (void)(argv);
+#endif
+    return 0;
+}
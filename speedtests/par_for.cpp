@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/par_for.hpp>
+
+#include <driver.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace miopen {
+namespace speedtests {
+
+/// Compares par_for() with starting a thread per share of the work on every call, as par_for()
+/// used to do. Covers many small loops, as in CPU verification of tests, and a loop whose
+/// iterations get more expensive towards the end.
+struct ParForSpeedTestDriver : public test_driver
+{
+    ParForSpeedTestDriver()
+    {
+        add(small_loops, "small-loops");
+        add(small_size, "small-size");
+        add(imbalanced_size, "imbalanced-size");
+    }
+
+    void run()
+    {
+        std::atomic<double> sink{0};
+        const auto small = [&](std::size_t i) { sink = sink + std::sqrt(static_cast<double>(i)); };
+        const auto imbalanced = [&](std::size_t i) {
+            auto sum = 0.0;
+            for(std::size_t j = 0; j < i * 64; ++j)
+                sum += std::sqrt(static_cast<double>(j));
+            sink = sink + sum;
+        };
+
+        std::cout << "loop, per call threads (ms), pool (ms)" << std::endl;
+        std::cout << "small, " << Measure(small_loops, [&]() { SpawnThreads(small_size, small); })
+                  << ", " << Measure(small_loops, [&]() { par_for(small_size, small); })
+                  << std::endl;
+        std::cout << "imbalanced, "
+                  << Measure(1, [&]() { SpawnThreads(imbalanced_size, imbalanced); }) << ", "
+                  << Measure(1, [&]() { par_for(imbalanced_size, imbalanced); }) << std::endl;
+    }
+
+    private:
+    int small_loops     = 2000;
+    int small_size      = 256;
+    int imbalanced_size = 4096;
+
+    template <class TLoop>
+    static double Measure(int calls, const TLoop& loop)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < calls; ++i)
+            loop();
+        const auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+        return time.count() * 1000;
+    }
+
+    template <class F>
+    static void SpawnThreads(std::size_t n, F f)
+    {
+        const auto threads = std::min<std::size_t>(std::thread::hardware_concurrency(), n / 8);
+        if(threads <= 1)
+        {
+            for(std::size_t i = 0; i < n; ++i)
+                f(i);
+            return;
+        }
+
+        const auto grain = (n + threads - 1) / threads;
+        std::vector<joinable_thread> workers;
+        for(std::size_t first = 0; first < n; first += grain)
+        {
+            workers.emplace_back([=]() {
+                for(auto i = first; i < std::min(n, first + grain); ++i)
+                    f(i);
+            });
+        }
+    }
+};
+
+} // namespace speedtests
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::speedtests::ParForSpeedTestDriver>(argc, argv);
+    return 0;
+}
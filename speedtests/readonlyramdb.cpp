@@ -0,0 +1,136 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace speedtests {
+
+/// Measures how ReadonlyRamDb::GetCached() lookups of an already loaded db scale with the
+/// number of threads, as in a server with many handles running immediate mode convolutions.
+struct ReadonlyRamDbSpeedTestDriver : public test_driver
+{
+    ReadonlyRamDbSpeedTestDriver()
+    {
+        add(max_threads, "max-threads");
+        add(lookups, "lookups");
+        add(dbs, "dbs");
+    }
+
+    void run()
+    {
+        const auto files = MakeDbs();
+        auto paths       = std::vector<std::string>{};
+        for(const auto& file : files)
+        {
+            paths.push_back(file->Path());
+            ReadonlyRamDb::GetCached(paths.back(), false); // warm up
+        }
+
+        std::cout << "threads, lookups/s, lookups/s per thread" << std::endl;
+
+        for(auto threads = 1; threads <= max_threads; threads *= 2)
+        {
+            const auto rate = Measure(paths, threads);
+            std::cout << threads << ", " << rate << ", " << rate / threads << std::endl;
+        }
+    }
+
+    private:
+    int max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) * 2);
+    int lookups     = 1024 * 1024;
+    int dbs         = 2;
+
+    std::vector<std::unique_ptr<TempFile>> MakeDbs() const
+    {
+        auto files = std::vector<std::unique_ptr<TempFile>>{};
+        for(auto i = 0; i < dbs; ++i)
+        {
+            files.emplace_back(std::make_unique<TempFile>("miopen.speedtests.readonlyramdb"));
+            std::ofstream(files.back()->Path())
+                << "1-2-3-" << i << "=miopenConvolutionFwdAlgoDirect:ConvAsm1x1U,0.1,0,"
+                << "miopenConvolutionFwdAlgoDirect,<unused>" << std::endl;
+        }
+        return files;
+    }
+
+    double Measure(const std::vector<std::string>& paths, int threads) const
+    {
+        auto workers = std::vector<std::thread>{};
+        std::atomic<int> ready{0};
+        std::atomic<std::size_t> found{0};
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for(auto t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                ++ready;
+                while(ready.load() < threads)
+                    std::this_thread::yield();
+
+                auto local = std::size_t{0};
+                for(auto i = 0; i < lookups; ++i)
+                {
+                    const auto& path = paths[(t + i) % paths.size()];
+                    local += &ReadonlyRamDb::GetCached(path, false) != nullptr ? 1 : 0;
+                }
+                found += local;
+            });
+        }
+
+        for(auto& worker : workers)
+            worker.join();
+
+        const auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+        if(found != static_cast<std::size_t>(threads) * lookups)
+            std::cerr << "Unexpected lookup result count: " << found << std::endl;
+
+        return static_cast<double>(found) / time.count();
+    }
+};
+
+} // namespace speedtests
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::speedtests::ReadonlyRamDbSpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/search_strategy.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace speedtests {
+
+using solver::SearchOptions;
+using solver::SearchStrategy;
+
+/// Compares how fast the tuning search strategies converge, on a mock of an implicit GEMM tuning
+/// space: the tile sizes must divide the problem, tiles that do not fit into LDS fail, and the
+/// time depends on the padding, the number of workgroups and the tile shape. No GPU is needed.
+struct SearchStrategySpeedTestDriver : public test_driver
+{
+    SearchStrategySpeedTestDriver()
+    {
+        add(gemm_m, "gemm-m");
+        add(gemm_n, "gemm-n");
+        add(gemm_k, "gemm-k");
+        add(budget, "budget");
+        add(seeds, "seeds");
+    }
+
+    void run()
+    {
+        const auto features = GetSpace();
+        const auto optimum  = GetOptimum(features, gemm_m, gemm_n, gemm_k);
+        // Configs tuned for similar problems.
+        auto tuned = std::vector<std::vector<float>>{};
+        for(const auto m : {gemm_m / 2, gemm_m * 2})
+            for(const auto n : {gemm_n / 2, gemm_n * 2})
+                tuned.push_back(features[GetBest(features, m, n, gemm_k)]);
+
+        std::cout << features.size() << " configs, budget " << budget << std::endl;
+        std::cout << "strategy, evaluations to 5% of optimum, time at budget / optimum"
+                  << std::endl;
+        // The Model strategy is run with and without the configs tuned for other problems.
+        const auto no_tuned = std::vector<std::vector<float>>{};
+        const auto runs     = {std::make_pair(SearchStrategy::Exhaustive, false),
+                               std::make_pair(SearchStrategy::Random, false),
+                               std::make_pair(SearchStrategy::Annealing, false),
+                               std::make_pair(SearchStrategy::Model, false),
+                               std::make_pair(SearchStrategy::Model, true)};
+        for(const auto& run : runs)
+        {
+            const auto strategy  = run.first;
+            const auto use_tuned = run.second;
+            auto to_target       = 0.0;
+            auto at_budget       = 0.0;
+            for(auto seed = 0; seed < seeds; ++seed)
+            {
+                auto options               = SearchOptions{};
+                options.strategy           = strategy;
+                options.seed               = seed;
+                options.budget.evaluations = budget;
+
+                auto evaluations   = std::size_t{0};
+                auto reached       = std::size_t{0};
+                const auto measure = [&](std::size_t i, float& time) {
+                    ++evaluations;
+                    if(!Measure(features[i], gemm_m, gemm_n, gemm_k, time))
+                        return false;
+                    if(reached == 0 && time <= optimum * 1.05f)
+                        reached = evaluations;
+                    return true;
+                };
+                const auto result =
+                    solver::RunSearch(options, features, use_tuned ? tuned : no_tuned, measure);
+                to_target += reached != 0 ? reached : budget;
+                at_budget += result.best_time / optimum;
+            }
+            std::cout << strategy << (use_tuned ? " (tuned)" : "") << ", " << to_target / seeds
+                      << ", " << std::setprecision(3) << at_budget / seeds << std::endl;
+        }
+    }
+
+    private:
+    int gemm_m = 1024;
+    int gemm_n = 3136;
+    int gemm_k = 576;
+    int budget = 200;
+    int seeds  = 8;
+
+    static std::vector<std::vector<float>> GetSpace()
+    {
+        auto features = std::vector<std::vector<float>>{};
+        for(const auto m_per_block : {32, 64, 128, 256})
+            for(const auto n_per_block : {32, 64, 128, 256})
+                for(const auto k_per_block : {4, 8, 16, 32})
+                    for(const auto m_per_wave : {16, 32, 64})
+                        for(const auto n_per_wave : {16, 32, 64})
+                            for(const auto k_pack : {1, 4, 8})
+                                features.push_back({static_cast<float>(m_per_block),
+                                                    static_cast<float>(n_per_block),
+                                                    static_cast<float>(k_per_block),
+                                                    static_cast<float>(m_per_wave),
+                                                    static_cast<float>(n_per_wave),
+                                                    static_cast<float>(k_pack)});
+        return features;
+    }
+
+    static bool Measure(const std::vector<float>& f, int m, int n, int k, float& time)
+    {
+        const auto m_per_block = f[0];
+        const auto n_per_block = f[1];
+        const auto k_per_block = f[2] * f[5];
+        if(f[3] > m_per_block || f[4] > n_per_block)
+            return false;
+        if((m_per_block + n_per_block) * k_per_block * 4 > 64 * 1024)
+            return false; // LDS
+        const auto waves = (m_per_block / f[3]) * (n_per_block / f[4]);
+        if(waves > 16)
+            return false;
+
+        const auto blocks_m = std::ceil(m / m_per_block);
+        const auto blocks_n = std::ceil(n / n_per_block);
+        const auto steps_k  = std::ceil(k / k_per_block);
+        const auto blocks   = blocks_m * blocks_n;
+        // Compute of a block, its loads, and how well the 64 CUs are used.
+        const auto compute = m_per_block * n_per_block * k_per_block / (waves * f[3] * f[4]);
+        const auto loads   = (m_per_block + n_per_block) * k_per_block / (64.0f * f[5]);
+        const auto rounds  = std::ceil(blocks / 64.0f);
+        time = rounds * steps_k * (std::max(compute, loads) + 20.0f) / waves;
+        return true;
+    }
+
+    static std::size_t GetBest(const std::vector<std::vector<float>>& features, int m, int n, int k)
+    {
+        auto best      = std::size_t{0};
+        auto best_time = std::numeric_limits<float>::max();
+        for(std::size_t i = 0; i < features.size(); ++i)
+        {
+            auto time = 0.0f;
+            if(Measure(features[i], m, n, k, time) && time < best_time)
+            {
+                best      = i;
+                best_time = time;
+            }
+        }
+        return best;
+    }
+
+    static float GetOptimum(const std::vector<std::vector<float>>& features, int m, int n, int k)
+    {
+        auto time = 0.0f;
+        Measure(features[GetBest(features, m, n, k)], m, n, k, time);
+        return time;
+    }
+};
+
+} // namespace speedtests
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::speedtests::SearchStrategySpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/convolution.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/kernel_model.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+#include <get_handle.hpp>
+#include <network_data.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace speedtests {
+
+/// Reports how much of the tuning space of each solver with a kernel model is pruned for the
+/// convolution shapes used by the tests: the configs the model finds infeasible, and those left
+/// out by MIOPEN_TUNING_TOP_K=<top-k>. No kernels are compiled or run.
+struct TuningSpaceSpeedTestDriver : public test_driver
+{
+    TuningSpaceSpeedTestDriver()
+    {
+        add(top_k, "top-k");
+        add(batch_factor, "batch-factor");
+    }
+
+    void run()
+    {
+        const auto contexts = MakeContexts();
+        const auto device   = solver::GetDeviceModel(contexts.front());
+
+        Report(solver::ConvHipImplicitGemmV4R4Fwd{}, contexts, device);
+        Report(solver::ConvHipImplicitGemmV4R4WrW{}, contexts, device);
+        Report(solver::ConvHipImplicitGemmForwardV4R4Xdlops{}, contexts, device);
+        Report(solver::ConvHipImplicitGemmBwdDataV1R1Xdlops{}, contexts, device);
+    }
+
+    private:
+    int top_k        = 32;
+    int batch_factor = 1; // With 0, the shapes have one output channel and no solver applies.
+
+    std::vector<ConvolutionContext> MakeContexts() const
+    {
+        auto& handle       = get_handle();
+        const auto conv    = ConvolutionDescriptor{};
+        const auto weights = get_weights(batch_factor);
+        auto contexts      = std::vector<ConvolutionContext>{};
+
+        for(const auto& in : get_inputs(batch_factor))
+        {
+            for(const auto& wei : weights)
+            {
+                if(in[1] != wei[1] || in[2] < wei[2] || in[3] < wei[3])
+                    continue;
+
+                const auto x = TensorDescriptor{miopenFloat, in};
+                const auto w = TensorDescriptor{miopenFloat, wei};
+                const auto y = conv.GetForwardOutputTensor(x, w);
+
+                for(const auto direction : {conv::Direction::Forward,
+                                            conv::Direction::BackwardData,
+                                            conv::Direction::BackwardWeights})
+                {
+                    // As in the library, the input and output are named after the forward pass
+                    // for every direction: dx, w, dy for backward data.
+                    auto ctx = ConvolutionContext{x, w, y, conv, direction};
+                    ctx.general_compile_options = "";
+                    ctx.SetStream(&handle);
+                    ctx.DetectRocm();
+                    ctx.SetupFloats();
+                    contexts.push_back(ctx);
+                }
+            }
+        }
+        return contexts;
+    }
+
+    template <class Solver>
+    void Report(const Solver& s,
+                const std::vector<ConvolutionContext>& contexts,
+                const solver::DeviceModel& device) const
+    {
+        using PerformanceConfig = decltype(s.GetPerformanceConfig(contexts.front()));
+
+        auto problems   = std::size_t{0};
+        auto configs    = std::size_t{0};
+        auto infeasible = std::size_t{0};
+        auto kept       = std::size_t{0};
+        auto time       = 0.0;
+
+        for(const auto& ctx : contexts)
+        {
+            if(!s.IsApplicable(ctx))
+                continue;
+
+            const auto all = solver::ComputedContainer<PerformanceConfig, ConvolutionContext>{ctx};
+            const auto space = std::vector<PerformanceConfig>(all.begin(), all.end());
+
+            const auto start  = std::chrono::steady_clock::now();
+            const auto models = solver::GetKernelModels(rank<1>{}, space, ctx);
+            const auto ranked = solver::RankKernels(models, device, 0);
+            time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            ++problems;
+            configs += space.size();
+            infeasible += space.size() - ranked.size();
+            kept += std::min<std::size_t>(ranked.size(), top_k);
+        }
+
+        std::cout << SolverDbId(s) << ": problems: " << problems << ", configs: " << configs;
+        if(configs != 0)
+        {
+            std::cout << ", infeasible: " << 100.0 * infeasible / configs
+                      << "%, kept by top-" << top_k << ": " << 100.0 * kept / configs
+                      << "%, ms per problem: " << time * 1000 / problems;
+        }
+        std::cout << std::endl;
+    }
+};
+
+} // namespace speedtests
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::speedtests::TuningSpaceSpeedTestDriver>(argc, argv);
+    return 0;
+}
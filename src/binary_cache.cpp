@@ -26,6 +26,7 @@
 
 #include <miopen/binary_cache.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/kernel.hpp>
 #include <miopen/md5.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/env.hpp>
@@ -35,11 +36,18 @@
 #include <miopen/version.h>
 #include <miopen/sqlite_db.hpp>
 #include <miopen/kern_db.hpp>
+#include <miopen/load_file.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_path.hpp>
+#include <miopen/trace.hpp>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
 
 namespace miopen {
 
@@ -107,7 +115,7 @@ static bool IsCacheDisabled()
 
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
 using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
-KDb GetDb(const std::string& device, size_t num_cu)
+static KDb MakeDb(const std::string& device, size_t num_cu)
 {
     static const auto user_dir = ComputeUserCachePath();
     static const auto sys_dir  = ComputeSysCachePath();
@@ -120,15 +128,131 @@ KDb GetDb(const std::string& device, size_t num_cu)
         sys_path = boost::filesystem::path{};
     return {sys_path.string(), user_path.string(), device, num_cu};
 }
+
+/// A database and the mutex its users hold across every load and store, as the connection and its
+/// prepared statements must not be used by several threads at once.
+template <class Db>
+struct LockedDb
+{
+    explicit LockedDb(Db db_) : db(std::move(db_)) {}
+
+    std::mutex mutex;
+    Db db;
+};
+
+/// The kernel databases (and thus their connections and prepared statements) are kept alive
+/// per device, so that loading many kernels does not resolve the paths and open them each time.
+static LockedDb<KDb>& GetDb(const std::string& device, size_t num_cu)
+{
+    static std::mutex mutex;
+    static auto instances =
+        std::map<std::pair<std::string, size_t>, std::unique_ptr<LockedDb<KDb>>>{};
+
+    std::lock_guard<std::mutex> lock{mutex};
+    auto key      = std::make_pair(device, num_cu);
+    const auto it = instances.find(key);
+    if(it != instances.end())
+        return *it->second;
+    auto db = std::make_unique<LockedDb<KDb>>(MakeDb(device, num_cu));
+    return *instances.emplace(std::move(key), std::move(db)).first->second;
+}
+
+/// The installed kernel database alone, nullptr if there is none.
+static LockedDb<KernDb>* GetInstalledDb(const std::string& device, size_t num_cu)
+{
+    static std::mutex mutex;
+    static auto instances =
+        std::map<std::pair<std::string, size_t>, std::unique_ptr<LockedDb<KernDb>>>{};
+
+    std::lock_guard<std::mutex> lock{mutex};
+    auto key      = std::make_pair(device, num_cu);
+    const auto it = instances.find(key);
+    if(it != instances.end())
+        return it->second.get();
+
+    static const auto sys_dir = ComputeSysCachePath();
+    const auto sys_path = sys_dir / (Handle::GetDbBasename(device, num_cu) + ".kdb");
+    auto db             = std::unique_ptr<LockedDb<KernDb>>{};
+    if(!sys_dir.empty() && boost::filesystem::exists(sys_path))
+        db = std::make_unique<LockedDb<KernDb>>(KernDb{sys_path.string(), true, device, num_cu});
+    return instances.emplace(std::move(key), std::move(db)).first->second.get();
+}
+
+/// Installed kernel databases made before the binaries of the embedded kernels were keyed by their
+/// source digest name those binaries <name>.o. Such a database is installed with the library, so
+/// its binaries were built from the same sources and are looked up by the old name on a miss. The
+/// user kernel cache does not fall back, as its binaries may come from older sources.
+static boost::optional<std::string> FindLegacyBinary(const std::string& device,
+                                                     const size_t num_cu,
+                                                     const std::string& name,
+                                                     const std::string& args)
+{
+    if(GetKernelSrcDigest(name).empty())
+        return boost::none;
+    const auto db = GetInstalledDb(device, num_cu);
+    if(db == nullptr)
+        return boost::none;
+    auto cfg = KernelConfig{name + ".o", args, ""};
+    std::lock_guard<std::mutex> lock{db->mutex};
+    return db->db.FindRecord(cfg);
+}
 #endif
 
+/// Binaries of the cache directory are stored once per content under blobs/ and hard linked from
+/// the per-args directories, so the link count of a blob is the number of files referring to it.
+static boost::filesystem::path GetBlobFile(const boost::filesystem::path& cache_dir,
+                                           const std::string& hash)
+{
+    return cache_dir / "blobs" / (hash + ".o");
+}
+
+/// Turns the file into a hard link to the blob of its contents, creating the blob from it if there
+/// is none. Returns the number of bytes this frees. Filesystems without hard links keep the copy.
+static std::uintmax_t LinkToBlob(const boost::filesystem::path& path,
+                                 const boost::filesystem::path& cache_dir)
+{
+    const auto blob = GetBlobFile(cache_dir, miopen::md5(miopen::LoadFile(path)));
+    auto ec         = boost::system::error_code{};
+    if(!boost::filesystem::exists(blob))
+    {
+        boost::filesystem::create_directories(blob.parent_path());
+        boost::filesystem::create_hard_link(path, blob, ec);
+        return 0;
+    }
+    if(boost::filesystem::equivalent(path, blob))
+        return 0;
+
+    const auto size = boost::filesystem::hard_link_count(path) == 1
+                          ? boost::filesystem::file_size(path)
+                          : std::uintmax_t{0};
+    // Linked under a temporary name first, so that the file is replaced atomically.
+    const auto tmp = path.parent_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_hard_link(blob, tmp, ec);
+    if(ec)
+        return 0;
+    boost::filesystem::rename(tmp, path);
+    return size;
+}
+
+/// Binaries of the embedded kernels are keyed by the digest of their source as well, so that a
+/// kernel is rebuilt once its source has changed. The digest is computed when the library is
+/// built, so a cache hit needs no access to the source text.
+static std::string GetCacheFileName(const std::string& name, bool is_kernel_str)
+{
+    if(is_kernel_str)
+        return miopen::md5(name) + ".o";
+    const auto digest = GetKernelSrcDigest(name);
+    return digest.empty() ? name + ".o" : name + "." + digest + ".o";
+}
+
 boost::filesystem::path GetCacheFile(const std::string& device,
                                      const std::string& name,
                                      const std::string& args,
                                      bool is_kernel_str)
 {
-    std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
-    return GetCachePath(false) / miopen::md5(device + ":" + args) / filename;
+    std::string filename = GetCacheFileName(name, is_kernel_str);
+    return GetCachePath(false) / Md5Hasher{}.Update(device).Update(":").Update(args).HexDigest() /
+           filename;
 }
 
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
@@ -138,14 +262,20 @@ std::string LoadBinary(const std::string& device,
                        const std::string& args,
                        bool is_kernel_str)
 {
+    MIOPEN_TRACE_SPAN_DETAIL("binary_cache", "LoadBinary", name);
     if(miopen::IsCacheDisabled())
         return {};
 
-    auto db              = GetDb(device, num_cu);
-    std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
+    auto& db             = GetDb(device, num_cu);
+    std::string filename = GetCacheFileName(name, is_kernel_str);
     KernelConfig cfg{filename, args, ""};
     MIOPEN_LOG_I2("Loading binary for: " << name << " ;args: " << args);
-    auto record = db.FindRecord(cfg);
+    auto record = [&]() {
+        std::lock_guard<std::mutex> lock{db.mutex};
+        return db.db.FindRecord(cfg);
+    }();
+    if(!record && !is_kernel_str)
+        record = FindLegacyBinary(device, num_cu, name, args);
     if(record)
     {
         MIOPEN_LOG_I2("Sucessfully loaded binary for: " << name << " ;args: " << args);
@@ -158,6 +288,45 @@ std::string LoadBinary(const std::string& device,
     }
 }
 
+std::vector<std::string>
+LoadBinaries(const std::string& device,
+             const size_t num_cu,
+             const std::vector<std::pair<std::string, std::string>>& programs)
+{
+    MIOPEN_TRACE_SPAN_DETAIL(
+        "binary_cache", "LoadBinaries", std::to_string(programs.size()) + " programs");
+    if(miopen::IsCacheDisabled())
+        return std::vector<std::string>(programs.size());
+
+    auto& db  = GetDb(device, num_cu);
+    auto cfgs = std::vector<KernelConfig>{};
+    cfgs.reserve(programs.size());
+    for(const auto& program : programs)
+        cfgs.push_back({GetCacheFileName(program.first, false), program.second, ""});
+
+    auto records = [&]() {
+        std::lock_guard<std::mutex> lock{db.mutex};
+        return db.db.FindRecords(cfgs);
+    }();
+    for(std::size_t i = 0; i < records.size(); ++i)
+    {
+        if(!records[i])
+            records[i] = FindLegacyBinary(device, num_cu, programs[i].first, programs[i].second);
+    }
+    auto binaries = std::vector<std::string>{};
+    binaries.reserve(records.size());
+    for(auto& record : records)
+        binaries.push_back(record ? std::move(record.get()) : std::string{});
+    MIOPEN_LOG_I2("Loaded "
+                  << std::count_if(binaries.begin(),
+                                   binaries.end(),
+                                   [](const auto& binary) { return !binary.empty(); })
+                  << " of "
+                  << binaries.size()
+                  << " binaries");
+    return binaries;
+}
+
 void SaveBinary(const std::string& hsaco,
                 const std::string& device,
                 const std::size_t num_cu,
@@ -168,12 +337,13 @@ void SaveBinary(const std::string& hsaco,
     if(miopen::IsCacheDisabled())
         return;
 
-    auto db = GetDb(device, num_cu);
+    auto& db = GetDb(device, num_cu);
 
-    std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
+    std::string filename = GetCacheFileName(name, is_kernel_str);
     KernelConfig cfg{filename, args, hsaco};
     MIOPEN_LOG_I2("Saving binary for: " << name << " ;args: " << args);
-    db.StoreRecord(cfg);
+    std::lock_guard<std::mutex> lock{db.mutex};
+    db.db.StoreRecord(cfg);
 }
 #else
 boost::filesystem::path LoadBinary(const std::string& device,
@@ -182,6 +352,7 @@ boost::filesystem::path LoadBinary(const std::string& device,
                                    const std::string& args,
                                    bool is_kernel_str)
 {
+    MIOPEN_TRACE_SPAN_DETAIL("binary_cache", "LoadBinary", name);
     if(miopen::IsCacheDisabled())
         return {};
 
@@ -197,6 +368,20 @@ boost::filesystem::path LoadBinary(const std::string& device,
     }
 }
 
+std::vector<boost::filesystem::path>
+LoadBinaries(const std::string& device,
+             const size_t num_cu,
+             const std::vector<std::pair<std::string, std::string>>& programs)
+{
+    MIOPEN_TRACE_SPAN_DETAIL(
+        "binary_cache", "LoadBinaries", std::to_string(programs.size()) + " programs");
+    auto binaries = std::vector<boost::filesystem::path>{};
+    binaries.reserve(programs.size());
+    for(const auto& program : programs)
+        binaries.push_back(LoadBinary(device, num_cu, program.first, program.second));
+    return binaries;
+}
+
 void SaveBinary(const boost::filesystem::path& binary_path,
                 const std::string& device,
                 const std::string& name,
@@ -212,7 +397,66 @@ void SaveBinary(const boost::filesystem::path& binary_path,
         auto p = GetCacheFile(device, name, args, is_kernel_str);
         boost::filesystem::create_directories(p.parent_path());
         boost::filesystem::rename(binary_path, p);
+        LinkToBlob(p, GetCachePath(false));
     }
 }
 #endif
+
+static std::uintmax_t CompactCacheDirectory(const boost::filesystem::path& cache_dir)
+{
+    const auto blobs_dir = cache_dir / "blobs";
+    std::vector<boost::filesystem::path> files;
+    for(const auto& entry : boost::filesystem::recursive_directory_iterator{cache_dir})
+    {
+        if(boost::filesystem::is_regular_file(entry.status()) &&
+           entry.path().extension() == ".o" && entry.path().parent_path() != blobs_dir)
+            files.push_back(entry.path());
+    }
+
+    std::uintmax_t freed = 0;
+    for(const auto& file : files)
+        freed += LinkToBlob(file, cache_dir);
+
+    if(boost::filesystem::exists(blobs_dir))
+    {
+        for(const auto& entry : boost::filesystem::directory_iterator{blobs_dir})
+        {
+            if(boost::filesystem::hard_link_count(entry.path()) > 1)
+                continue;
+            freed += boost::filesystem::file_size(entry.path());
+            boost::filesystem::remove(entry.path());
+        }
+    }
+    return freed;
+}
+
+std::uintmax_t CompactBinaryCache(const boost::filesystem::path& path)
+{
+    if(boost::filesystem::is_directory(path))
+    {
+        auto freed = CompactCacheDirectory(path);
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        for(const auto& entry : boost::filesystem::directory_iterator{path})
+        {
+            if(entry.path().extension() == ".ukdb")
+                freed += CompactBinaryCache(entry.path());
+        }
+#endif
+        return freed;
+    }
+
+#if MIOPEN_ENABLE_SQLITE
+    if(!boost::filesystem::is_regular_file(path))
+        MIOPEN_THROW(miopenStatusBadParm, "Not a kernel cache: " + path.string());
+    const auto size_before = boost::filesystem::file_size(path);
+    {
+        auto db = KernDb{path.string(), false, "", 0};
+        db.Compact();
+    }
+    const auto size_after = boost::filesystem::file_size(path);
+    return size_before > size_after ? size_before - size_after : 0;
+#else
+    MIOPEN_THROW(miopenStatusBadParm, "Not a kernel cache directory: " + path.string());
+#endif
+}
 } // namespace miopen
@@ -440,7 +440,7 @@ class Data : ComgrOwner
     {
         ECI_THROW(amd_comgr_set_data_name(handle, s.c_str()), s);
     }
-    void SetBytes(const std::string& bytes) const
+    void SetBytes(const KernelSourceView& bytes) const
     {
         ECI_THROW(amd_comgr_set_data(handle, bytes.size(), bytes.data()), bytes.size());
     }
@@ -479,7 +479,7 @@ class Dataset : ComgrOwner
     auto GetHandle() const { return handle; }
     void AddData(const Data& d) const { EC_THROW(amd_comgr_data_set_add(handle, d.GetHandle())); }
     void AddData(const std::string& name,
-                 const std::string& content,
+                 const KernelSourceView& content,
                  const amd_comgr_data_kind_t type) const
     {
         const Data d(type);
@@ -492,7 +492,7 @@ class Dataset : ComgrOwner
            (type == AMD_COMGR_DATA_KIND_SOURCE || type == AMD_COMGR_DATA_KIND_INCLUDE))
         {
             const auto text_length = (content.size() > show_first) ? show_first : content.size();
-            const std::string text(content, 0, text_length);
+            const std::string text(content.data(), text_length);
             MIOPEN_LOG_I(text);
         }
     }
@@ -614,7 +614,7 @@ static std::string GetDebugCompilerOptionsInsert()
 }
 
 void BuildHip(const std::string& name,
-              const std::string& text,
+              const KernelSourceView& text,
               const std::string& options,
               const std::string& device,
               std::vector<char>& binary)
@@ -632,7 +632,7 @@ void BuildHip(const std::string& name,
         // Note that we do not need any "subdirs" in the include "pathnames" so far.
         const auto incNames = miopen::GetHipKernelIncList();
         for(const auto& inc : incNames)
-            inputs.AddData(inc, miopen::GetKernelInc(inc), AMD_COMGR_DATA_KIND_INCLUDE);
+            inputs.AddData(inc, miopen::GetKernelIncView(inc), AMD_COMGR_DATA_KIND_INCLUDE);
 
         const ActionInfo action;
         action.SetLanguage(AMD_COMGR_LANGUAGE_HIP);
@@ -700,7 +700,7 @@ void BuildHip(const std::string& name,
 }
 
 void BuildOcl(const std::string& name,
-              const std::string& text,
+              const KernelSourceView& text,
               const std::string& options,
               const std::string& device,
               std::vector<char>& binary)
@@ -780,7 +780,7 @@ void BuildOcl(const std::string& name,
 }
 
 void BuildAsm(const std::string& name,
-              const std::string& text,
+              const KernelSourceView& text,
               const std::string& options,
               const std::string& device,
               std::vector<char>& binary)
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compression.hpp>
+#include <miopen/bz2.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/lz4.hpp>
+
+#include <cctype>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_KERN_DB_CODEC)
+
+namespace miopen {
+namespace {
+
+// bzip2 streams always start with "BZh", so they never collide with the tags.
+const std::string& Lz4Tag()
+{
+    static const std::string tag = "LZ4\x01";
+    return tag;
+}
+
+bool HasTag(const std::string& blob, const std::string& tag)
+{
+    return blob.compare(0, tag.size(), tag) == 0;
+}
+
+CompressionCodec GetCompressionCodecImpl()
+{
+    const char* const p_asciz = miopen::GetStringEnv(MIOPEN_KERN_DB_CODEC{});
+    if(p_asciz == nullptr)
+        return CompressionCodec::Lz4;
+    std::string str = p_asciz;
+    for(auto& c : str)
+        c = tolower(static_cast<unsigned char>(c));
+    if(str == "bz2" || str == "bzip2")
+        return CompressionCodec::Bzip2;
+    if(str == "lz4")
+        return CompressionCodec::Lz4;
+    MIOPEN_LOG_NQE("Wrong MIOPEN_KERN_DB_CODEC, using default.");
+    return CompressionCodec::Lz4;
+}
+
+} // namespace
+
+const char* ToCString(const CompressionCodec codec)
+{
+    switch(codec)
+    {
+    case CompressionCodec::Bzip2: return "bz2";
+    case CompressionCodec::Lz4: return "lz4";
+    }
+    return "<Unknown>";
+}
+
+CompressionCodec GetCompressionCodec()
+{
+    static const CompressionCodec codec = GetCompressionCodecImpl();
+    return codec;
+}
+
+CompressionCodec GetBlobCodec(const std::string& blob)
+{
+    return HasTag(blob, Lz4Tag()) ? CompressionCodec::Lz4 : CompressionCodec::Bzip2;
+}
+
+std::string compress_blob(const std::string& s, bool* compressed, const CompressionCodec codec)
+{
+    switch(codec)
+    {
+    case CompressionCodec::Bzip2: return compress(s, compressed);
+    case CompressionCodec::Lz4: {
+        auto success = false;
+        auto result  = Lz4Tag() + lz4_compress(s, &success);
+        success      = success && result.size() < s.size();
+        if(compressed != nullptr)
+        {
+            *compressed = success;
+            if(!success)
+                return s;
+        }
+        return result;
+    }
+    }
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown compression codec");
+}
+
+std::string decompress_blob(const std::string& s, unsigned int size)
+{
+    switch(GetBlobCodec(s))
+    {
+    case CompressionCodec::Bzip2: return decompress(s, size);
+    case CompressionCodec::Lz4: return lz4_decompress(s.substr(Lz4Tag().size()), size);
+    }
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown compression codec");
+}
+
+} // namespace miopen
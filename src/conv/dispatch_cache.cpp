@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/dispatch_cache.hpp>
+
+#include <miopen/convolution.hpp>
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+struct Fnv1a
+{
+    std::uint64_t value = 0xcbf29ce484222325ULL;
+
+    void Add(std::uint64_t x)
+    {
+        value ^= x;
+        value *= 0x100000001b3ULL;
+    }
+
+    template <class T>
+    void Add(const std::vector<T>& xs)
+    {
+        Add(xs.size());
+        for(const auto x : xs)
+            Add(static_cast<std::uint64_t>(x));
+    }
+
+    void Add(const TensorDescriptor& desc)
+    {
+        Add(static_cast<std::uint64_t>(desc.GetType()));
+        Add(desc.GetLengths());
+        Add(desc.GetStrides());
+    }
+};
+
+bool Same(const TensorDescriptor& left, const TensorDescriptor& right)
+{
+    // TensorDescriptor::operator== asserts on a different number of dimensions.
+    return left.GetType() == right.GetType() && left.GetLengths() == right.GetLengths() &&
+           left.GetStrides() == right.GetStrides();
+}
+
+} // namespace
+
+std::size_t DispatchCache::Hash(const DispatchKey& key)
+{
+    auto hash = Fnv1a{};
+    hash.Add(static_cast<std::uint64_t>(key.direction));
+    hash.Add(key.solver_id.Value());
+    hash.Add(key.in);
+    hash.Add(key.weights);
+    hash.Add(key.out);
+    hash.Add(key.conv.pads);
+    hash.Add(key.conv.strides);
+    hash.Add(key.conv.dilations);
+    hash.Add(static_cast<std::uint64_t>(key.conv.group_count));
+    // Low bits of a multiplicative hash only depend on low bits of the input, and the slot is
+    // picked by the low bits, so mix the high bits down.
+    auto h = hash.value;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+}
+
+bool DispatchCache::Slot::Matches(const DispatchKey& key, std::size_t key_hash) const
+{
+    return invoker && hash == key_hash && direction == key.direction &&
+           solver_id == key.solver_id.Value() && Same(in, key.in) &&
+           Same(weights, key.weights) && Same(out, key.out) &&
+           spatial_dim == key.conv.spatialDim && mode == key.conv.mode &&
+           padding_mode == key.conv.paddingMode && pads == key.conv.pads &&
+           strides == key.conv.strides && dilations == key.conv.dilations &&
+           trans_output_pads == key.conv.trans_output_pads &&
+           group_count == key.conv.group_count && lowp_quant == key.conv.lowp_quant;
+}
+
+const Invoker* DispatchCache::Find(const DispatchKey& key) const
+{
+    const auto hash  = Hash(key);
+    const auto& slot = slots[hash % capacity];
+    return slot.Matches(key, hash) ? &slot.invoker : nullptr;
+}
+
+void DispatchCache::Store(const DispatchKey& key, const Invoker& invoker)
+{
+    const auto hash        = Hash(key);
+    auto& slot             = slots[hash % capacity];
+    slot.hash              = hash;
+    slot.direction         = key.direction;
+    slot.solver_id         = key.solver_id.Value();
+    slot.in                = key.in;
+    slot.weights           = key.weights;
+    slot.out               = key.out;
+    slot.spatial_dim       = key.conv.spatialDim;
+    slot.mode              = key.conv.mode;
+    slot.padding_mode      = key.conv.paddingMode;
+    slot.pads              = key.conv.pads;
+    slot.strides           = key.conv.strides;
+    slot.dilations         = key.conv.dilations;
+    slot.trans_output_pads = key.conv.trans_output_pads;
+    slot.group_count       = key.conv.group_count;
+    slot.lowp_quant        = key.conv.lowp_quant;
+    slot.invoker           = invoker;
+}
+
+void DispatchCache::SetGeneration(std::size_t value)
+{
+    if(value == generation)
+        return;
+    generation = value;
+    for(auto& slot : slots)
+        slot.invoker = Invoker{};
+}
+
+} // namespace conv
+} // namespace miopen
@@ -26,7 +26,7 @@
 
 #include <miopen/conv/problem_description.hpp>
 
-#include <sstream>
+#include <ostream>
 
 namespace miopen {
 
@@ -40,85 +40,55 @@ EncodeDataTypesForKey(miopenDataType_t in, miopenDataType_t weights, miopenDataT
 
 namespace conv {
 
-std::function<void(std::ostream&)>
-PrintDHW(char sep, int spatial_dims, int depth, int height, int width)
+ProblemKey ProblemDescription::MakeKey() const
 {
-    return [=](std::ostream& stream) {
-        if(spatial_dims > 2)
-            stream << depth << sep;
-        stream << height << sep << width;
-    };
-}
+    ProblemKey key;
+    key.spatial_dims      = GetSpatialDims();
+    key.in_channels       = GetInChannels();
+    key.in_depth          = GetInDepth();
+    key.in_height         = GetInHeight();
+    key.in_width          = GetInWidth();
+    key.weights_depth     = GetWeightsDepth();
+    key.weights_height    = GetWeightsHeight();
+    key.weights_width     = GetWeightsWidth();
+    key.out_channels      = GetOutChannels();
+    key.out_depth         = GetOutDepth();
+    key.out_height        = GetOutHeight();
+    key.out_width         = GetOutWidth();
+    key.batch_size        = GetInBatchSize();
+    key.pad_d             = GetPadD();
+    key.pad_h             = GetPadH();
+    key.pad_w             = GetPadW();
+    key.stride_d          = GetKernelStrideD();
+    key.stride_h          = GetKernelStrideH();
+    key.stride_w          = GetKernelStrideW();
+    key.dilation_d        = GetDilationD();
+    key.dilation_h        = GetDilationH();
+    key.dilation_w        = GetDilationW();
+    key.group_count       = GetGroupCount();
+    key.bias              = GetBias();
+    key.in_data_type      = GetInDataType();
+    key.weights_data_type = GetWeightsDataType();
+    key.out_data_type     = GetOutDataType();
 
-std::ostream& operator<<(std::ostream& stream, std::function<void(std::ostream&)>&& manipulator)
-{
-    manipulator(stream);
-    return stream;
+    switch(GetDirection())
+    {
+    case Direction::Forward: key.direction = 'F'; break;
+    case Direction::BackwardData: key.direction = 'B'; break;
+    case Direction::BackwardWeights: key.direction = 'W'; break;
+    }
+
+    key.SetLayout(GetInLayout());
+    key.UpdateHash();
+    return key;
 }
 
 void ProblemDescription::BuildConfKey(std::string& conf_key) const
 {
-    std::ostringstream ss;
-
-    ss << GetInChannels();
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetInDepth(), GetInHeight(), GetInWidth());
-    ss << 'x'
-       << PrintDHW('x', GetSpatialDims(), GetWeightsDepth(), GetWeightsHeight(), GetWeightsWidth());
-    ss << 'x' << GetOutChannels();
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetOutDepth(), GetOutHeight(), GetOutWidth());
-    ss << 'x' << GetInBatchSize();
-    ss << 'x' << GetInLayout();
-    ss << 'x' << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
-    ss << 'x'
-       << PrintDHW(
-              'x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
-    ss << 'x' << GetGroupCount();
-    ss << 'x' << (GetDirection() == Direction::Forward ? "1" : "0");
-
-    conf_key = ss.str();
+    conf_key = MakeKey().ToNetworkConfig();
 }
 
-void ProblemDescription::Serialize(std::ostream& stream) const
-{
-    const auto sep = '-';
-    // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F
-    // clang-format off
-    stream << GetInChannels();
-    stream << sep << PrintDHW(sep, GetSpatialDims(), GetInDepth(), GetInHeight(), GetInWidth());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetWeightsDepth(), GetWeightsHeight(), GetWeightsWidth());
-    stream << sep << GetOutChannels();
-    stream << sep << PrintDHW(sep, GetSpatialDims(), GetOutDepth(), GetOutHeight(), GetOutWidth());
-    stream << sep << GetInBatchSize();
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
-    stream << sep << GetBias();
-    stream << sep << GetInLayout();
-    stream << sep << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
-
-    switch(GetDirection())
-    {
-    case Direction::Forward: stream << sep << "F"; break;
-    case Direction::BackwardData: stream << sep << "B"; break;
-    case Direction::BackwardWeights: stream << sep << "W"; break;
-    }
-
-    // clang-format on
-    // New performance config entries shall come into variable/optional part of db key.
-    // This is to support backward compatibility with previous versions of databases.
-    std::ostringstream optional;
-    {
-        // Group count > 1 identifies Group/Depthwise modes.
-        if(GetGroupCount() != 1)
-            optional << 'g' << GetGroupCount();
-    }
-    if(!optional.str().empty())
-    {
-        stream << '_' << optional.str();
-    }
-}
+void ProblemDescription::Serialize(std::ostream& stream) const { stream << MakeKey().ToDbKey(); }
 
 } // namespace conv
 } // namespace miopen
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/warm_up.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/conv/context.hpp>
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/solver.hpp>
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+struct WarmUpTask
+{
+    ConvolutionContext ctx;
+    ProblemKey key;
+    solver::Id solver_id;
+    Direction direction;
+    solver::ConvSolution solution{miopenStatusUnknownError};
+};
+
+} // namespace
+
+std::size_t WarmUp(Handle& handle, const std::vector<miopen::ProblemDescription>& problems)
+{
+    std::vector<WarmUpTask> tasks;
+
+    for(const auto& problem : problems)
+    {
+        auto ctx = ConvolutionContext{problem};
+        ctx.SetStream(&handle);
+        ctx.DetectRocm();
+        ctx.SetupFloats();
+
+        const auto key       = ctx.MakeKey();
+        const auto direction = problem.conv_problem.GetDirection();
+        const FindDbRecord record{handle, ctx};
+        if(record.empty())
+        {
+            MIOPEN_LOG_I("No find-db record, skipping " << key.ToDbKey());
+            continue;
+        }
+
+        for(const auto& pair : record)
+        {
+            const auto solver_id = solver::Id{pair.second.solver_id};
+            if(!solver_id.IsValid() || !CheckInvokerSupport(pair.first))
+                continue;
+            if(handle.GetInvoker(key, solver_id))
+                continue;
+            tasks.push_back({ctx, key, solver_id, direction});
+        }
+    }
+
+    // The solutions only read the perf-db, which each task opens on its own.
+    par_for(tasks.size(), 1, [&](auto i) {
+        auto& task = tasks[i];
+        try
+        {
+            auto db       = GetDb(task.ctx);
+            task.solution = task.solver_id.GetSolver().FindSolution(task.ctx, db);
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_W("Unable to warm up " << task.solver_id.ToString() << " for "
+                                              << task.key.ToDbKey()
+                                              << ": "
+                                              << ex.what());
+        }
+    });
+
+    std::vector<solver::ConvSolution> solutions;
+    for(const auto& task : tasks)
+    {
+        if(task.solution.Succeeded() && task.solution.invoker_factory)
+            solutions.push_back(task.solution);
+    }
+    solver::PrecompileSolutions(handle, solutions);
+
+    std::size_t prepared = 0;
+    for(const auto& task : tasks)
+    {
+        if(!task.solution.Succeeded() || !task.solution.invoker_factory)
+            continue;
+        auto code_object_bytes = std::size_t{0};
+        const auto invoker     = handle.PrepareInvoker(*task.solution.invoker_factory,
+                                                   task.solution.construction_params,
+                                                   &code_object_bytes);
+        handle.RegisterInvoker(invoker,
+                               task.key,
+                               task.solver_id,
+                               AlgorithmName(task.solver_id.GetAlgo(task.direction)),
+                               code_object_bytes);
+        ++prepared;
+    }
+
+    MIOPEN_LOG_I(prepared << " invokers prepared for " << problems.size() << " problems");
+    return prepared;
+}
+
+} // namespace conv
+} // namespace miopen
@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include <miopen/convolution.hpp>
+#include <miopen/conv/warm_up.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
@@ -960,6 +961,66 @@ miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenConvolutionWarmUp(miopenHandle_t handle,
+                        size_t problemCount,
+                        const miopenConvDirection_t* directions,
+                        const miopenTensorDescriptor_t* xDescs,
+                        const miopenTensorDescriptor_t* wDescs,
+                        const miopenConvolutionDescriptor_t* convDescs,
+                        const miopenTensorDescriptor_t* yDescs,
+                        size_t* preparedCount)
+{
+    MIOPEN_LOG_FUNCTION(
+        handle, problemCount, directions, xDescs, wDescs, convDescs, yDescs, preparedCount);
+    return miopen::try_([&] {
+        if(problemCount > 0 && (directions == nullptr || xDescs == nullptr ||
+                                wDescs == nullptr || convDescs == nullptr || yDescs == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "Problem descriptors cannot be NULL");
+
+        std::vector<miopen::ProblemDescription> problems;
+        problems.reserve(problemCount);
+        for(std::size_t i = 0; i < problemCount; ++i)
+        {
+            auto dir = miopen::conv::Direction::Forward;
+            switch(directions[i])
+            {
+            case miopenConvDirectionForward: dir = miopen::conv::Direction::Forward; break;
+            case miopenConvDirectionBackwardData:
+                dir = miopen::conv::Direction::BackwardData;
+                break;
+            case miopenConvDirectionBackwardWeights:
+                dir = miopen::conv::Direction::BackwardWeights;
+                break;
+            default: MIOPEN_THROW(miopenStatusBadParm, "Unknown convolution direction");
+            }
+
+            const auto& conv = miopen::deref(convDescs[i]);
+            const auto& x    = miopen::deref(xDescs[i]);
+            const auto& y    = miopen::deref(yDescs[i]);
+
+            // Transposed convolutions run the opposite direction with x and y swapped, the same
+            // way the immediate mode calls do.
+            if(conv.mode == miopenTranspose)
+            {
+                if(dir == miopen::conv::Direction::Forward)
+                    dir = miopen::conv::Direction::BackwardData;
+                else if(dir == miopen::conv::Direction::BackwardData)
+                    dir = miopen::conv::Direction::Forward;
+                problems.emplace_back(y, miopen::deref(wDescs[i]), x, conv, dir);
+            }
+            else
+            {
+                problems.emplace_back(x, miopen::deref(wDescs[i]), y, conv, dir);
+            }
+        }
+
+        const auto prepared = miopen::conv::WarmUp(miopen::deref(handle), problems);
+        if(preparedCount != nullptr)
+            *preparedCount = prepared;
+    });
+}
+
 extern "C" miopenStatus_t
 miopenFindConvolutionBackwardDataAlgorithm(miopenHandle_t handle,
                                            const miopenTensorDescriptor_t dyDesc,
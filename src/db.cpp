@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -33,20 +34,35 @@
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/none.hpp>
 #include <boost/optional.hpp>
 
+#include <sys/stat.h>
+
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <ios>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DB_INDEXED_LOOKUP)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DB_WRITE_BEHIND)
+
 namespace miopen {
 
 struct RecordPositions
@@ -54,6 +70,453 @@ struct RecordPositions
     std::streamoff begin = -1;
     std::streamoff end   = -1;
 };
+
+/// Process-wide key->offset index of a text db file, built over a read-only memory mapping.
+///
+/// Snapshots are immutable and shared, so the threads holding the shared db lock may use them
+/// concurrently. A snapshot is considered stale when the identity, size or modification time of
+/// the file changes (which covers writes from other processes), or when this process flushes a
+/// record into the file. All the methods shall be called with the db LockFile held; otherwise
+/// the file may change between the validation and the reading of a snapshot.
+class PlainTextDbIndex
+{
+    private:
+    class PassKey
+    {
+    };
+
+    public:
+    struct Entry
+    {
+        std::streamoff begin;
+        std::streamoff end;
+        int line;
+    };
+
+    struct FileStamp
+    {
+        dev_t device = 0;
+        ino_t inode  = 0;
+        off_t size   = 0;
+        time_t mtime_sec = 0;
+        long mtime_nsec  = 0;
+
+        bool operator==(const FileStamp& other) const
+        {
+            return device == other.device && inode == other.inode && size == other.size &&
+                   mtime_sec == other.mtime_sec && mtime_nsec == other.mtime_nsec;
+        }
+    };
+
+    class Snapshot
+    {
+        public:
+        Snapshot(const std::string& path, const FileStamp& stamp_)
+            : stamp(stamp_), file(path.c_str(), boost::interprocess::read_only)
+        {
+            // Mapping of an empty file is not allowed.
+            if(stamp.size > 0)
+                region = boost::interprocess::mapped_region{file, boost::interprocess::read_only};
+            Build(path);
+        }
+
+        const FileStamp& Stamp() const { return stamp; }
+
+        const Entry* Find(const std::string& key) const
+        {
+            const auto it = entries.find(key);
+            return it == entries.end() ? nullptr : &it->second;
+        }
+
+        std::string Contents(const Entry& entry, std::size_t key_size) const
+        {
+            const auto line_size = static_cast<std::size_t>(entry.end - entry.begin);
+            auto begin           = Data() + entry.begin + key_size + 1;
+            auto size            = line_size - key_size - 1;
+            if(size > 0 && begin[size - 1] == '\n')
+                --size;
+            return {begin, size};
+        }
+
+        private:
+        FileStamp stamp;
+        boost::interprocess::file_mapping file;
+        boost::interprocess::mapped_region region;
+        std::unordered_map<std::string, Entry> entries;
+
+        const char* Data() const { return static_cast<const char*>(region.get_address()); }
+
+        void Build(const std::string& path)
+        {
+            const auto data = Data();
+            const auto size = static_cast<std::size_t>(stamp.size);
+            auto n_line     = 0;
+
+            for(std::size_t line_begin = 0; line_begin < size;)
+            {
+                const auto eol =
+                    static_cast<const char*>(std::memchr(data + line_begin, '\n', size - line_begin));
+                const auto line_end  = eol == nullptr ? size : eol - data;
+                const auto next_line = eol == nullptr ? size : line_end + 1;
+                ++n_line;
+
+                const auto line = data + line_begin;
+                const auto len  = line_end - line_begin;
+                const auto sep  = static_cast<const char*>(std::memchr(line, '=', len));
+
+                if(sep == nullptr || sep == line)
+                {
+                    if(len != 0) // Do not blame empty lines.
+                        MIOPEN_LOG_E("Ill-formed record: key not found: " << path << "#"
+                                                                           << n_line);
+                }
+                else if(sep + 1 == line + len)
+                {
+                    MIOPEN_LOG_E("None contents under the key: "
+                                 << std::string(line, sep) << " form file " << path << "#"
+                                 << n_line);
+                }
+                else
+                {
+                    // The first record with the key wins, the same way as the linear scan does.
+                    entries.emplace(
+                        std::piecewise_construct,
+                        std::forward_as_tuple(line, sep),
+                        std::forward_as_tuple(Entry{static_cast<std::streamoff>(line_begin),
+                                                    static_cast<std::streamoff>(next_line),
+                                                    n_line}));
+                }
+
+                line_begin = next_line;
+            }
+
+            MIOPEN_LOG_I2("Indexed " << entries.size() << " records of " << path);
+        }
+    };
+
+    PlainTextDbIndex(const std::string& path_, PassKey) : path(path_) {}
+    PlainTextDbIndex(const PlainTextDbIndex&) = delete;
+    PlainTextDbIndex& operator=(const PlainTextDbIndex&) = delete;
+
+    static PlainTextDbIndex& Get(const std::string& path)
+    {
+        static std::mutex mutex;
+        static std::map<std::string, PlainTextDbIndex> indices;
+        std::lock_guard<std::mutex> lock(mutex);
+
+        const auto found = indices.find(path);
+        if(found != indices.end())
+            return found->second;
+
+        return indices
+            .emplace(std::piecewise_construct,
+                     std::forward_as_tuple(path),
+                     std::forward_as_tuple(path, PassKey{}))
+            .first->second;
+    }
+
+    /// Returns the snapshot matching the current state of the file, rebuilding it if necessary,
+    /// or nullptr if the file is unreadable.
+    std::shared_ptr<const Snapshot> Acquire()
+    {
+        struct stat st;
+        if(::stat(path.c_str(), &st) != 0)
+        {
+            Invalidate();
+            return nullptr;
+        }
+
+        FileStamp stamp;
+        stamp.device     = st.st_dev;
+        stamp.inode      = st.st_ino;
+        stamp.size       = st.st_size;
+        stamp.mtime_sec  = st.st_mtim.tv_sec;
+        stamp.mtime_nsec = st.st_mtim.tv_nsec;
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if(current != nullptr && current->Stamp() == stamp)
+            return current;
+
+        try
+        {
+            current = std::make_shared<const Snapshot>(path, stamp);
+        }
+        catch(const boost::interprocess::interprocess_exception& ex)
+        {
+            MIOPEN_LOG_W("Unable to map db file <" << path << ">: " << ex.what());
+            current = nullptr;
+        }
+        return current;
+    }
+
+    /// Forces the next Acquire() to rebuild the index. Writers call this after each flush
+    /// because the modification time granularity may hide quick successive changes.
+    void Invalidate()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = nullptr;
+    }
+
+    private:
+    std::string path;
+    std::mutex mutex;
+    std::shared_ptr<const Snapshot> current;
+};
+
+/// Process-wide queue of the changes of a text db file that are not written yet.
+///
+/// A queued record either replaces the record with the same key in the file or is merged into it,
+/// after the ids removed meanwhile are erased from the latter. Only the changes themselves are
+/// queued, they are applied to the current contents of the file when written. Changes to the same
+/// key are coalesced. Readers shall hold the db LockFile while looking into
+/// the queue, and the writer holds it exclusively from taking the queued records until they are
+/// written and dropped from the queue, so readers never miss a change.
+class PlainTextDbWriteQueue
+{
+    private:
+    class PassKey
+    {
+    };
+
+    public:
+    struct Pending
+    {
+        DbRecord record;
+        bool replace = false;
+        /// Ids to erase from the record in the file before merging, unless it is replaced.
+        std::vector<std::string> erased;
+        std::uint64_t version = 0;
+    };
+
+    PlainTextDbWriteQueue(const std::string& path_, PassKey) : path(path_) {}
+    PlainTextDbWriteQueue(const PlainTextDbWriteQueue&) = delete;
+    PlainTextDbWriteQueue& operator=(const PlainTextDbWriteQueue&) = delete;
+
+    static PlainTextDbWriteQueue& Get(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        auto& queues = Registry();
+
+        const auto found = queues.find(path);
+        if(found != queues.end())
+            return found->second;
+
+        return queues
+            .emplace(std::piecewise_construct,
+                     std::forward_as_tuple(path),
+                     std::forward_as_tuple(path, PassKey{}))
+            .first->second;
+    }
+
+    static std::vector<PlainTextDbWriteQueue*> All()
+    {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        auto ret = std::vector<PlainTextDbWriteQueue*>{};
+        for(auto& queue : Registry())
+            ret.push_back(&queue.second);
+        return ret;
+    }
+
+    const std::string& Path() const { return path; }
+
+    void Push(const DbRecord& record, bool replace)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& pending = records[record.GetKey()];
+
+        if(pending.version != 0 && !replace)
+        {
+            // Keep replacing the record in the file if the queued change did so.
+            auto combined = record;
+            combined.Merge(pending.record);
+            pending.record = std::move(combined);
+
+            for(const auto& value : record.map)
+                pending.erased.erase(
+                    std::remove(pending.erased.begin(), pending.erased.end(), value.first),
+                    pending.erased.end());
+        }
+        else
+        {
+            pending.record  = record;
+            pending.replace = replace;
+            pending.erased.clear();
+        }
+
+        pending.version = ++last_version;
+    }
+
+    void Erase(const std::string& key, const std::string& id)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& pending = records[key];
+
+        if(pending.version == 0)
+            pending.record = DbRecord(key);
+
+        pending.record.map.erase(id);
+        if(!pending.replace &&
+           std::find(pending.erased.begin(), pending.erased.end(), id) == pending.erased.end())
+            pending.erased.push_back(id);
+
+        pending.version = ++last_version;
+    }
+
+    boost::optional<Pending> Find(const std::string& key) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto found = records.find(key);
+        if(found == records.end())
+            return boost::none;
+        return found->second;
+    }
+
+    bool Empty() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return records.empty();
+    }
+
+    std::vector<Pending> Take() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto ret = std::vector<Pending>{};
+        for(const auto& pending : records)
+            ret.push_back(pending.second);
+        return ret;
+    }
+
+    /// Drops the records that have not been changed since they were taken.
+    void Drop(const std::vector<Pending>& written)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(const auto& pending : written)
+        {
+            const auto found = records.find(pending.record.GetKey());
+            if(found != records.end() && found->second.version == pending.version)
+                records.erase(found);
+        }
+    }
+
+    private:
+    std::string path;
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Pending> records;
+    std::uint64_t last_version = 0;
+
+    static std::mutex& RegistryMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::map<std::string, PlainTextDbWriteQueue>& Registry()
+    {
+        static std::map<std::string, PlainTextDbWriteQueue> queues;
+        return queues;
+    }
+};
+
+static bool IsWriteBehindEnabled() { return miopen::IsEnabled(MIOPEN_DB_WRITE_BEHIND{}); }
+
+/// Background thread writing the queued changes of all text db files. Changes are written with
+/// a delay to let them coalesce, so that a burst of updates results in a single rewrite of the
+/// file. The last changes are written when the writer is destroyed on process exit.
+class PlainTextDbWriter
+{
+    public:
+    static PlainTextDbWriter& Get()
+    {
+        static PlainTextDbWriter writer;
+        return writer;
+    }
+
+    PlainTextDbWriter(const PlainTextDbWriter&) = delete;
+    PlainTextDbWriter& operator=(const PlainTextDbWriter&) = delete;
+
+    ~PlainTextDbWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wakeup.notify_all();
+        if(thread.joinable())
+            thread.join();
+        FlushAll();
+    }
+
+    void Notify()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = true;
+            if(!thread.joinable())
+                thread = std::thread([this]() { Run(); });
+        }
+        wakeup.notify_all();
+    }
+
+    static void FlushAll()
+    {
+        for(auto queue : PlainTextDbWriteQueue::All())
+        {
+            if(queue->Empty())
+                continue;
+
+            try
+            {
+                PlainTextDb db{queue->Path()};
+                db.FlushQueue();
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_E("Unable to write queued records to " << queue->Path() << ": "
+                                                                  << ex.what());
+            }
+        }
+    }
+
+    private:
+    PlainTextDbWriter() = default;
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    bool pending = false;
+    bool stop    = false;
+    std::thread thread;
+
+    void Run()
+    {
+        constexpr auto delay = std::chrono::milliseconds{100};
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while(true)
+        {
+            wakeup.wait(lock, [&]() { return stop || pending; });
+            if(stop)
+                return;
+            // Let the following changes coalesce with this one.
+            wakeup.wait_for(lock, delay, [&]() { return stop; });
+            pending = false;
+            lock.unlock();
+            FlushAll();
+            lock.lock();
+        }
+    }
+};
+
+void PlainTextDb::FlushPendingWrites()
+{
+    if(IsWriteBehindEnabled())
+        PlainTextDbWriter::FlushAll();
+}
+
+static bool IsIndexedLookupEnabled()
+{
+    return !miopen::IsDisabled(MIOPEN_DEBUG_DB_INDEXED_LOOKUP{});
+}
 /// This makes the interface for the MultiFileDb uniform and
 /// allows reusing it for the SQLite perfdb and the kernel cache.
 PlainTextDb::PlainTextDb(const std::string& filename_,
@@ -67,6 +530,8 @@ PlainTextDb::PlainTextDb(const std::string& filename_,
 PlainTextDb::PlainTextDb(const std::string& filename_, bool is_system)
     : filename(filename_),
       lock_file(LockFile::Get(LockFilePath(filename_).c_str())),
+      index(PlainTextDbIndex::Get(filename_)),
+      queue(PlainTextDbWriteQueue::Get(filename_)),
       warn_if_unreadable(is_system)
 {
     if(!is_system)
@@ -105,6 +570,14 @@ boost::optional<DbRecord> PlainTextDb::FindRecord(const std::string& key)
 
 bool PlainTextDb::StoreRecord(const DbRecord& record)
 {
+    if(IsWriteBehindEnabled())
+    {
+        MIOPEN_LOG_I2("Queueing record: " << record.key);
+        queue.Push(record, true);
+        PlainTextDbWriter::Get().Notify();
+        return true;
+    }
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return StoreRecordUnsafe(record);
@@ -112,6 +585,22 @@ bool PlainTextDb::StoreRecord(const DbRecord& record)
 
 bool PlainTextDb::UpdateRecord(DbRecord& record)
 {
+    if(IsWriteBehindEnabled())
+    {
+        {
+            const auto lock = shared_lock(lock_file, GetLockTimeout());
+            MIOPEN_VALIDATE_LOCK(lock);
+            // Only the change is queued: the record may change in the file before it is written.
+            MIOPEN_LOG_I2("Queueing record update: " << record.key);
+            queue.Push(record, false);
+            const auto old_record = FindRecordUnsafe(record.key, nullptr);
+            if(old_record)
+                record.Merge(*old_record);
+        }
+        PlainTextDbWriter::Get().Notify();
+        return true;
+    }
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return UpdateRecordUnsafe(record);
@@ -119,13 +608,65 @@ bool PlainTextDb::UpdateRecord(DbRecord& record)
 
 bool PlainTextDb::RemoveRecord(const std::string& key)
 {
+    if(IsWriteBehindEnabled())
+    {
+        MIOPEN_LOG_I("Queueing removal of record: " << key);
+        queue.Push(DbRecord(key), true);
+        PlainTextDbWriter::Get().Notify();
+        return true;
+    }
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return RemoveRecordUnsafe(key);
 }
 
+bool PlainTextDb::UpdateRecords(std::vector<DbRecord>& records)
+{
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return FlushQueueUnsafe() && UpdateRecordsUnsafe(records);
+}
+
+std::vector<DbRecord> PlainTextDb::ExportRecords()
+{
+    if(!queue.Empty())
+        FlushQueue();
+
+    const auto lock = shared_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return ExportRecordsUnsafe();
+}
+
+std::vector<std::string> PlainTextDb::FindValues(const std::string& id)
+{
+    auto values = std::vector<std::string>{};
+    for(const auto& record : ExportRecords())
+    {
+        auto value = std::string{};
+        if(record.GetValues(id, value))
+            values.push_back(std::move(value));
+    }
+    return values;
+}
+
 bool PlainTextDb::Remove(const std::string& key, const std::string& id)
 {
+    if(IsWriteBehindEnabled())
+    {
+        {
+            const auto lock = shared_lock(lock_file, GetLockTimeout());
+            MIOPEN_VALIDATE_LOCK(lock);
+            auto record = FindRecordUnsafe(key, nullptr);
+            if(!record || !record->EraseValues(id))
+                return false;
+            MIOPEN_LOG_I2("Queueing removal of " << id << " from record: " << key);
+            queue.Erase(key, id);
+        }
+        PlainTextDbWriter::Get().Notify();
+        return true;
+    }
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     auto record = FindRecordUnsafe(key, nullptr);
@@ -137,6 +678,40 @@ bool PlainTextDb::Remove(const std::string& key, const std::string& id)
     return StoreRecordUnsafe(*record);
 }
 
+bool PlainTextDb::FlushQueue()
+{
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return FlushQueueUnsafe();
+}
+
+bool PlainTextDb::FlushQueueUnsafe()
+{
+    const auto pending = queue.Take();
+    if(pending.empty())
+        return true;
+
+    auto records = std::vector<DbRecord>{};
+    auto replace = std::vector<bool>{};
+    auto erased  = std::vector<std::vector<std::string>>{};
+    for(const auto& item : pending)
+    {
+        records.push_back(item.record);
+        replace.push_back(item.replace);
+        erased.push_back(item.erased);
+    }
+
+    MIOPEN_LOG_I2("Writing " << records.size() << " queued records to " << filename);
+    const auto written = RewriteRecordsUnsafe(records, replace, erased);
+    if(!written)
+        MIOPEN_LOG_E("Failed to write queued records to " << filename);
+
+    // The records have been passed to the file system the same way a synchronous update would do,
+    // so keeping them would not make them more persistent.
+    queue.Drop(pending);
+    return written;
+}
+
 boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
                                                         RecordPositions* pos)
 {
@@ -148,6 +723,82 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
 
     MIOPEN_LOG_I2("Looking for key " << key << " in file " << filename);
 
+    const auto pending = queue.Find(key);
+
+    if(pending && pending->replace)
+    {
+        MIOPEN_LOG_I2("Queued record found: " << key);
+        if(pending->record.GetSize() == 0)
+            return boost::none;
+        return pending->record;
+    }
+
+    auto record = IsIndexedLookupEnabled() ? FindRecordIndexedUnsafe(key, pos)
+                                           : FindRecordScanUnsafe(key, pos);
+
+    if(pending)
+    {
+        MIOPEN_LOG_I2("Queued record update found: " << key);
+        auto merged = pending->record;
+        if(record)
+        {
+            for(const auto& id : pending->erased)
+                record->map.erase(id);
+            merged.Merge(*record);
+        }
+        if(merged.GetSize() == 0)
+            return boost::none;
+        return merged;
+    }
+
+    return record;
+}
+
+boost::optional<DbRecord> PlainTextDb::FindRecordIndexedUnsafe(const std::string& key,
+                                                               RecordPositions* pos)
+{
+    const auto snapshot = index.Acquire();
+
+    if(snapshot == nullptr)
+    {
+        if(warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+            MIOPEN_LOG_W("File is unreadable: " << filename);
+        else
+            MIOPEN_LOG_I2("File is unreadable: " << filename);
+
+        return boost::none;
+    }
+
+    const auto entry = snapshot->Find(key);
+
+    if(entry == nullptr)
+        return boost::none;
+
+    MIOPEN_LOG_I2("Key match: " << key);
+    const auto contents = snapshot->Contents(*entry, key.size());
+    MIOPEN_LOG_I2("Contents found: " << contents);
+
+    DbRecord record(key);
+
+    if(!record.ParseContents(contents))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << filename
+                                                             << "#"
+                                                             << entry->line);
+        MIOPEN_LOG_E("Contents: " << contents);
+    }
+
+    if(pos != nullptr)
+    {
+        pos->begin = entry->begin;
+        pos->end   = entry->end;
+    }
+    return record;
+}
+
+boost::optional<DbRecord> PlainTextDb::FindRecordScanUnsafe(const std::string& key,
+                                                            RecordPositions* pos)
+{
     std::ifstream file(filename);
 
     if(!file)
@@ -242,6 +893,9 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
 {
     assert(pos);
 
+    // Whatever happens below, the file content is not what the index describes anymore.
+    index.Invalidate();
+
     if(pos->begin < 0 || pos->end < 0)
     {
         {
@@ -325,6 +979,181 @@ bool PlainTextDb::UpdateRecordUnsafe(DbRecord& record)
     return result;
 }
 
+bool PlainTextDb::UpdateRecordsUnsafe(std::vector<DbRecord>& records)
+{
+    // Combine records with the same key first, later ones taking precedence.
+    auto updates      = std::vector<DbRecord>{};
+    auto update_index = std::unordered_map<std::string, std::size_t>{};
+
+    for(const auto& record : records)
+    {
+        const auto it = update_index.find(record.key);
+        if(it == update_index.end())
+        {
+            update_index.emplace(record.key, updates.size());
+            updates.push_back(record);
+        }
+        else
+        {
+            auto combined = record;
+            combined.Merge(updates[it->second]);
+            updates[it->second] = std::move(combined);
+        }
+    }
+
+    if(!RewriteRecordsUnsafe(updates, std::vector<bool>(updates.size(), false)))
+        return false;
+
+    for(auto& record : records)
+        record = updates[update_index.at(record.key)];
+    return true;
+}
+
+/// Writes records with unique keys into the file in one pass. Records not flagged to replace the
+/// ones in the file are merged with them, after the erased ids are removed from the latter.
+bool PlainTextDb::RewriteRecordsUnsafe(std::vector<DbRecord>& records,
+                                       const std::vector<bool>& replace,
+                                       const std::vector<std::vector<std::string>>& erased)
+{
+    assert(records.size() == replace.size());
+
+    auto update_index = std::unordered_map<std::string, std::size_t>{};
+    for(auto i = 0u; i < records.size(); ++i)
+        update_index.emplace(records[i].key, i);
+
+    MIOPEN_LOG_I2("Updating " << records.size() << " records in file " << filename);
+
+    // Whatever happens below, the file content is not what the index describes anymore.
+    index.Invalidate();
+
+    const auto temp_name = filename + ".temp";
+    auto written         = std::vector<bool>(records.size(), false);
+
+    {
+        std::ifstream from(filename);
+        std::ofstream to(temp_name);
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+
+        auto line   = std::string{};
+        auto n_line = 0;
+
+        while(from && std::getline(from, line))
+        {
+            ++n_line;
+            const auto key_size = line.find('=');
+
+            if(key_size != std::string::npos && key_size != 0)
+            {
+                const auto it = update_index.find(line.substr(0, key_size));
+
+                // Only the first record with a key is visible for lookups, so only that one is
+                // updated.
+                if(it != update_index.end() && !written[it->second])
+                {
+                    auto& update = records[it->second];
+
+                    if(!replace[it->second])
+                    {
+                        auto old = DbRecord(update.key);
+
+                        if(old.ParseContents(line.substr(key_size + 1)))
+                        {
+                            if(it->second < erased.size())
+                                for(const auto& id : erased[it->second])
+                                    old.map.erase(id);
+                            update.Merge(old);
+                        }
+                        else
+                            MIOPEN_LOG_E("Error parsing payload under the key: "
+                                         << update.key << " form file " << filename << "#"
+                                         << n_line);
+                    }
+
+                    update.WriteContents(to);
+                    written[it->second] = true;
+                    continue;
+                }
+            }
+
+            to << line << '\n';
+        }
+
+        for(auto i = 0u; i < records.size(); ++i)
+            if(!written[i])
+                records[i].WriteContents(to);
+
+        if(!to.flush())
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+    }
+
+    std::remove(filename.c_str());
+    std::rename(temp_name.c_str(), filename.c_str());
+    /// \todo What if rename fails? Thou shalt not loose the original file.
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
+    return true;
+}
+
+std::vector<DbRecord> PlainTextDb::ExportRecordsUnsafe()
+{
+    std::ifstream file(filename);
+
+    if(!file)
+    {
+        if(warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+            MIOPEN_LOG_W("File is unreadable: " << filename);
+        else
+            MIOPEN_LOG_I2("File is unreadable: " << filename);
+
+        return {};
+    }
+
+    auto records = std::vector<DbRecord>{};
+    auto keys    = std::unordered_set<std::string>{};
+    auto line    = std::string{};
+    auto n_line  = 0;
+
+    while(std::getline(file, line))
+    {
+        ++n_line;
+        const auto key_size = line.find('=');
+        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+
+        if(!is_key)
+        {
+            if(!line.empty()) // Do not blame empty lines.
+                MIOPEN_LOG_E("Ill-formed record: key not found: " << filename << "#" << n_line);
+            continue;
+        }
+
+        auto record = DbRecord(line.substr(0, key_size));
+
+        if(!keys.insert(record.key).second)
+            continue;
+
+        if(!record.ParseContents(line.substr(key_size + 1)))
+        {
+            MIOPEN_LOG_E("Error parsing payload under the key: " << record.key << " form file "
+                                                                 << filename
+                                                                 << "#"
+                                                                 << n_line);
+            continue;
+        }
+
+        records.push_back(std::move(record));
+    }
+
+    MIOPEN_LOG_I2("Exported " << records.size() << " records from file " << filename);
+    return records;
+}
+
 bool PlainTextDb::RemoveRecordUnsafe(const std::string& key)
 {
     // Create empty record with same key and replace original with that
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/fast_hash.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace miopen {
+namespace {
+
+constexpr std::uint64_t c1 = 0x87c37b91114253d5ULL;
+constexpr std::uint64_t c2 = 0x4cf5ad432745937fULL;
+
+std::uint64_t Rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+std::uint64_t Mix(std::uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+// Reads little-endian words, as MurmurHash3 is specified on them.
+std::uint64_t Read64(const unsigned char* p)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+#else
+    std::uint64_t v = 0;
+    for(auto i = 7; i >= 0; --i)
+        v = (v << 8) | p[i];
+#endif
+    return v;
+}
+
+void Block(std::uint64_t& h1, std::uint64_t& h2, const unsigned char* p)
+{
+    auto k1 = Read64(p);
+    auto k2 = Read64(p + 8);
+
+    k1 *= c1;
+    k1 = Rotl(k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+    h1 = Rotl(h1, 27);
+    h1 += h2;
+    h1 = h1 * 5 + 0x52dce729;
+
+    k2 *= c2;
+    k2 = Rotl(k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+    h2 = Rotl(h2, 31);
+    h2 += h1;
+    h2 = h2 * 5 + 0x38495ab5;
+}
+
+} // namespace
+
+std::string Hash128::ToString() const
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(32, '0');
+    for(auto i = 0; i < 16; ++i)
+    {
+        hex[15 - i] = digits[(high >> (4 * i)) & 0xf];
+        hex[31 - i] = digits[(low >> (4 * i)) & 0xf];
+    }
+    return hex;
+}
+
+FastHasher& FastHasher::Update(const void* data, std::size_t size)
+{
+    const auto* p = static_cast<const unsigned char*>(data);
+    auto used     = static_cast<std::size_t>(length % sizeof(tail));
+    length += size;
+
+    if(used != 0)
+    {
+        const auto n = std::min(size, sizeof(tail) - used);
+        std::memcpy(tail + used, p, n);
+        p += n;
+        size -= n;
+        if(used + n < sizeof(tail))
+            return *this;
+        Block(h1, h2, tail);
+    }
+
+    for(; size >= sizeof(tail); p += sizeof(tail), size -= sizeof(tail))
+        Block(h1, h2, p);
+
+    std::memcpy(tail, p, size);
+    return *this;
+}
+
+FastHasher& FastHasher::UpdatePiece(const std::string& s)
+{
+    const auto size = static_cast<std::uint64_t>(s.size());
+    return Update(&size, sizeof(size)).Update(s);
+}
+
+Hash128 FastHasher::Finalize() const
+{
+    auto a          = h1;
+    auto b          = h2;
+    const auto used = static_cast<std::size_t>(length % sizeof(tail));
+
+    unsigned char rest[16] = {};
+    std::memcpy(rest, tail, used);
+    auto k1 = Read64(rest);
+    auto k2 = Read64(rest + 8);
+    if(used > 8)
+    {
+        k2 *= c2;
+        k2 = Rotl(k2, 33);
+        k2 *= c1;
+        b ^= k2;
+    }
+    if(used > 0)
+    {
+        k1 *= c1;
+        k1 = Rotl(k1, 31);
+        k1 *= c2;
+        a ^= k1;
+    }
+
+    a ^= length;
+    b ^= length;
+    a += b;
+    b += a;
+    a = Mix(a);
+    b = Mix(b);
+    a += b;
+    b += a;
+
+    auto result = Hash128{};
+    result.low  = a;
+    result.high = b;
+    return result;
+}
+
+Hash128 fast_hash(const std::string& s) { return FastHasher{}.Update(s).Finalize(); }
+
+} // namespace miopen
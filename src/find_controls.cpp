@@ -29,6 +29,7 @@
 #include <miopen/env.hpp>
 #include <miopen/solver_id.hpp>
 
+#include <algorithm>
 #include <ostream>
 #include <cstdlib>
 #include <cstring>
@@ -37,6 +38,7 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_ENFORCE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_ENFORCE_SCOPE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FIND_ONLY_SOLVER)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_MODE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_SOLVERS_PARALLEL_LEVEL)
 
 namespace miopen {
 
@@ -185,6 +187,11 @@ solver::Id GetEnvFindOnlySolver()
     return once;
 }
 
+std::size_t GetFindSolversParallelLevel()
+{
+    return std::max<std::size_t>(Value(MIOPEN_FIND_SOLVERS_PARALLEL_LEVEL{}, 1), 1);
+}
+
 namespace {
 
 const char* ToCString(const FindMode::Values mode)
@@ -30,7 +30,13 @@
 #include <miopen/finddb_kernel_cache_key.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/perf_field.hpp>
+#include <miopen/solution_ranker.hpp>
+#include <miopen/stringutils.hpp>
 
+#include <boost/filesystem/operations.hpp>
+
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -67,6 +73,38 @@ std::string FindDbRecord_t<TDb>::GetUserPath(Handle& handle)
 #endif
 }
 
+template <class TDb>
+const SolutionRanker& FindDbRecord_t<TDb>::GetRanker(Handle& handle)
+{
+    static std::mutex mutex;
+    static std::map<std::string, SolutionRanker> rankers;
+    static const SolutionRanker disabled;
+
+    if(!testing_find_db_enabled || IsEnabled(MIOPEN_DEBUG_DISABLE_FIND_DB{}))
+        return disabled;
+
+    auto paths = std::vector<std::string>{};
+    if(testing_find_db_path_override())
+        paths.push_back(*testing_find_db_path_override());
+    else
+        paths = {GetInstalledPath(handle), GetUserPath(handle)};
+
+    // Records stored by this process after the ranker was loaded are not taken into account.
+    const std::lock_guard<std::mutex> lock(mutex);
+    const auto key = JoinStrings(paths, ";");
+    auto found     = rankers.find(key);
+    if(found != rankers.end())
+        return found->second;
+
+    auto& ranker = rankers[key];
+    for(const auto& path : paths)
+    {
+        if(!path.empty() && boost::filesystem::exists(path))
+            MIOPEN_LOG_I2(path << ": " << ranker.Load(path) << " records for the fallback ranking");
+    }
+    return ranker;
+}
+
 bool CheckInvokerSupport(const std::string& algo)
 {
     return algo == "miopenConvolutionFwdAlgoDirect" ||
@@ -80,18 +118,18 @@ bool CheckInvokerSupport(const std::string& algo)
 }
 
 template <class TDb>
-bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config) const
+bool FindDbRecord_t<TDb>::Validate(Handle& handle, const ProblemKey& problem) const
 {
     auto unbuilt = false;
     auto any     = false;
 
-    for(const auto& pair : content->As<FindDbData>())
+    for(const auto& pair : items)
     {
         if(in_sync)
         {
             if(CheckInvokerSupport(pair.first))
             {
-                if(!handle.GetInvoker(config, {{pair.second.solver_id}}))
+                if(!handle.GetInvoker(problem, {{pair.second.solver_id}}))
                 {
                     unbuilt = true;
                     // This is not an logged as error because no error was detected.
@@ -127,13 +165,19 @@ bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config)
 template <class TDb>
 void FindDbRecord_t<TDb>::CopyTo(std::vector<PerfField>& to) const
 {
-    const auto range = content->As<FindDbData>();
-    std::transform(range.begin(), range.end(), std::back_inserter(to), [](const auto& pair) {
+    std::transform(items.begin(), items.end(), std::back_inserter(to), [](const auto& pair) {
         return PerfField{
             pair.first, pair.second.solver_id, pair.second.time, pair.second.workspace};
     });
 }
 
+template <class TDb>
+void FindDbRecord_t<TDb>::LoadItems()
+{
+    const auto range = content->As<FindDbData>();
+    items.assign(range.begin(), range.end());
+}
+
 template <class TDb>
 void FindDbRecord_t<TDb>::LogFindDbItem(const std::pair<std::string, FindDbData>& pair,
                                         bool log_as_error) const
@@ -144,13 +188,13 @@ void FindDbRecord_t<TDb>::LogFindDbItem(const std::pair<std::string, FindDbData>
         log_level,
         "Kernel cache entry not found for solver <" << pair.first << "::" << pair.second.solver_id
                                                     << "> at network config: "
-                                                    << content->GetKey()
+                                                    << (content ? content->GetKey() : "")
                                                     << " and kernel cache key: "
                                                     << pair.second.kcache_key.algorithm_name
                                                     << ", "
                                                     << pair.second.kcache_key.network_config);
 
-    for(const auto& pair2 : content->As<FindDbData>())
+    for(const auto& pair2 : items)
         MIOPEN_LOG(log_level,
                    "Find-db record content: <" << pair2.first << "::" << pair2.second.solver_id
                                                << "> at network config: "
@@ -1057,6 +1057,8 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
             return status;
         }
     }
+    // Nothing but compiling the plan builds its kernels, so they must not be evicted.
+    handle.PinKernels(algorithm_name, network_config);
     arg_list = CalcArgOrder(handle);
     return status;
 }
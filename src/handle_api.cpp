@@ -27,6 +27,7 @@
 #include <miopen/version.h>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/trace.hpp>
 
 extern "C" const char* miopenGetErrorString(miopenStatus_t error)
 {
@@ -110,3 +111,53 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+extern "C" miopenStatus_t
+miopenGetCacheStats(miopenHandle_t handle, miopenCacheType_t cache, miopenCacheStats_t* stats)
+{
+    return miopen::try_([&] {
+        const auto& h = miopen::deref(handle);
+        miopen::CacheStats result;
+        if(cache == miopenInvokerCache)
+            result = h.GetInvokerCacheStats();
+        else if(cache == miopenKernelCache)
+            result = h.GetKernelCacheStats();
+        else
+            MIOPEN_THROW(miopenStatusBadParm, "Unknown cache type");
+        auto& out     = miopen::deref(stats);
+        out.hits      = result.hits;
+        out.misses    = result.misses;
+        out.evictions = result.evictions;
+        out.entries   = result.entries;
+        out.capacity  = result.capacity;
+        out.bytes     = result.bytes;
+    });
+}
+
+extern "C" miopenStatus_t
+miopenSetCacheCapacity(miopenHandle_t handle, miopenCacheType_t cache, size_t capacity)
+{
+    return miopen::try_([&] {
+        auto& h = miopen::deref(handle);
+        if(cache == miopenInvokerCache)
+            h.SetInvokerCacheCapacity(capacity);
+        else if(cache == miopenKernelCache)
+            h.SetKernelCacheCapacity(capacity);
+        else
+            MIOPEN_THROW(miopenStatusBadParm, "Unknown cache type");
+    });
+}
+
+extern "C" miopenStatus_t miopenEnableTracing(bool enable)
+{
+    return miopen::try_([&] { miopen::trace::Enable(enable); });
+}
+
+extern "C" miopenStatus_t miopenWriteTrace(const char* path)
+{
+    return miopen::try_([&] {
+        if(path == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Trace file name is null");
+        miopen::trace::WriteChromeTrace(std::string{path});
+    });
+}
@@ -94,11 +94,8 @@ boost::filesystem::path HipBuild(boost::optional<TmpDir>& tmp_dir,
     auto inc_list = GetKernelIncList();
     auto inc_path = tmp_dir->path;
     boost::filesystem::create_directories(inc_path);
-    for(auto inc_file : inc_list)
-    {
-        auto inc_src = GetKernelInc(inc_file);
-        WriteFile(inc_src, inc_path / inc_file);
-    }
+    for(const auto& inc_file : inc_list)
+        WriteFile(GetKernelIncView(inc_file), inc_path / inc_file);
     src += "\nint main() {}\n";
     WriteFile(src, tmp_dir->path / filename);
 
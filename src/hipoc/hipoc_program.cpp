@@ -118,11 +118,12 @@ struct HIPOCProgramImpl
     HIPOCProgramImpl(const std::string& program_name, const boost::filesystem::path& filespec)
         : program(program_name), hsaco_file(filespec)
     {
-        module = CreateModule(hsaco_file);
+        module           = CreateModule(hsaco_file);
+        code_object_size = boost::filesystem::file_size(hsaco_file);
     }
 
     HIPOCProgramImpl(const std::string& program_name, const std::string& blob)
-        : program(program_name), module(CreateModuleInMem(blob))
+        : program(program_name), module(CreateModuleInMem(blob)), code_object_size(blob.size())
     {
     }
 
@@ -135,21 +136,29 @@ struct HIPOCProgramImpl
     {
         BuildCodeObject(params, is_kernel_str, kernel_src);
         if(!binary.empty())
-            module = CreateModuleInMem(binary);
+        {
+            module           = CreateModuleInMem(binary);
+            code_object_size = binary.size();
+        }
         else
-            module = CreateModule(hsaco_file);
+        {
+            module           = CreateModule(hsaco_file);
+            code_object_size = boost::filesystem::file_size(hsaco_file);
+        }
     }
 
     std::string program;
     std::string device;
     boost::filesystem::path hsaco_file;
     hipModulePtr module;
+    std::size_t code_object_size = 0;
     boost::optional<TmpDir> dir;
     std::vector<char> binary;
 
 #if !MIOPEN_USE_COMGR
-    void
-    BuildCodeObjectInFile(std::string& params, const std::string& src, const std::string& filename)
+    void BuildCodeObjectInFile(std::string& params,
+                               const KernelSourceView& src,
+                               const std::string& filename)
     {
         dir.emplace(filename);
         hsaco_file = dir->path / (filename + ".o");
@@ -160,12 +169,12 @@ struct HIPOCProgramImpl
         }
         else if(miopen::EndsWith(filename, ".s"))
         {
-            const auto assembled = AmdgcnAssemble(src, params);
+            const auto assembled = AmdgcnAssemble(src.str(), params);
             WriteFile(assembled, hsaco_file);
         }
         else if(miopen::EndsWith(filename, ".cpp"))
         {
-            hsaco_file = HipBuild(dir, filename, src, params, device);
+            hsaco_file = HipBuild(dir, filename, src.str(), params, device);
         }
         else
         {
@@ -179,14 +188,14 @@ struct HIPOCProgramImpl
 
 #else // MIOPEN_USE_COMGR
     void BuildCodeObjectInMemory(const std::string& params,
-                                 const std::string& src,
+                                 const KernelSourceView& src,
                                  const std::string& filename)
     {
         if(miopen::EndsWith(filename, ".so"))
         {
-            std::size_t sz = src.length();
+            std::size_t sz = src.size();
             binary.resize(sz);
-            std::memcpy(&binary[0], src.c_str(), sz);
+            std::memcpy(&binary[0], src.data(), sz);
         }
         else
         {
@@ -210,8 +219,11 @@ struct HIPOCProgramImpl
     {
         std::string filename = is_kernel_str ? "tinygemm.cl" // Fixed name for miopengemm.
                                              : program;
-        const std::string src =
-            !kernel_src.empty() ? kernel_src : is_kernel_str ? program : GetKernelSrc(program);
+        // Embedded sources are built in place rather than copied.
+        const KernelSourceView src = !kernel_src.empty()
+                                         ? KernelSourceView{kernel_src}
+                                         : is_kernel_str ? KernelSourceView{program}
+                                                         : GetKernelSrcView(program);
 
         if(miopen::EndsWith(filename, ".cpp"))
         {
@@ -269,4 +281,9 @@ std::string HIPOCProgram::GetCodeObjectBlob() const
 
 bool HIPOCProgram::IsCodeObjectInMemory() const { return !impl->binary.empty(); };
 
+std::size_t HIPOCProgram::GetCodeObjectSize() const
+{
+    return impl == nullptr ? 0 : impl->code_object_size;
+}
+
 } // namespace miopen
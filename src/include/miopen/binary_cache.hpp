@@ -29,7 +29,10 @@
 
 #include <miopen/config.h>
 #include <boost/filesystem/path.hpp>
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace miopen {
 
@@ -40,12 +43,21 @@ boost::filesystem::path GetCacheFile(const std::string& device,
 
 boost::filesystem::path GetCachePath(bool is_system);
 
+/// Deduplicates the binaries of a user kernel cache, either a kernel database or a cache
+/// directory, and drops the ones nothing refers to anymore. Returns the number of bytes freed.
+std::uintmax_t CompactBinaryCache(const boost::filesystem::path& path);
+
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
 boost::filesystem::path LoadBinary(const std::string& device,
                                    std::size_t num_cu,
                                    const std::string& name,
                                    const std::string& args,
                                    bool is_kernel_str = false);
+/// Looks up the binaries of several (name, args) programs. Empty paths stand for misses.
+std::vector<boost::filesystem::path>
+LoadBinaries(const std::string& device,
+             std::size_t num_cu,
+             const std::vector<std::pair<std::string, std::string>>& programs);
 void SaveBinary(const boost::filesystem::path& binary_path,
                 const std::string& device,
                 const std::string& name,
@@ -58,6 +70,13 @@ std::string LoadBinary(const std::string& device,
                        const std::string& args,
                        bool is_kernel_str = false);
 
+/// Looks up the binaries of several (name, args) programs in one pass over the database.
+/// Empty strings stand for misses.
+std::vector<std::string>
+LoadBinaries(const std::string& device,
+             std::size_t num_cu,
+             const std::vector<std::pair<std::string, std::string>>& programs);
+
 void SaveBinary(const std::string& hsaco,
                 const std::string& device,
                 std::size_t num_cu,
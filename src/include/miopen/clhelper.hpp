@@ -27,6 +27,7 @@
 #define MIOPEN_GUARD_OCL_HELPER_HPP_
 
 #include <iostream>
+#include <miopen/kernel_source_view.hpp>
 #include <miopen/manage_ptr.hpp>
 #include <miopen/miopen.h>
 #include <string>
@@ -37,7 +38,8 @@ using ClProgramPtr = MIOPEN_MANAGE_PTR(cl_program, clReleaseProgram);
 using ClKernelPtr  = MIOPEN_MANAGE_PTR(cl_kernel, clReleaseKernel);
 using ClAqPtr      = MIOPEN_MANAGE_PTR(miopenAcceleratorQueue_t, clReleaseCommandQueue);
 
-ClProgramPtr LoadBinaryProgram(cl_context ctx, cl_device_id device, const std::string& source);
+ClProgramPtr
+LoadBinaryProgram(cl_context ctx, cl_device_id device, const KernelSourceView& source);
 
 ClProgramPtr LoadProgram(cl_context ctx,
                          cl_device_id device,
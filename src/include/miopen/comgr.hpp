@@ -29,6 +29,8 @@
 #include <miopen/config.h>
 #if MIOPEN_USE_COMGR
 
+#include <miopen/kernel_source_view.hpp>
+
 #include <string>
 #include <vector>
 
@@ -36,19 +38,19 @@ namespace miopen {
 namespace comgr {
 
 void BuildHip(const std::string& name,
-              const std::string& text,
+              const KernelSourceView& text,
               const std::string& options,
               const std::string& device,
               std::vector<char>& binary);
 
 void BuildOcl(const std::string& name,
-              const std::string& text,
+              const KernelSourceView& text,
               const std::string& options,
               const std::string& device,
               std::vector<char>& binary);
 
 void BuildAsm(const std::string& name,
-              const std::string& text,
+              const KernelSourceView& text,
               const std::string& options,
               const std::string& device,
               std::vector<char>& binary);
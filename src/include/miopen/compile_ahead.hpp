@@ -0,0 +1,204 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILE_AHEAD_HPP_
+#define GUARD_MIOPEN_COMPILE_AHEAD_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Prepares (e.g. builds the kernels of) the candidates of a search on a pool of host
+/// threads while the caller measures the previous ones:
+///
+///     CompileAhead<Prepared> ahead{depth, threads, next, prepare};
+///     std::size_t i;
+///     Prepared p;
+///     while(ahead.Pop(i, p))
+///         measure(i, p);
+///
+/// next() is called on the caller's thread only, from Pop(), so it may depend on the results
+/// of the measurements done so far. Up to depth candidates are prepared ahead of the one being
+/// measured; they are handed out in the order next() has returned them. With depth == 0 the
+/// candidates are prepared on the caller's thread, one at a time.
+///
+/// An exception thrown by prepare() is rethrown from Pop() for that candidate. The candidates
+/// prepared but not popped yet are discarded on destruction.
+template <class T>
+class CompileAhead
+{
+    public:
+    using Next    = std::function<bool(std::size_t& candidate)>;
+    using Prepare = std::function<T(std::size_t candidate)>;
+
+    CompileAhead(std::size_t depth_, std::size_t threads, Next next_, Prepare prepare_)
+        : depth(depth_), next(std::move(next_)), prepare(std::move(prepare_))
+    {
+        threads = std::min(threads, depth);
+        workers.reserve(threads);
+        for(std::size_t i = 0; i < threads; ++i)
+            workers.emplace_back([this]() { Work(); });
+    }
+
+    CompileAhead(const CompileAhead&) = delete;
+    CompileAhead& operator=(const CompileAhead&) = delete;
+
+    ~CompileAhead()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+            pending.clear();
+        }
+        work_ready.notify_all();
+        for(auto& worker : workers)
+            worker.join();
+    }
+
+    bool Pop(std::size_t& candidate, T& prepared)
+    {
+        if(workers.empty())
+        {
+            if(!next(candidate))
+                return false;
+            prepared = prepare(candidate);
+            return true;
+        }
+
+        Fill();
+        if(slots.empty())
+            return false;
+
+        std::unique_ptr<Slot> slot;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            slot_ready.wait(lock, [&]() { return slots.front()->ready; });
+            slot = std::move(slots.front());
+            slots.pop_front();
+        }
+        // Keep the workers busy while the caller is measuring this one.
+        Fill();
+
+        candidate = slot->candidate;
+        if(slot->error)
+            std::rethrow_exception(slot->error);
+        prepared = std::move(slot->value);
+        return true;
+    }
+
+    private:
+    struct Slot
+    {
+        explicit Slot(std::size_t candidate_) : candidate(candidate_) {}
+
+        std::size_t candidate;
+        T value{};
+        std::exception_ptr error;
+        bool ready = false;
+    };
+
+    void Fill()
+    {
+        while(!exhausted && slots.size() < depth)
+        {
+            std::size_t candidate;
+            if(!next(candidate))
+            {
+                exhausted = true;
+                break;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                slots.push_back(std::make_unique<Slot>(candidate));
+                pending.push_back(slots.back().get());
+            }
+            work_ready.notify_one();
+        }
+    }
+
+    void Work()
+    {
+        while(true)
+        {
+            Slot* slot = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work_ready.wait(lock, [&]() { return stop || !pending.empty(); });
+                if(stop)
+                    return;
+                slot = pending.front();
+                pending.pop_front();
+            }
+
+            T value{};
+            std::exception_ptr error;
+            try
+            {
+                value = prepare(slot->candidate);
+            }
+            catch(...)
+            {
+                error = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                slot->value = std::move(value);
+                slot->error = error;
+                slot->ready = true;
+            }
+            slot_ready.notify_all();
+        }
+    }
+
+    const std::size_t depth;
+    const Next next;
+    const Prepare prepare;
+    /// The candidates returned by next() and not popped yet, in order. Only the caller's
+    /// thread adds and removes them.
+    std::deque<std::unique_ptr<Slot>> slots;
+    /// The slots which no worker has taken yet.
+    std::deque<Slot*> pending;
+    bool exhausted = false;
+    bool stop      = false;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable slot_ready;
+    std::vector<std::thread> workers;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_AHEAD_HPP_
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPRESSION_HPP_
+#define GUARD_MIOPEN_COMPRESSION_HPP_
+
+#include <string>
+
+namespace miopen {
+
+enum class CompressionCodec
+{
+    Bzip2,
+    Lz4,
+};
+
+const char* ToCString(CompressionCodec codec);
+
+/// The codec new kernel binaries are compressed with, set by MIOPEN_KERN_DB_CODEC.
+CompressionCodec GetCompressionCodec();
+
+/// Compresses a blob for the kernel database. Blobs of codecs other than bzip2 start with a tag
+/// naming their codec, so that records written before the tags were introduced still load.
+std::string compress_blob(const std::string& s,
+                          bool* compressed,
+                          CompressionCodec codec = GetCompressionCodec());
+/// Decompresses a blob written by compress_blob with any of the codecs.
+std::string decompress_blob(const std::string& s, unsigned int size);
+CompressionCodec GetBlobCodec(const std::string& blob);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPRESSION_HPP_
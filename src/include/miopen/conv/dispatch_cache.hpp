@@ -0,0 +1,103 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/invoker.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace miopen {
+
+struct ConvolutionDescriptor;
+
+namespace conv {
+
+/// Arguments of an immediate mode call that decide which invoker runs it.
+struct DispatchKey
+{
+    Direction direction;
+    solver::Id solver_id;
+    const TensorDescriptor& in;
+    const TensorDescriptor& weights;
+    const TensorDescriptor& out;
+    const ConvolutionDescriptor& conv;
+};
+
+/// Small direct-mapped cache from the arguments of immediate mode calls to the invokers they
+/// resolved to. A hit runs the invoker without building a ConvolutionContext or a ProblemKey.
+/// Descriptors are compared by value, so changing a descriptor in place between calls is safe.
+/// Entries are replaced by colliding ones, and all are dropped once the invoker cache they come
+/// from has evicted anything, so that evicted invokers are neither run nor kept alive here.
+class DispatchCache
+{
+    public:
+    static constexpr std::size_t capacity = 64;
+
+    /// Returns nullptr on a miss.
+    const Invoker* Find(const DispatchKey& key) const;
+    void Store(const DispatchKey& key, const Invoker& invoker);
+    /// Drops all the entries if the generation differs from the one they were stored in.
+    /// See InvokerCache::GetGeneration().
+    void SetGeneration(std::size_t value);
+
+    private:
+    struct Slot
+    {
+        std::size_t hash        = 0;
+        Direction direction     = Direction::Forward;
+        std::uint64_t solver_id = solver::Id::invalid_value;
+        TensorDescriptor in;
+        TensorDescriptor weights;
+        TensorDescriptor out;
+        std::size_t spatial_dim          = 0;
+        miopenConvolutionMode_t mode     = miopenConvolution;
+        miopenPaddingMode_t padding_mode = miopenPaddingDefault;
+        std::vector<int> pads;
+        std::vector<int> strides;
+        std::vector<int> dilations;
+        std::vector<int> trans_output_pads;
+        int group_count  = 0;
+        float lowp_quant = 0;
+        Invoker invoker;
+
+        bool Matches(const DispatchKey& key, std::size_t key_hash) const;
+    };
+
+    static std::size_t Hash(const DispatchKey& key);
+
+    std::array<Slot, capacity> slots;
+    std::size_t generation = 0;
+};
+
+} // namespace conv
+} // namespace miopen
@@ -29,6 +29,7 @@
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/convolution.hpp>
 #include <miopen/names.hpp>
+#include <miopen/problem_key.hpp>
 #include <miopen/sqlite_db.hpp>
 #include <miopen/tensor.hpp>
 
@@ -263,14 +264,13 @@ struct ProblemDescription
                GetOutDataType() == miopenBFloat16;
     }
 
+    /// Cheap identity of the problem for in-memory caches. BuildConfKey() and Serialize() produce
+    /// the textual forms of the same key.
+    ProblemKey MakeKey() const;
+
     void BuildConfKey(std::string& conf_key) const;
 
-    NetworkConfig BuildConfKey() const
-    {
-        std::string ret;
-        BuildConfKey(ret);
-        return NetworkConfig{ret};
-    }
+    NetworkConfig BuildConfKey() const { return MakeKey().ToNetworkConfig(); }
 
     void Serialize(std::ostream& stream) const;
 
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/problem_description.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+namespace conv {
+
+/// Prepares the invokers of the solutions find has stored to the find-db for the problems, so
+/// that the first immediate mode or Find 2.0 calls on them neither compile nor load kernels.
+/// The solutions of all the problems are built in parallel and the kernel binaries they need
+/// are read from the binary cache in a single batch; missing binaries are compiled in parallel.
+/// Problems without a find-db record are skipped. Returns the number of invokers prepared.
+std::size_t WarmUp(Handle& handle, const std::vector<miopen::ProblemDescription>& problems);
+
+} // namespace conv
+} // namespace miopen
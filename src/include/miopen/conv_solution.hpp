@@ -90,6 +90,19 @@ std::ostream& operator<<(std::ostream& os, const ConvSolution& s);
 
 void PrecompileSolutions(const Handle& h, const std::vector<ConvSolution>& sols);
 
+/// Programs of the kernels of a solution, built but not added to the handle yet.
+struct SolutionPrograms
+{
+    std::vector<KernelInfo> kernels;
+    std::vector<Program> programs;
+};
+
+/// Builds the kernels of the solution. May be called from several threads. The kernels which
+/// fail to build are skipped, so that the error is reported where they are used.
+SolutionPrograms BuildSolutionPrograms(const Handle& h, const ConvSolution& s);
+/// Adds the programs to the handle, so that getting their kernels does not build them again.
+void AddSolutionPrograms(const Handle& h, const SolutionPrograms& built);
+
 } // namespace solver
 } // namespace miopen
 
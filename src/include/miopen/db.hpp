@@ -28,6 +28,7 @@
 
 #include <miopen/db_record.hpp>
 #include <miopen/rank.hpp>
+#include <miopen/trace.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
@@ -35,6 +36,8 @@
 
 #include <chrono>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -46,8 +49,15 @@ namespace miopen {
 
 struct RecordPositions;
 class LockFile;
+class PlainTextDbIndex;
+class PlainTextDbWriteQueue;
 
 /// No instance of this class should be used from several threads at the same time.
+///
+/// If MIOPEN_DB_WRITE_BEHIND is enabled, store, update and remove operations only queue the
+/// changes, which are then coalesced and written by a background thread. Lookups from this process
+/// see queued changes immediately, other processes once they are written. Queued changes are
+/// written at the latest on handle destruction and on normal process exit.
 class PlainTextDb
 {
     public:
@@ -86,6 +96,28 @@ class PlainTextDb
     /// Returns true if remove was successful, false otherwise.
     bool RemoveRecord(const std::string& key);
 
+    /// Updates database with all of the provided records under a single lock and with a single
+    /// rewrite of the file. The result is the same as of calling UpdateRecord() for each of the
+    /// records in the provided order. Provided records are updated with the data stored under
+    /// their keys.
+    ///
+    /// Returns true if update was successful, false otherwise.
+    bool UpdateRecords(std::vector<DbRecord>& records);
+
+    /// Writes all of the updates queued by the background writer of this process, see
+    /// MIOPEN_DB_WRITE_BEHIND. Blocks until the files are written. Does nothing if the background
+    /// writer is disabled.
+    static void FlushPendingWrites();
+
+    /// Reads all records from db in the order they are stored. Only the first record is returned
+    /// for a key that occurs several times, the same one FindRecord() would find.
+    ///
+    /// Returns empty vector if db is unreadable.
+    std::vector<DbRecord> ExportRecords();
+
+    /// Gets VALUES under the ID from all records of the db, i.e. for all the problem configs.
+    std::vector<std::string> FindValues(const std::string& id);
+
     /// Removes ID with associated VALUES from record with key PROBLEM_CONFIG from db.
     /// If payload of a record becomes empty after that, also removes the entire record
     ///
@@ -144,13 +176,27 @@ class PlainTextDb
     private:
     std::string filename;
     LockFile& lock_file;
+    PlainTextDbIndex& index;
+    PlainTextDbWriteQueue& queue;
     const bool warn_if_unreadable;
 
+    friend class PlainTextDbWriter;
+
     boost::optional<DbRecord> FindRecordUnsafe(const std::string& key, RecordPositions* pos);
+    boost::optional<DbRecord> FindRecordIndexedUnsafe(const std::string& key,
+                                                      RecordPositions* pos);
+    boost::optional<DbRecord> FindRecordScanUnsafe(const std::string& key, RecordPositions* pos);
     bool FlushUnsafe(const DbRecord& record, const RecordPositions* pos);
     bool StoreRecordUnsafe(const DbRecord& record);
     bool UpdateRecordUnsafe(DbRecord& record);
     bool RemoveRecordUnsafe(const std::string& key);
+    bool UpdateRecordsUnsafe(std::vector<DbRecord>& records);
+    bool RewriteRecordsUnsafe(std::vector<DbRecord>& records,
+                              const std::vector<bool>& replace,
+                              const std::vector<std::vector<std::string>>& erased = {});
+    bool FlushQueue();
+    bool FlushQueueUnsafe();
+    std::vector<DbRecord> ExportRecordsUnsafe();
 
     template <class T>
     inline boost::optional<DbRecord> FindRecordUnsafe(const T& problem_config)
@@ -222,6 +268,49 @@ class MultiFileDb
 #endif
     }
 
+    /// Batched lookup, only for databases whose records are not merged: every key is looked up
+    /// in the user database first and the misses are then looked up in the installed one.
+    template <bool merge = merge_records, std::enable_if_t<!merge>* = nullptr, class TKey>
+    auto FindRecords(const std::vector<TKey>& keys)
+    {
+#if !MIOPEN_DISABLE_USERDB
+        auto records = _user.FindRecords(keys);
+        auto misses  = std::vector<TKey>{};
+        auto indices = std::vector<std::size_t>{};
+        for(auto i = 0u; i < keys.size(); ++i)
+        {
+            if(records[i])
+                continue;
+            misses.push_back(keys[i]);
+            indices.push_back(i);
+        }
+        if(misses.empty())
+            return records;
+        auto installed = _installed.FindRecords(misses);
+        for(auto i = 0u; i < indices.size(); ++i)
+            records[indices[i]] = std::move(installed[i]);
+        return records;
+#else
+        return _installed.FindRecords(keys);
+#endif
+    }
+
+    /// Looks a record up the same way as FindRecord() does for databases whose records are not
+    /// merged, and returns its entries deserialized. Databases which keep the entries deserialized
+    /// (see ReadonlyRamDb::FindItems()) skip the text round trip.
+    template <bool merge                = merge_records,
+              std::enable_if_t<!merge>* = nullptr,
+              class TProblem,
+              class TValue>
+    bool FindItems(const TProblem& problem, std::vector<std::pair<std::string, TValue>>& items)
+    {
+#if !MIOPEN_DISABLE_USERDB
+        if(FindItems(rank<1>{}, _user, problem, items))
+            return true;
+#endif
+        return FindItems(rank<1>{}, _installed, problem, items);
+    }
+
     template <typename... U>
     auto StoreRecord(const U&... args)
     {
@@ -276,6 +365,17 @@ class MultiFileDb
         return _installed.Load(args...);
     }
 
+    /// Values are concatenated, the ones of the installed db go first.
+    std::vector<std::string> FindValues(const std::string& id)
+    {
+        auto values = _installed.FindValues(id);
+#if !MIOPEN_DISABLE_USERDB
+        auto users = _user.FindValues(id);
+        values.insert(values.end(), users.begin(), users.end());
+#endif
+        return values;
+    }
+
     template <typename... U>
     auto Remove(const U&... args)
     {
@@ -317,6 +417,30 @@ class MultiFileDb
         return GetDbInstance<TDb>(rank<1>{}, path, warn_if_unreadable, arch, num_cu);
     }
 
+    template <class TDb, class TProblem, class TValue>
+    static auto FindItems(rank<1>,
+                          TDb& db,
+                          const TProblem& problem,
+                          std::vector<std::pair<std::string, TValue>>& items)
+        -> decltype(db.FindItems(problem, items))
+    {
+        return db.FindItems(problem, items);
+    }
+
+    template <class TDb, class TProblem, class TValue>
+    static bool FindItems(rank<0>,
+                          TDb& db,
+                          const TProblem& problem,
+                          std::vector<std::pair<std::string, TValue>>& items)
+    {
+        const auto record = db.FindRecord(problem);
+        if(!record)
+            return false;
+        const auto range = record->template As<TValue>();
+        items.assign(range.begin(), range.end());
+        return true;
+    }
+
     decltype(MultiFileDb::GetDbInstance<TInstalled>("", true, "", 0)) _installed;
 #if !MIOPEN_DISABLE_USERDB
     decltype(MultiFileDb::GetDbInstance<TUser>("", false, "", 0)) _user;
@@ -338,6 +462,18 @@ class DbTimer
         return Measure("FindRecord", [&]() { return inner.FindRecord(args...); });
     }
 
+    template <typename... U>
+    auto FindRecords(const U&... args)
+    {
+        return Measure("FindRecords", [&]() { return inner.FindRecords(args...); });
+    }
+
+    template <typename... U>
+    auto FindItems(U&... args)
+    {
+        return Measure("FindItems", [&]() { return inner.FindItems(args...); });
+    }
+
     template <typename... U>
     auto StoreRecord(U&... record)
     {
@@ -374,12 +510,19 @@ class DbTimer
         return Measure("Remove", [&]() { return inner.Remove(args...); });
     }
 
+    template <typename... U>
+    auto FindValues(const U&... args)
+    {
+        return Measure("FindValues", [&]() { return inner.FindValues(args...); });
+    }
+
     private:
     TInnerDb inner;
 
     template <class TFunc>
-    static auto Measure(const std::string& funcName, TFunc&& func)
+    static auto Measure(const char* funcName, TFunc&& func)
     {
+        MIOPEN_TRACE_SPAN("db", funcName);
         if(!miopen::IsLogging(LoggingLevel::Info2))
             return func();
 
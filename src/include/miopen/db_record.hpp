@@ -240,6 +240,7 @@ class DbRecord
     }
 
     friend class PlainTextDb;
+    friend class PlainTextDbWriteQueue;
     friend class SQLitePerfDb;
     friend class ReadonlyRamDb;
 };
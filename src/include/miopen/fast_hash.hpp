@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_FAST_HASH_HPP_
+#define GUARD_MIOPEN_FAST_HASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace miopen {
+
+struct Hash128
+{
+    std::uint64_t low  = 0;
+    std::uint64_t high = 0;
+
+    std::string ToString() const;
+
+    friend bool operator==(const Hash128& left, const Hash128& right)
+    {
+        return left.low == right.low && left.high == right.high;
+    }
+    friend bool operator!=(const Hash128& left, const Hash128& right) { return !(left == right); }
+};
+
+/// Incremental 128-bit MurmurHash3 (x64 variant), for keys of in-process caches. It is several
+/// times faster than MD5 on long kernel sources and option strings, but is not cryptographic and
+/// must not be used for anything stored on disk, where md5 stays for compatibility.
+class FastHasher
+{
+    public:
+    explicit FastHasher(std::uint64_t seed = 0) : h1(seed), h2(seed) {}
+    FastHasher& Update(const void* data, std::size_t size);
+    FastHasher& Update(const std::string& s) { return Update(s.data(), s.size()); }
+    /// Hashes the size first, so that the boundaries between the pieces matter.
+    FastHasher& UpdatePiece(const std::string& s);
+    Hash128 Finalize() const;
+
+    private:
+    std::uint64_t h1;
+    std::uint64_t h2;
+    std::uint64_t length = 0;
+    unsigned char tail[16] = {};
+};
+
+Hash128 fast_hash(const std::string& s);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FAST_HASH_HPP_
@@ -29,6 +29,7 @@
 
 #include <miopen/solver_id.hpp>
 #include <miopen/conv/context.hpp>
+#include <cstddef>
 #include <ostream>
 
 namespace miopen {
@@ -119,6 +120,10 @@ class FindEnforce
 
 solver::Id GetEnvFindOnlySolver();
 
+/// Number of threads used to check applicability of solvers and to build their solutions
+/// (MIOPEN_FIND_SOLVERS_PARALLEL_LEVEL). 1, the default, keeps the serial behavior.
+std::size_t GetFindSolversParallelLevel();
+
 class FindMode
 {
     public:
@@ -37,6 +37,8 @@
 #include <boost/optional.hpp>
 
 #include <functional>
+#include <string>
+#include <utility>
 #include <vector>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_FIND_DB)
@@ -44,7 +46,8 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_FIND_DB)
 namespace miopen {
 
 struct Handle;
-struct NetworkConfig;
+struct ProblemKey;
+class SolutionRanker;
 
 template <class TDb>
 class FindDbRecord_t;
@@ -94,8 +97,8 @@ class FindDbRecord_t
         if(!db.is_initialized())
             return;
 
-        content = db->FindRecord(problem);
-        in_sync = content.is_initialized();
+        // Immediate mode only reads the entries, so the record itself is not needed.
+        in_sync = db->FindItems(problem, items);
     }
 
     template <class TProblemDescription, class TTestDb = TDb>
@@ -115,6 +118,8 @@ class FindDbRecord_t
 
         content = db->FindRecord(problem);
         in_sync = content.is_initialized();
+        if(in_sync)
+            LoadItems();
     }
 
     ~FindDbRecord_t()
@@ -125,11 +130,9 @@ class FindDbRecord_t
             MIOPEN_LOG_E("Failed to store record to find-db at <" << path << ">");
     }
 
-    auto begin() const { return content->As<FindDbData>().begin(); }
-    auto begin() { return content->As<FindDbData>().begin(); }
-    auto end() const { return content->As<FindDbData>().end(); }
-    auto end() { return content->As<FindDbData>().end(); }
-    bool empty() const { return !content.is_initialized(); }
+    auto begin() const { return items.begin(); }
+    auto end() const { return items.end(); }
+    bool empty() const { return !in_sync && !content.is_initialized(); }
 
     template <class TProblemDescription>
     static std::vector<PerfField> TryLoad(Handle& handle,
@@ -139,9 +142,7 @@ class FindDbRecord_t
         auto ret = std::vector<PerfField>{};
         FindDbRecord_t<TDb> record{handle, problem};
 
-        const auto network_config = problem.BuildConfKey();
-
-        if(record.in_sync && !record.Validate(handle, network_config))
+        if(record.in_sync && !record.Validate(handle, problem.MakeKey()))
         {
             record.CopyTo(ret);
             return ret;
@@ -152,16 +153,22 @@ class FindDbRecord_t
         record.in_sync = false;
         record.content.emplace(problem);
         regenerator(*record.content);
+        record.LoadItems();
         record.CopyTo(ret);
 
         return ret;
     }
 
+    /// Ranker over the records of the installed and the user find-db, loaded once per process.
+    static const SolutionRanker& GetRanker(Handle& handle);
+
     private:
     std::string path;
     std::string installed_path;
     boost::optional<DbTimer<TDb>> db;
     boost::optional<DbRecord> content{boost::none};
+    /// Entries of the record, deserialized once.
+    std::vector<std::pair<std::string, FindDbData>> items;
     bool in_sync = false;
 
     static bool HasKernel(Handle& handle, const FindDbKCacheKey& key);
@@ -170,8 +177,9 @@ class FindDbRecord_t
     static std::string GetUserPath(Handle& handle);
 
     // Returns true if rebuild is required
-    bool Validate(Handle& handle, const NetworkConfig& config) const;
+    bool Validate(Handle& handle, const ProblemKey& problem) const;
     void CopyTo(std::vector<PerfField>& to) const;
+    void LoadItems();
 
     void LogFindDbItem(const std::pair<std::string, FindDbData>& pair,
                        bool log_as_error = false) const;
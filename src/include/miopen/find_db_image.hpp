@@ -0,0 +1,439 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_FIND_DB_IMAGE_HPP_
+#define GUARD_MIOPEN_FIND_DB_IMAGE_HPP_
+
+// This header is shared by the library and the build-time converter (fdb2bin),
+// so it shall not depend on anything but the standard library.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+namespace find_db_image {
+
+/// Binary image of a find-db text file.
+///
+/// Layout (all sections are 8-byte aligned, native byte order):
+///   Header
+///   Record[record_count]    sorted by key, so lookups are binary searches
+///   Item[item_count]        find-db entries of all records, grouped by record
+///   StringRef[string_count] interned strings: keys, algorithm names, solver ids,
+///                           network configs
+///   char[]                  string data
+///
+/// Each Item holds a FindDbData entry which is already split into fields,
+/// so neither loading of the image nor lookups in it require parsing.
+constexpr uint32_t Version = 2;
+
+inline const char* Magic() { return "MIOFDBI"; } // 7 chars + '\0' = 8 bytes
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t record_count;
+    uint32_t item_count;
+    uint32_t string_count;
+    /// Size, modification time (seconds since the epoch) and MD5 (hex) of the source text file,
+    /// used to detect stale images.
+    uint64_t source_size;
+    int64_t source_mtime;
+    char source_md5[32];
+    uint64_t records_offset;
+    uint64_t items_offset;
+    uint64_t strings_offset;
+    uint64_t string_data_offset;
+    uint64_t image_size;
+};
+
+struct Record
+{
+    uint32_t key;
+    uint32_t first_item;
+    uint32_t item_count;
+    uint32_t line;
+};
+
+struct Item
+{
+    uint32_t id; // algorithm name, e.g. miopenConvolutionFwdAlgoDirect
+    uint32_t solver_id;
+    uint32_t kcache_algorithm;
+    uint32_t kcache_network_config;
+    uint64_t workspace;
+    float time;
+    uint32_t reserved;
+};
+
+struct StringRef
+{
+    uint32_t offset;
+    uint32_t size;
+};
+
+/// Read-only accessor of an image located in memory (mapped or embedded).
+/// Never copies nor allocates. All indices and offsets of the image are checked once by the
+/// constructor, an image which fails any check is invalid, so the accessors do no checks.
+class View
+{
+    public:
+    View() = default;
+    View(const char* data_, std::size_t size_) : data(data_), size(size_)
+    {
+        if(size < sizeof(Header))
+            return;
+        header = reinterpret_cast<const Header*>(data);
+        if(std::memcmp(header->magic, Magic(), sizeof(header->magic)) != 0 ||
+           header->version != Version || header->image_size != size ||
+           !Fits(header->records_offset, header->record_count, sizeof(Record)) ||
+           !Fits(header->items_offset, header->item_count, sizeof(Item)) ||
+           !Fits(header->strings_offset, header->string_count, sizeof(StringRef)) ||
+           header->string_data_offset > size)
+        {
+            header = nullptr;
+            return;
+        }
+        records = reinterpret_cast<const Record*>(data + header->records_offset);
+        items   = reinterpret_cast<const Item*>(data + header->items_offset);
+        strings = reinterpret_cast<const StringRef*>(data + header->strings_offset);
+        if(!TablesAreValid())
+            header = nullptr;
+    }
+
+    bool IsValid() const { return header != nullptr; }
+    uint64_t SourceSize() const { return header->source_size; }
+    int64_t SourceMtime() const { return header->source_mtime; }
+    std::string SourceMd5() const { return {header->source_md5, sizeof(header->source_md5)}; }
+    uint32_t RecordCount() const { return header->record_count; }
+
+    const Record* Find(const char* key, std::size_t key_size) const
+    {
+        const auto end = records + header->record_count;
+        const auto it  = std::lower_bound(records, end, 0, [&](const Record& r, int) {
+            return Compare(r.key, key, key_size) < 0;
+        });
+        if(it == end || Compare(it->key, key, key_size) != 0)
+            return nullptr;
+        return it;
+    }
+
+    const Item* ItemsBegin(const Record& record) const { return items + record.first_item; }
+    const Item* ItemsEnd(const Record& record) const
+    {
+        return items + record.first_item + record.item_count;
+    }
+
+    const char* StringData(uint32_t idx) const
+    {
+        return data + header->string_data_offset + strings[idx].offset;
+    }
+    std::size_t StringSize(uint32_t idx) const { return strings[idx].size; }
+    std::string String(uint32_t idx) const { return {StringData(idx), StringSize(idx)}; }
+
+    private:
+    const char* data      = nullptr;
+    std::size_t size      = 0;
+    const Header* header  = nullptr;
+    const Record* records = nullptr;
+    const Item* items     = nullptr;
+    const StringRef* strings = nullptr;
+
+    bool Fits(uint64_t offset, uint64_t count, std::size_t item_size) const
+    {
+        return offset % alignof(uint64_t) == 0 && offset <= size &&
+               count <= (size - offset) / item_size;
+    }
+
+    bool TablesAreValid() const
+    {
+        const auto string_data_size = size - header->string_data_offset;
+        const auto string_count     = header->string_count;
+        const auto item_count       = header->item_count;
+
+        for(auto str = strings; str != strings + string_count; ++str)
+            if(str->offset > string_data_size || str->size > string_data_size - str->offset)
+                return false;
+
+        for(auto item = items; item != items + item_count; ++item)
+            if(item->id >= string_count || item->solver_id >= string_count ||
+               item->kcache_algorithm >= string_count ||
+               item->kcache_network_config >= string_count)
+                return false;
+
+        for(auto record = records; record != records + header->record_count; ++record)
+        {
+            if(record->key >= string_count || record->first_item > item_count ||
+               record->item_count > item_count - record->first_item)
+                return false;
+            // Find() relies on the keys being sorted and unique.
+            if(record != records &&
+               Compare((record - 1)->key, StringData(record->key), StringSize(record->key)) >= 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    int Compare(uint32_t idx, const char* key, std::size_t key_size) const
+    {
+        const auto str_size = StringSize(idx);
+        const auto common   = std::min(str_size, key_size);
+        const auto cmp      = std::memcmp(StringData(idx), key, common);
+        if(cmp != 0)
+            return cmp;
+        return str_size < key_size ? -1 : (str_size > key_size ? 1 : 0);
+    }
+};
+
+/// Builds an image from a find-db text file.
+/// Follows the same rules as the text readers: the first record with a key and the first entry
+/// with an id win. Unlike the text readers, which skip ill-formed lines, Parse() rejects the
+/// whole text on the first one, so that a broken db fails the build instead of being shipped.
+class Writer
+{
+    public:
+    /// Returns false and describes the problem in error if the text is ill-formed.
+    bool Parse(std::istream& text, std::string& error)
+    {
+        auto line   = std::string{};
+        auto n_line = 0u;
+
+        while(std::getline(text, line))
+        {
+            ++n_line;
+
+            if(line.empty())
+                continue;
+
+            const auto key_size = line.find('=');
+            if(key_size == std::string::npos || key_size == 0)
+            {
+                error = "Ill-formed record: key not found, line " + std::to_string(n_line);
+                return false;
+            }
+
+            auto& record = records[line.substr(0, key_size)];
+            if(record.line != 0)
+                continue;
+            record.line = n_line;
+
+            auto contents = std::istringstream{line.substr(key_size + 1)};
+            auto pair     = std::string{};
+            while(std::getline(contents, pair, ';'))
+            {
+                const auto id_size = pair.find(':');
+                if(id_size == std::string::npos)
+                {
+                    error = "Ill-formed entry: ID not found, line " + std::to_string(n_line);
+                    return false;
+                }
+                const auto id = pair.substr(0, id_size);
+                if(std::any_of(record.items.begin(), record.items.end(), [&](const auto& item) {
+                       return item.id == id;
+                   }))
+                    continue;
+
+                auto item = TextItem{};
+                item.id   = id;
+                if(!SplitValues(pair.substr(id_size + 1), item))
+                {
+                    error = "Ill-formed find-db values under " + id + ", line " +
+                            std::to_string(n_line);
+                    return false;
+                }
+                record.items.push_back(item);
+            }
+        }
+
+        return true;
+    }
+
+    /// Describes the text file, it is checked at runtime to skip stale images.
+    void SetSource(uint64_t size, int64_t mtime, const std::string& md5)
+    {
+        source_size  = size;
+        source_mtime = mtime;
+        source_md5   = md5;
+    }
+
+    void Write(std::ostream& out) const
+    {
+        auto strings    = std::vector<StringRef>{};
+        auto string_ids = std::unordered_map<std::string, uint32_t>{};
+        auto chars      = std::string{};
+        const auto intern = [&](const std::string& str) {
+            const auto found = string_ids.find(str);
+            if(found != string_ids.end())
+                return found->second;
+            const auto idx = static_cast<uint32_t>(strings.size());
+            strings.push_back({static_cast<uint32_t>(chars.size()),
+                               static_cast<uint32_t>(str.size())});
+            chars += str;
+            string_ids.emplace(str, idx);
+            return idx;
+        };
+
+        auto out_records = std::vector<Record>{};
+        auto out_items   = std::vector<Item>{};
+
+        for(const auto& record : records) // std::map keeps the keys sorted
+        {
+            if(record.second.items.empty())
+                continue;
+            out_records.push_back({intern(record.first),
+                                   static_cast<uint32_t>(out_items.size()),
+                                   static_cast<uint32_t>(record.second.items.size()),
+                                   record.second.line});
+            for(const auto& item : record.second.items)
+            {
+                out_items.push_back({intern(item.id),
+                                     intern(item.solver_id),
+                                     intern(item.kcache_algorithm),
+                                     intern(item.kcache_network_config),
+                                     item.workspace,
+                                     item.time,
+                                     0});
+            }
+        }
+
+        auto header = Header{};
+        std::memcpy(header.magic, Magic(), sizeof(header.magic));
+        header.version            = Version;
+        header.record_count       = static_cast<uint32_t>(out_records.size());
+        header.item_count         = static_cast<uint32_t>(out_items.size());
+        header.string_count       = static_cast<uint32_t>(strings.size());
+        header.source_size        = source_size;
+        header.source_mtime       = source_mtime;
+        std::memset(header.source_md5, 0, sizeof(header.source_md5));
+        std::memcpy(header.source_md5,
+                    source_md5.data(),
+                    std::min(source_md5.size(), sizeof(header.source_md5)));
+        header.records_offset     = Align(sizeof(Header));
+        header.items_offset       = Align(header.records_offset + Bytes(out_records));
+        header.strings_offset     = Align(header.items_offset + Bytes(out_items));
+        header.string_data_offset = Align(header.strings_offset + Bytes(strings));
+        header.image_size         = Align(header.string_data_offset + chars.size());
+
+        auto written     = uint64_t{0};
+        const auto write = [&](uint64_t offset, const void* ptr, std::size_t bytes) {
+            static const char zeros[alignof(uint64_t)] = {};
+            while(written < offset)
+            {
+                const auto pad = std::min<uint64_t>(offset - written, sizeof(zeros));
+                out.write(zeros, pad);
+                written += pad;
+            }
+            out.write(static_cast<const char*>(ptr), bytes);
+            written += bytes;
+        };
+
+        write(0, &header, sizeof(header));
+        write(header.records_offset, out_records.data(), Bytes(out_records));
+        write(header.items_offset, out_items.data(), Bytes(out_items));
+        write(header.strings_offset, strings.data(), Bytes(strings));
+        write(header.string_data_offset, chars.data(), chars.size());
+        write(header.image_size, nullptr, 0);
+    }
+
+    private:
+    struct TextItem
+    {
+        std::string id;
+        std::string solver_id;
+        float time;
+        uint64_t workspace;
+        std::string kcache_algorithm;
+        std::string kcache_network_config;
+    };
+
+    struct TextRecord
+    {
+        unsigned line = 0;
+        std::vector<TextItem> items;
+    };
+
+    std::map<std::string, TextRecord> records;
+    uint64_t source_size = 0;
+    int64_t source_mtime = 0;
+    std::string source_md5;
+
+    static uint64_t Align(uint64_t offset)
+    {
+        return (offset + alignof(uint64_t) - 1) / alignof(uint64_t) * alignof(uint64_t);
+    }
+
+    template <class T>
+    static std::size_t Bytes(const std::vector<T>& v)
+    {
+        return v.size() * sizeof(T);
+    }
+
+    // Mirrors FindDbData::Deserialize(): solver_id,time,workspace,algorithm,network_config
+    static bool SplitValues(const std::string& values, TextItem& item)
+    {
+        auto ss     = std::istringstream{values};
+        auto fields = std::vector<std::string>(5);
+        for(auto& field : fields)
+            if(!std::getline(ss, field, ','))
+                return false;
+
+        item.solver_id             = fields[0];
+        item.kcache_algorithm      = fields[3];
+        item.kcache_network_config = fields[4];
+        return static_cast<bool>(std::istringstream{fields[1]} >> item.time) &&
+               static_cast<bool>(std::istringstream{fields[2]} >> item.workspace);
+    }
+};
+
+/// Formats an item the same way FindDbData::Serialize() does, but with enough precision for the
+/// time to survive the round trip.
+inline std::string FormatItemValues(const View& view, const Item& item)
+{
+    std::ostringstream ss;
+    ss.precision(std::numeric_limits<float>::max_digits10);
+    ss.write(view.StringData(item.solver_id), view.StringSize(item.solver_id));
+    ss << ',' << item.time << ',' << item.workspace << ',';
+    ss.write(view.StringData(item.kcache_algorithm), view.StringSize(item.kcache_algorithm));
+    ss << ',';
+    ss.write(view.StringData(item.kcache_network_config),
+             view.StringSize(item.kcache_network_config));
+    return ss.str();
+}
+
+} // namespace find_db_image
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FIND_DB_IMAGE_HPP_
@@ -30,9 +30,18 @@
 #include <miopen/env.hpp>
 #include <miopen/conv_solution.hpp>
 #include <miopen/find_controls.hpp>
+#include <miopen/par_for.hpp>
 #include <miopen/solver_id.hpp>
+#include <miopen/trace.hpp>
 
+#include <algorithm>
+#include <exception>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace miopen {
@@ -119,12 +128,55 @@ ConvSolution FindSolution(Solver s, const Context& context, Db& db)
 {
     static_assert(std::is_empty<Solver>{} && std::is_trivially_constructible<Solver>{},
                   "Solver must be stateless");
+    MIOPEN_TRACE_SPAN_DETAIL("solver", "GetSolution", SolverDbId(s));
     // TODO: This assumes all solutions are ConvSolution
     auto solution      = FindSolutionImpl(rank<1>{}, s, context, db);
     solution.solver_id = SolverDbId(s);
     return solution;
 }
 
+/// Same as s.IsApplicable(context), but recorded to the trace.
+template <class Solver, class Context>
+bool IsSolverApplicable(Solver s, const Context& context)
+{
+    MIOPEN_TRACE_SPAN_DETAIL("solver", "IsApplicable", SolverDbId(s));
+    return s.IsApplicable(context);
+}
+
+/// Serializes perf-db accesses done by FindSolution() calls running on several threads.
+/// Database instances are not meant to be shared between threads.
+template <class Db>
+class SerializedDb
+{
+    public:
+    SerializedDb(Db& db_) : db(db_) {}
+
+    template <class... Ts>
+    decltype(auto) Load(Ts&&... xs)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return db.Load(std::forward<Ts>(xs)...);
+    }
+
+    template <class... Ts>
+    decltype(auto) Update(Ts&&... xs)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return db.Update(std::forward<Ts>(xs)...);
+    }
+
+    template <class... Ts>
+    decltype(auto) Remove(Ts&&... xs)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return db.Remove(std::forward<Ts>(xs)...);
+    }
+
+    private:
+    Db& db;
+    std::mutex mutex;
+};
+
 template <class... Solvers>
 struct SolverContainer
 {
@@ -135,6 +187,10 @@ struct SolverContainer
                           Db&& db,
                           std::size_t limit = std::numeric_limits<std::size_t>::max()) const
     {
+        const auto threads = GetFindSolversParallelLevel();
+        if(threads > 1)
+            return SearchForAllSolutionsParallel<Solution>(search_params, db, limit, threads);
+
         std::vector<Solution> ss;
         std::size_t count    = 0;
         const auto find_only = GetEnvFindOnlySolver();
@@ -145,7 +201,7 @@ struct SolverContainer
                 if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
                 { // Do nothing (and keep silence for the sake of Tuna), just skip.
                 }
-                else if(solver.IsApplicable(search_params))
+                else if(IsSolverApplicable(solver, search_params))
                 {
                     const Solution s = FindSolution(solver, search_params, db);
                     if(s.Succeeded())
@@ -173,6 +229,112 @@ struct SolverContainer
             Solvers{}...);
         return ss;
     }
+
+    // Same as above, but IsApplicable() and FindSolution() of different solvers are evaluated
+    // concurrently. The solutions, the logging and the exceptions thrown are reported in the
+    // order of the solvers. Searches and db cleanups stay serial, and at most one batch of
+    // solutions is built past the limit.
+    template <class Solution, class Context, class Db>
+    std::vector<Solution> SearchForAllSolutionsParallel(const Context& search_params,
+                                                        Db& db,
+                                                        std::size_t limit,
+                                                        std::size_t threads) const
+    {
+        const auto find_only = GetEnvFindOnlySolver();
+        const FindEnforce enforce;
+        SerializedDb<Db> serialized_db{db};
+
+        std::vector<std::string> ids;
+        std::vector<std::function<bool()>> is_applicable;
+        std::vector<std::function<Solution()>> find_solution;
+        miopen::each_args(
+            [&](auto solver) {
+                if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
+                    return; // Keep silence for the sake of Tuna.
+                ids.emplace_back(SolverDbId(solver));
+                is_applicable.emplace_back([&search_params, solver]() {
+                    return IsSolverApplicable(solver, search_params);
+                });
+                find_solution.emplace_back([&search_params, &serialized_db, solver]() -> Solution {
+                    return FindSolution(solver, search_params, serialized_db);
+                });
+            },
+            Solvers{}...);
+
+        const auto n = ids.size();
+        std::vector<char> applicable(n, 0);
+        std::vector<char> found(n, 0);
+        std::vector<Solution> solutions(n);
+        std::vector<std::exception_ptr> errors(n);
+
+        par_for(n, max_threads{threads}, [&](auto i) {
+            try
+            {
+                applicable[i] = is_applicable[i]() ? 1 : 0;
+            }
+            catch(...)
+            {
+                errors[i] = std::current_exception();
+            }
+        });
+
+        const auto is_search = search_params.do_search || enforce.IsSearch(search_params) ||
+                               enforce.IsDbClean(search_params);
+        const auto unlimited = limit == std::numeric_limits<std::size_t>::max();
+
+        std::vector<Solution> ss;
+
+        const auto find_batch = [&](std::size_t first) {
+            const auto batch_size =
+                is_search ? 1 : unlimited ? n : std::min(threads, limit - ss.size());
+            std::vector<std::size_t> batch;
+            for(auto i = first; i < n && batch.size() < batch_size; ++i)
+            {
+                if(applicable[i] != 0 && !errors[i])
+                    batch.push_back(i);
+            }
+
+            par_for(batch.size(), max_threads{threads}, [&](auto j) {
+                const auto i = batch[j];
+                try
+                {
+                    solutions[i] = find_solution[i]();
+                }
+                catch(...)
+                {
+                    errors[i] = std::current_exception();
+                }
+                found[i] = 1;
+            });
+        };
+
+        for(std::size_t i = 0; i < n && ss.size() < limit; ++i)
+        {
+            if(errors[i])
+                std::rethrow_exception(errors[i]);
+            if(applicable[i] == 0)
+            {
+                MIOPEN_LOG_I2(ids[i] << ": Not applicable");
+                continue;
+            }
+            if(found[i] == 0)
+                find_batch(i);
+            if(errors[i])
+                std::rethrow_exception(errors[i]);
+
+            if(solutions[i].Succeeded())
+            {
+                ss.push_back(solutions[i]);
+                MIOPEN_LOG_I2(ids[i] << ": Success.");
+            }
+            else
+            {
+                /// \todo See SearchForAllSolutions().
+                MIOPEN_LOG_I(ids[i] << ": [Warning] Applicable Solver not succeeded.");
+            }
+        }
+        return ss;
+    }
     template <class Context>
     std::vector<std::pair<std::string, size_t>> GetWorkspaceSize(const Context& search_params) const
     {
@@ -183,7 +345,7 @@ struct SolverContainer
                 if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
                 { // Do nothing (and keep silence for the sake of Tuna), just skip.
                 }
-                else if(solver.IsApplicable(search_params))
+                else if(IsSolverApplicable(solver, search_params))
                 {
                     auto sz = solver.GetWorkspaceSize(search_params);
                     res.push_back(std::make_pair(SolverDbId(solver), sz));
@@ -196,6 +358,28 @@ struct SolverContainer
             Solvers{}...);
         return res;
     }
+
+    // Ids of the applicable solvers, without building their solutions.
+    template <class Context>
+    std::vector<Id>
+    GetApplicableIds(const Context& search_params,
+                     std::size_t limit = std::numeric_limits<std::size_t>::max()) const
+    {
+        std::vector<Id> ids;
+        const auto find_only = GetEnvFindOnlySolver();
+        miopen::each_args(
+            [&](auto solver) {
+                if(ids.size() >= limit)
+                    return;
+                if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
+                { // Do nothing (and keep silence for the sake of Tuna), just skip.
+                }
+                else if(IsSolverApplicable(solver, search_params))
+                    ids.emplace_back(SolverDbId(solver));
+            },
+            Solvers{}...);
+        return ids;
+    }
 };
 
 } // namespace solver
@@ -37,12 +37,61 @@
 #include <cassert>
 
 #include <miopen/logger.hpp>
+#include <miopen/compile_ahead.hpp>
+#include <miopen/conv_solution.hpp>
+#include <miopen/env.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/kernel_model.hpp>
+#include <miopen/rank.hpp>
+#include <miopen/search_checkpoint.hpp>
+#include <miopen/search_strategy.hpp>
 #include <miopen/timer.hpp>
 
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
 namespace miopen {
+
+struct ConvolutionContext;
+
 namespace solver {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_COMPILE_AHEAD)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_TOP_K)
+
+/// Perf-db values of the solver for all the problem configs.
+std::vector<std::string> GetTunedValues(const ConvolutionContext& context,
+                                        const std::string& solver_id);
+
+/// Checkpoints of the solver's search on the problem config.
+SearchCheckpointDb GetSearchCheckpointDb(const ConvolutionContext& context,
+                                         const std::string& solver_id);
+
+/// Resources of the device the problem config is tuned on.
+DeviceModel GetDeviceModel(const ConvolutionContext& context);
+
+/// Host-side models of the kernels of the performance configs, or nothing if the configs
+/// do not provide GetKernelModel().
+template <class PerformanceConfig, class Context>
+auto GetKernelModels(rank<1>, const std::vector<PerformanceConfig>& configs, const Context& context)
+    -> decltype(configs.front().GetKernelModel(context), std::vector<KernelModel>{})
+{
+    std::vector<KernelModel> models;
+    models.reserve(configs.size());
+    for(const auto& config : configs)
+        models.push_back(config.GetKernelModel(context));
+    return models;
+}
+
+template <class PerformanceConfig, class Context>
+std::vector<KernelModel>
+GetKernelModels(rank<0>, const std::vector<PerformanceConfig>&, const Context&)
+{
+    return {};
+}
+
 /// This STL-like container together with corresponding iterator provide access
 /// to a set of all available performance configs for the given problem config.
 ///
@@ -440,7 +489,7 @@ auto GenericSearch(const Solver s,
     const bool useSpare  = (main_size == 0);
 
     const ComputedContainer<PerformanceConfig, Context> all_configs = useSpare ? spare : main;
-    const int n_runs_total = useSpare ? spare_size : main_size;
+    int n_runs_total = useSpare ? spare_size : main_size;
     MIOPEN_LOG_W(SolverDbId(s) << ": Searching the best solution among " << n_runs_total
                                << (useSpare ? " (spare)" : "")
                                << "...");
@@ -453,15 +502,103 @@ auto GenericSearch(const Solver s,
     HeartBeat<PerformanceConfig> heartbeat;
     heartbeat.Start();
 
+    std::vector<PerformanceConfig> configs(all_configs.begin(), all_configs.end());
+
+    // Measure only the configs which the kernel model expects to be the fastest.
+    const auto top_k = Value(MIOPEN_TUNING_TOP_K{});
+    if(top_k != 0)
+    {
+        const auto models = GetKernelModels(rank<1>{}, configs, context);
+        if(!models.empty())
+        {
+            const auto kept = RankKernels(models, GetDeviceModel(context), top_k);
+            if(kept.empty())
+            {
+                // Searching everything is better than searching nothing.
+                MIOPEN_LOG_W("Kernel model found none of " << configs.size()
+                                                           << " configs feasible, not pruning");
+            }
+            else
+            {
+                std::vector<PerformanceConfig> ranked;
+                for(const auto i : kept)
+                    ranked.push_back(configs[i]);
+                MIOPEN_LOG_I("Kernel model kept " << ranked.size() << " of " << configs.size()
+                                                  << " configs");
+                configs      = std::move(ranked);
+                n_runs_total = configs.size();
+            }
+        }
+    }
+
+    const auto options = GetSearchOptions();
+    std::vector<std::vector<float>> features(configs.size());
+    std::vector<std::vector<float>> tuned;
+    if(options.strategy != SearchStrategy::Exhaustive)
+    {
+        MIOPEN_LOG_I("Search strategy: " << options.strategy << ", max evaluations: "
+                                         << options.budget.evaluations
+                                         << ", time limit: "
+                                         << options.budget.seconds
+                                         << " s");
+        for(std::size_t i = 0; i < configs.size(); ++i)
+        {
+            std::ostringstream ss;
+            ss << configs[i];
+            features[i] = GetConfigFeatures(ss.str());
+        }
+    }
+    if(options.strategy == SearchStrategy::Model)
+    {
+        for(const auto& values : GetTunedValues(context, SolverDbId(s)))
+            tuned.push_back(GetConfigFeatures(values));
+    }
+    SearchPlanner planner{options, std::move(features), std::move(tuned)};
+
+    // Resume an interrupted search, or merge the searches of the shards.
+    SearchCheckpointer checkpointer{
+        GetSearchCheckpointDb(context, SolverDbId(s)), planner, options, configs.size()};
+    const auto& restored = planner.GetResult();
+    n_current            = restored.evaluated;
+    n_failed             = restored.failed;
+    if(restored.best != SearchResult::none)
+    {
+        is_passed   = true;
+        best_config = configs[restored.best];
+        best_time   = restored.best_time;
+    }
+    if(options.shards != 1)
+        MIOPEN_LOG_I("Searching shard " << options.shard << " of " << options.shards);
+
+    // Optionally build the kernels of the next configs on host threads while the current one is
+    // measured. GetSolution() of the solver is then called from several threads at once.
+    using Prepared           = std::pair<ConvSolution, SolutionPrograms>;
+    const auto compile_ahead = Value(MIOPEN_TUNING_COMPILE_AHEAD{}, 0);
+    CompileAhead<Prepared> ahead{compile_ahead,
+                                 std::thread::hardware_concurrency(),
+                                 [&](std::size_t& i) { return planner.Next(i); },
+                                 [&](std::size_t i) {
+                                     Prepared prepared;
+                                     prepared.first = s.GetSolution(context, configs[i], true);
+                                     if(compile_ahead != 0)
+                                         prepared.second =
+                                             BuildSolutionPrograms(profile_h, prepared.first);
+                                     return prepared;
+                                 }};
+
     profile_h.EnableProfiling(true);
-    for(const auto& current_config : all_configs)
+    std::size_t candidate;
+    Prepared prepared;
+    while(ahead.Pop(candidate, prepared))
     {
-        float elapsed_time = 0.0f;
+        const auto& current_config = configs[candidate];
+        float elapsed_time         = 0.0f;
         int ret            = 0;
         MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
                           << current_config);
 
-        const auto current_solution = s.GetSolution(context, current_config, true);
+        const auto& current_solution = prepared.first;
+        AddSolutionPrograms(profile_h, prepared.second);
         if((tweak == SearchTweak::WorkspaceInsteadOfXBuffer ||
             tweak == SearchTweak::WorkspaceInsteadOfWeightsBuffer) &&
            default_solution.workspce_sz != current_solution.workspce_sz)
@@ -561,11 +698,14 @@ auto GenericSearch(const Solver s,
         }
         heartbeat.Monitor(
             ret != 0, elapsed_time, n_current, best_time, n_failed, n_runs_total, current_config);
+        planner.Report(candidate, ret == 0, elapsed_time);
+        checkpointer.Report(candidate, ret == 0, elapsed_time);
         ++n_current;
     }
+    checkpointer.Finish();
 
     profile_h.EnableProfiling(false);
-    MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
+    MIOPEN_LOG_W("Done: " << n_current << '/' << n_failed << '/' << n_runs_total << ", best #"
                           << n_best
                           << ' '
                           << best_time
@@ -29,6 +29,7 @@
 #include <miopen/config.h>
 #include <miopen/kernel_info.hpp>
 #include <miopen/common.hpp>
+#include <miopen/conv/dispatch_cache.hpp>
 #include <miopen/invoker_cache.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/miopen.h>
@@ -38,6 +39,7 @@
 #include <miopen/simple_hash.hpp>
 #include <miopen/solver_id.hpp>
 
+#include <boost/optional/optional.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
 #include <cstdio>
@@ -45,6 +47,7 @@
 #include <ios>
 #include <sstream>
 #include <memory>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
@@ -103,10 +106,17 @@ struct Handle : miopenHandle
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config) const;
 
-    auto GetKernels(const std::string& algorithm, const std::string& network_config) const
+    /// Keeps the kernels added so far for the key from being evicted from the kernel cache. For
+    /// kernels which only an explicit step, such as compiling a fusion plan, builds.
+    void PinKernels(const std::string& algorithm, const std::string& network_config) const;
+
+    std::vector<KernelInvoke> GetKernels(const std::string& algorithm,
+                                         const std::string& network_config) const
     {
-        return this->GetKernelsImpl(algorithm, network_config) |
-               boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
+        auto kernels = std::vector<KernelInvoke>{};
+        for(const auto& k : this->GetKernelsImpl(algorithm, network_config))
+            kernels.push_back(this->Run(k));
+        return kernels;
     }
     KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config) const
     {
@@ -120,8 +130,8 @@ struct Handle : miopenHandle
     }
 
     KernelInvoke Run(Kernel k) const;
-    const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
-                                              const std::string& network_config) const;
+    std::vector<Kernel> GetKernelsImpl(const std::string& algorithm,
+                                       const std::string& network_config) const;
 
     Program LoadProgram(const std::string& program_name,
                         std::string params,
@@ -132,6 +142,15 @@ struct Handle : miopenHandle
 
     void AddProgram(Program prog, const std::string& program_name, const std::string& params) const;
 
+    /// Loads the (name, params) programs found in the binary cache with a single lookup.
+    /// Programs that are not in the binary cache are left empty: nothing is compiled here and
+    /// nothing is added to the kernel cache.
+    std::vector<boost::optional<Program>>
+    LoadCachedPrograms(const std::vector<std::pair<std::string, std::string>>& programs) const;
+
+    CacheStats GetKernelCacheStats() const;
+    void SetKernelCacheCapacity(std::size_t capacity) const;
+
     void Finish() const;
     void Flush() const;
 
@@ -205,28 +224,49 @@ struct Handle : miopenHandle
     std::unordered_map<GemmKey, std::unique_ptr<GemmGeometry>, SimpleHash> geo_map;
 #endif
 
+    /// code_object_bytes, if given, receives the size of the code objects the kernels of the
+    /// invoker use. The invoker keeps them alive, so it is passed on to RegisterInvoker().
     Invoker PrepareInvoker(const InvokerFactory& factory,
-                           const std::vector<solver::KernelInfo>& kernels) const;
+                           const std::vector<solver::KernelInfo>& kernels,
+                           std::size_t* code_object_bytes = nullptr) const;
 
     void RegisterInvoker(const Invoker& invoker,
-                         const NetworkConfig& config,
+                         const ProblemKey& problem,
                          solver::Id solver,
-                         const AlgorithmName& algo)
+                         const AlgorithmName& algo,
+                         std::size_t code_object_bytes = 0)
     {
-        invokers.Register({config, solver.ToString()}, invoker);
-        invokers.SetAsFound1_0(config, algo, solver.ToString());
+        invokers.Register({problem, solver.ToString()}, invoker, code_object_bytes);
+        invokers.SetAsFound1_0(problem, algo, solver.ToString());
     }
 
     boost::optional<const Invoker&>
-    GetInvoker(const NetworkConfig& config,
+    GetInvoker(const ProblemKey& problem,
                const boost::optional<solver::Id>& solver,
                const boost::optional<AlgorithmName>& algo = boost::none) const
     {
         assert(solver || algo);
         assert(!(solver && algo));
         if(solver)
-            return invokers[std::make_pair(config.ToString(), solver->ToString())];
-        return invokers.GetFound1_0(config, *algo);
+            return invokers[std::make_pair(problem, solver->ToString())];
+        return invokers.GetFound1_0(problem, *algo);
+    }
+
+    CacheStats GetInvokerCacheStats() const { return invokers.GetStats(); }
+    void SetInvokerCacheCapacity(std::size_t problems) { invokers.SetCapacity(problems); }
+
+    /// Invoker resolved by a previous immediate mode call with the same arguments, or nullptr.
+    /// Nothing is found once the invoker cache has evicted invokers since it was registered.
+    const Invoker* GetImmediateInvoker(const conv::DispatchKey& key) const
+    {
+        immediate_invokers.SetGeneration(invokers.GetGeneration());
+        return immediate_invokers.Find(key);
+    }
+
+    void RegisterImmediateInvoker(const conv::DispatchKey& key, const Invoker& invoker)
+    {
+        immediate_invokers.SetGeneration(invokers.GetGeneration());
+        immediate_invokers.Store(key, invoker);
     }
 
 #if MIOPEN_USE_ROCBLAS
@@ -239,6 +279,7 @@ struct Handle : miopenHandle
     private:
 #endif
     InvokerCache invokers;
+    mutable conv::DispatchCache immediate_invokers;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Handle& handle) { return handle.Print(os); }
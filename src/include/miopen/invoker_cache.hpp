@@ -28,6 +28,8 @@
 
 #include <miopen/errors.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/lru_cache.hpp>
+#include <miopen/problem_key.hpp>
 
 #include <boost/optional.hpp>
 
@@ -41,19 +43,35 @@ namespace miopen {
 class InvokerCache
 {
     public:
-    // network_config, solver_id
-    using Key = std::pair<std::string, std::string>;
+    // problem, solver_id
+    using Key = std::pair<ProblemKey, std::string>;
+
+    /// The capacity in problems is read from MIOPEN_INVOKER_CACHE_CAPACITY, 0 means unbounded.
+    InvokerCache();
 
     boost::optional<const Invoker&> operator[](const Key& key) const;
     // For find 1.0
-    boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
+    boost::optional<const Invoker&> GetFound1_0(const ProblemKey& problem,
                                                 const std::string& algorithm) const;
-    void Register(const Key& key, const Invoker& invoker);
+    /// code_object_bytes is the size of the code objects the invoker keeps alive.
+    void Register(const Key& key, const Invoker& invoker, std::size_t code_object_bytes = 0);
     // For find 1.0
-    void SetAsFound1_0(const std::string& network_config,
+    void SetAsFound1_0(const ProblemKey& problem,
                        const std::string& algorithm,
                        const std::string& solver_id);
 
+    /// Evicted problems are prepared again from the perf-db and the binary kernel cache.
+    void SetCapacity(std::size_t problems)
+    {
+        invokers.SetCapacity(problems);
+        ++capacity_changes;
+    }
+    CacheStats GetStats() const;
+
+    /// Changes whenever invokers are evicted or the capacity is changed, so that copies of the
+    /// invokers kept elsewhere can be dropped along with them.
+    std::size_t GetGeneration() const { return invokers.GetEvictions() + capacity_changes; }
+
     private:
     struct Item
     {
@@ -62,10 +80,17 @@ class InvokerCache
         std::map<std::string, std::string> found_1_0;
         // solver_id -> invoker
         std::map<std::string, Invoker> invokers;
+        std::size_t code_object_bytes = 0;
     };
 
-    // network_config -> Item
-    std::map<std::string, Item> invokers;
+    // problem -> Item
+    // Lookups refresh the recency of the problem, hence mutable.
+    mutable LruCache<ProblemKey, Item, ProblemKey::Hasher> invokers;
+    mutable std::size_t hits     = 0;
+    mutable std::size_t misses   = 0;
+    std::size_t capacity_changes = 0;
+
+    boost::optional<const Invoker&> Count(boost::optional<const Invoker&> invoker) const;
 };
 
 } // namespace miopen
@@ -32,7 +32,9 @@
 
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
+#include <miopen/compression.hpp>
 #include <miopen/md5.hpp>
+#include <miopen/par_for.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
@@ -40,7 +42,11 @@
 
 #include <string>
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <tuple>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -52,6 +58,7 @@ namespace miopen {
 struct KernelConfig
 {
     static std::string table_name() { return "kern_db"; }
+    static std::string blob_table_name() { return "kern_blob"; }
     std::string kernel_name;
     std::string kernel_args;
     std::string kernel_blob;
@@ -73,15 +80,39 @@ struct KernelConfig
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
            << "ON " << KernelConfig::table_name()
-           << "(kernel_name, kernel_args, kernel_hash, uncompressed_size);";
+           << "(kernel_name, kernel_args, kernel_hash, uncompressed_size);"
+           << "CREATE INDEX IF NOT EXISTS "
+           << "`idx_" << KernelConfig::table_name() << "_hash` "
+           << "ON " << KernelConfig::table_name() << "(kernel_hash);"
+           // Identical binaries are stored once, in the blob table, and referred to by their md5
+           // from the records, whose own kernel_blob is then empty. The triggers keep the number
+           // of referring records up to date and drop the blobs nothing refers to anymore.
+           << "CREATE TABLE IF NOT EXISTS `" << KernelConfig::blob_table_name() << "` ("
+           << "`kernel_hash` TEXT PRIMARY KEY NOT NULL"
+           << ",`kernel_blob` BLOB NOT NULL"
+           << ",`uncompressed_size` INT NOT NULL"
+           << ",`refcount` INT NOT NULL"
+           << ");"
+           << "CREATE TRIGGER IF NOT EXISTS `" << KernelConfig::blob_table_name() << "_ref` "
+           << "AFTER INSERT ON `" << KernelConfig::table_name() << "` "
+           << "WHEN length(NEW.kernel_blob) = 0 BEGIN "
+           << "UPDATE `" << KernelConfig::blob_table_name() << "` SET refcount = refcount + 1 "
+           << "WHERE kernel_hash = NEW.kernel_hash; "
+           << "END;"
+           << "CREATE TRIGGER IF NOT EXISTS `" << KernelConfig::blob_table_name() << "_unref` "
+           << "AFTER DELETE ON `" << KernelConfig::table_name() << "` "
+           << "WHEN length(OLD.kernel_blob) = 0 BEGIN "
+           << "UPDATE `" << KernelConfig::blob_table_name() << "` SET refcount = refcount - 1 "
+           << "WHERE kernel_hash = OLD.kernel_hash; "
+           << "DELETE FROM `" << KernelConfig::blob_table_name() << "` "
+           << "WHERE kernel_hash = OLD.kernel_hash AND refcount <= 0; "
+           << "END;";
         return ss.str();
     }
-    std::string Where() const
+    std::tuple<std::string, std::vector<std::string>> WhereClause() const
     {
-        std::ostringstream ss;
-        ss << "(kernel_name = '" << kernel_name << "')"
-           << " AND (kernel_args = '" << kernel_args << "')";
-        return ss.str();
+        return std::make_tuple("(kernel_name = ?) AND (kernel_args = ?)",
+                               std::vector<std::string>{kernel_name, kernel_args});
     }
 };
 
@@ -90,6 +121,78 @@ class KernDb : public SQLiteBase<KernDb>
     std::function<std::string(std::string, bool*)> compress_fn;
     std::function<std::string(std::string, unsigned int)> decompress_fn;
 
+    struct Row
+    {
+        std::string blob;
+        std::string md5_hash;
+        int64_t uncompressed_size;
+    };
+
+    /// Whether the database has the blob table, which system databases built from older user
+    /// databases may lack.
+    bool content_addressed = false;
+
+    template <typename T>
+    boost::optional<Row> SelectRow(const T& problem_config)
+    {
+        std::string clause;
+        std::vector<std::string> values;
+        std::tie(clause, values) = problem_config.WhereClause();
+        auto select_query =
+            content_addressed
+                ? "SELECT coalesce(b.kernel_blob, k.kernel_blob), k.kernel_hash, "
+                  "coalesce(b.uncompressed_size, k.uncompressed_size) FROM " +
+                      T::table_name() + " AS k LEFT JOIN " + T::blob_table_name() +
+                      " AS b ON length(k.kernel_blob) = 0 AND b.kernel_hash = k.kernel_hash "
+                      "WHERE " +
+                      clause + " AND (length(k.kernel_blob) > 0 OR b.kernel_blob IS NOT NULL);"
+                : "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " + T::table_name() +
+                      " WHERE " + clause + ";";
+        auto stmt = SQLite::Statement{sql, select_query, values};
+        // only one result field
+        // assert one row
+        auto rc = stmt.Step(sql);
+        if(rc == SQLITE_ROW)
+            return Row{stmt.ColumnBlob(0), stmt.ColumnText(1), stmt.ColumnInt64(2)};
+        else if(rc == SQLITE_DONE)
+            return boost::none;
+        else
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        return boost::none;
+    }
+
+    /// The connection is shared by all the threads using the database. Its mutex is held from
+    /// BEGIN to COMMIT, so that no statement of another thread ends up in the transaction.
+    std::unique_ptr<std::mutex> connection_mutex = std::make_unique<std::mutex>();
+
+    /// Runs f in a transaction started with the begin statement. Throws if the transaction
+    /// cannot be started.
+    template <class F>
+    void InTransaction(const std::string& begin, F f)
+    {
+        std::lock_guard<std::mutex> lock{*connection_mutex};
+        sql.Exec(begin);
+        try
+        {
+            f();
+            sql.Exec("COMMIT TRANSACTION;");
+        }
+        catch(...)
+        {
+            // A failed COMMIT leaves the transaction open as well.
+            sql.Exec("ROLLBACK TRANSACTION;");
+            throw;
+        }
+    }
+
+    void Step(SQLite::Statement& stmt) const
+    {
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+
+    std::string DecodeRow(const Row& row) const;
+
     public:
     KernDb(const std::string& filename_,
            bool is_system,
@@ -107,9 +210,12 @@ class KernDb : public SQLiteBase<KernDb>
     {
         if(filename.empty())
             return true;
-        auto del_query =
-            "DELETE FROM " + T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, del_query};
+        std::string clause;
+        std::vector<std::string> values;
+        std::tie(clause, values) = problem_config.WhereClause();
+        auto del_query = "DELETE FROM " + T::table_name() + " WHERE " + clause + ";";
+        std::lock_guard<std::mutex> lock{*connection_mutex};
+        auto stmt = SQLite::Statement{sql, del_query, values};
         auto rc   = stmt.Step(sql);
         if(rc == SQLITE_DONE)
             return true;
@@ -125,67 +231,109 @@ class KernDb : public SQLiteBase<KernDb>
     {
         if(filename.empty())
             return boost::none;
-        // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
-                            T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, select_query};
-        // only one result field
-        // assert one row
-        auto rc = stmt.Step(sql);
-        if(rc == SQLITE_ROW)
+        auto row = boost::optional<Row>{};
         {
-            auto compressed_blob           = stmt.ColumnBlob(0);
-            auto md5_hash                  = stmt.ColumnText(1);
-            auto uncompressed_size         = stmt.ColumnInt64(2);
-            std::string& decompressed_blob = compressed_blob;
-            if(uncompressed_size != 0)
-            {
-                decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
-            }
-            auto new_md5 = md5(decompressed_blob);
-            if(new_md5 != md5_hash)
-                MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
-            return decompressed_blob;
+            std::lock_guard<std::mutex> lock{*connection_mutex};
+            row = SelectRow(problem_config);
         }
-        else if(rc == SQLITE_DONE)
+        if(!row)
             return boost::none;
-        else
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
-        return boost::none;
+        return DecodeRow(*row);
+    }
+
+    /// Looks up several kernels at once. All the rows are read within a single read
+    /// transaction, so the database is locked and its pages are validated once for the whole
+    /// batch; the blobs are then decompressed and verified in parallel.
+    template <typename T>
+    std::vector<boost::optional<std::string>>
+    FindRecordsUnsafe(const std::vector<T>& problem_configs)
+    {
+        auto results = std::vector<boost::optional<std::string>>(problem_configs.size());
+        if(filename.empty() || problem_configs.empty())
+            return results;
+
+        auto rows = std::vector<boost::optional<Row>>{};
+        rows.reserve(problem_configs.size());
+        InTransaction("BEGIN DEFERRED TRANSACTION;", [&]() {
+            for(const auto& problem_config : problem_configs)
+                rows.push_back(SelectRow(problem_config));
+        });
+
+        par_for(rows.size(), 1, [&](auto i) {
+            if(rows[i])
+                results[i] = DecodeRow(*rows[i]);
+        });
+        return results;
     }
 
+    /// Stores the binary in the blob table unless an identical one is already there, and
+    /// replaces the record of the kernel with one referring to it.
     template <typename T>
     boost::optional<std::string> StoreRecordUnsafe(const T& problem_config)
     {
         if(filename.empty())
             return boost::none;
-        auto insert_query = "INSERT OR REPLACE INTO " + T::table_name() +
-                            "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
         auto md5_sum           = md5(problem_config.kernel_blob);
         auto uncompressed_size = problem_config.kernel_blob.size();
-        bool success           = false;
-        auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
-        auto stmt              = SQLite::Statement{sql, insert_query};
-        stmt.BindText(1, problem_config.kernel_name);
-        stmt.BindText(2, problem_config.kernel_args);
-        if(!success)
-        {
-            stmt.BindBlob(3, problem_config.kernel_blob);
-            stmt.BindInt64(5, 0);
-        }
-        else
-        {
-            stmt.BindBlob(3, compressed_blob);
-            stmt.BindInt64(5, uncompressed_size);
-        }
-        stmt.BindText(4, md5_sum);
 
-        auto rc = stmt.Step(sql);
-        if(rc != SQLITE_DONE)
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        std::string clause;
+        std::vector<std::string> values;
+        std::tie(clause, values) = problem_config.WhereClause();
+
+        InTransaction("BEGIN IMMEDIATE TRANSACTION;", [&]() {
+            // Removed first, so that the blob it refers to is not released after being reused.
+            auto del_stmt = SQLite::Statement{
+                sql, "DELETE FROM " + T::table_name() + " WHERE " + clause + ";", values};
+            Step(del_stmt);
+
+            auto find_stmt = SQLite::Statement{
+                sql,
+                "SELECT 1 FROM " + T::blob_table_name() + " WHERE kernel_hash = ?;",
+                {md5_sum}};
+            const auto rc = find_stmt.Step(sql);
+            if(rc != SQLITE_ROW && rc != SQLITE_DONE)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+            if(rc == SQLITE_DONE)
+            {
+                bool success         = false;
+                auto compressed_blob = compress_fn(problem_config.kernel_blob, &success);
+                auto blob_stmt =
+                    SQLite::Statement{sql,
+                                      "INSERT INTO " + T::blob_table_name() +
+                                          "(kernel_hash, kernel_blob, uncompressed_size, "
+                                          "refcount) VALUES(?, ?, ?, 0);"};
+                blob_stmt.BindText(1, md5_sum);
+                blob_stmt.BindBlob(2, success ? compressed_blob : problem_config.kernel_blob);
+                blob_stmt.BindInt64(3, success ? uncompressed_size : 0);
+                Step(blob_stmt);
+            }
+
+            auto insert_stmt =
+                SQLite::Statement{sql,
+                                  "INSERT INTO " + T::table_name() +
+                                      "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
+                                      "uncompressed_size) VALUES(?, ?, ?, ?, ?);"};
+            insert_stmt.BindText(1, problem_config.kernel_name);
+            insert_stmt.BindText(2, problem_config.kernel_args);
+            insert_stmt.BindBlob(3, std::string{});
+            insert_stmt.BindText(4, md5_sum);
+            insert_stmt.BindInt64(5, uncompressed_size);
+            Step(insert_stmt);
+        });
         return problem_config.kernel_blob;
     }
+
+    struct CompactStats
+    {
+        std::size_t records       = 0;
+        std::size_t blobs         = 0;
+        std::size_t moved_blobs   = 0;
+        std::size_t dropped_blobs = 0;
+    };
+
+    /// Moves the binaries still stored in the records into the blob table, so that identical
+    /// ones are stored once, drops the blobs no record refers to and vacuums the file.
+    CompactStats Compact();
 };
 } // namespace miopen
 #endif
@@ -30,8 +30,15 @@
 #include <vector>
 
 #include <miopen/config.h>
+#include <miopen/kernel_source_view.hpp>
 
 namespace miopen {
+const KernelSourceView& GetKernelSrcView(const std::string& name);
+const KernelSourceView& GetKernelIncView(const std::string& key);
+/// Digest of all the text the compiler is given for an embedded kernel. It is derived from the
+/// digests addkernels computed at build time, so the text itself is not read. Empty for kernels
+/// that are not embedded.
+std::string GetKernelSrcDigest(const std::string& name);
 std::string GetKernelSrc(std::string name);
 std::string GetKernelInc(std::string key);
 std::vector<std::string> GetKernelIncList();
@@ -44,6 +44,7 @@
 
 #include <miopen/handle.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/lru_cache.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
 #include <string>
@@ -55,14 +56,22 @@ namespace miopen {
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * The capacity read from MIOPEN_KERNEL_CACHE_CAPACITY bounds the number of programs and,
+ * separately, the number of kernel groups. The least recently used ones are evicted first and
+ * are loaded again from the binary kernel cache when needed. 0 means unbounded.
+ *
+ * Kernel groups which nothing builds again once evicted are pinned: never evicted and not
+ * counted against the capacity. These are the groups of the algorithms which do not use
+ * invokers yet (FFT and Winograd backward weights), which only Find builds, and the groups
+ * pinned by PinKernels(), e.g. those of compiled fusion plans.
  */
 class KernelCache
 {
 
     public:
     using Key        = std::pair<std::string, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    using KernelMap  = LruCache<Key, std::vector<Kernel>, SimpleHash>;
+    using ProgramMap = LruCache<Key, Program, SimpleHash>;
 
     Kernel AddKernel(const Handle& h,
                      const std::string& algorithm,
@@ -80,20 +89,36 @@ class KernelCache
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
 
-    const std::vector<Kernel>& GetKernels(const std::string& algorithm,
-                                          const std::string& network_config);
+    /// Pins the kernels added so far for the key. Kernels added later for it are pinned as well.
+    void PinKernels(const std::string& algorithm, const std::string& network_config);
+
+    /// A copy, as adding kernels later may evict the group.
+    std::vector<Kernel> GetKernels(const std::string& algorithm,
+                                   const std::string& network_config);
 
     bool HasKernels(const std::string& algorithm, const std::string& network_config) const;
 
-    bool HasProgram(const std::string& name, const std::string& params) const;
+    bool HasProgram(const std::string& name, std::string params) const;
 
     void AddProgram(Program prog, const std::string& program_name, std::string params);
 
+    /// Size of the code object of the cached program, 0 if it is not cached.
+    std::size_t GetCodeObjectSize(const std::string& program_name, std::string params) const;
+
+    void SetCapacity(std::size_t capacity);
+
+    CacheStats GetStats() const;
+
     KernelCache();
 
     private:
+    bool IsPinned(const Key& key) const;
+
     KernelMap kernel_map;
+    std::unordered_map<Key, std::vector<Kernel>, SimpleHash> pinned_kernels;
     ProgramMap program_map;
+    std::size_t hits   = 0;
+    std::size_t misses = 0;
 };
 
 } // namespace miopen
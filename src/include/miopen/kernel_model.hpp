@@ -0,0 +1,103 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERNEL_MODEL_HPP_
+#define GUARD_MIOPEN_KERNEL_MODEL_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// Resources and work of a kernel with a given performance config, estimated on the host without
+/// compiling it. Used to rank and prune tuning spaces.
+struct KernelModel
+{
+    /// Work-items per workgroup.
+    std::size_t block_size = 0;
+    /// Workgroups per launch.
+    std::size_t grid_size = 0;
+    /// LDS per workgroup, in bytes.
+    std::size_t lds_bytes = 0;
+    /// Estimated registers per work-item.
+    std::size_t vgprs = 0;
+    /// Estimated accumulation registers (AGPRs) per work-item, used by xdlops.
+    std::size_t acc_vgprs = 0;
+    /// Useful fraction of the work, e.g. of the padded GEMM tiles, in (0, 1].
+    float tile_efficiency = 1.0f;
+    /// Arithmetic operations per element read from LDS; larger tiles reuse data more.
+    float reuse = 1.0f;
+};
+
+/// Resources of a GCN device.
+struct DeviceModel
+{
+    std::size_t compute_units = 64;
+    /// LDS per compute unit, in bytes.
+    std::size_t lds_bytes = 65536;
+    /// Without AGPRs (before gfx908), accumulation registers are taken from the VGPRs.
+    bool has_acc_vgprs = false;
+
+    std::size_t simds_per_cu   = 4;
+    std::size_t wave_size      = 64;
+    std::size_t max_waves      = 10; // per SIMD
+    std::size_t max_workgroups = 40; // per CU
+    std::size_t vgprs          = 256; // per work-item of a wave
+};
+
+/// Workgroups of the kernel that fit into a compute unit at once, 0 if it does not fit at all.
+std::size_t GetWorkgroupsPerCu(const KernelModel& kernel, const DeviceModel& device);
+
+/// Estimated throughput of the kernel relative to other configs of the same kernel, the higher the
+/// better. 0 if the kernel cannot run on the device.
+///
+/// Accounts for the tail of the grid that leaves compute units idle, for too few waves to hide
+/// latencies, for the tile efficiency and for the data reuse.
+float GetKernelScore(const KernelModel& kernel, const DeviceModel& device);
+
+/// Indices of the kernels which can run, highest score first, at most top_k of them (0 for all).
+/// Kernels with equal scores keep their order.
+std::vector<std::size_t> RankKernels(const std::vector<KernelModel>& kernels,
+                                     const DeviceModel& device,
+                                     std::size_t top_k);
+
+/// Kernel model of a blockwise GEMM that computes an m_per_block x n_per_block tile of a
+/// gemm_m x gemm_n matrix per workgroup, reading k_per_block x (m_per_block + n_per_block)
+/// elements of data_size bytes per iteration.
+KernelModel GetBlockwiseGemmModel(std::size_t gemm_m,
+                                  std::size_t gemm_n,
+                                  std::size_t m_per_block,
+                                  std::size_t n_per_block,
+                                  std::size_t k_per_block,
+                                  std::size_t block_size,
+                                  std::size_t grid_size,
+                                  std::size_t lds_bytes,
+                                  std::size_t data_size);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERNEL_MODEL_HPP_
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERNEL_SOURCE_VIEW_HPP_
+#define GUARD_MIOPEN_KERNEL_SOURCE_VIEW_HPP_
+
+#include <cstddef>
+#include <string>
+
+namespace miopen {
+
+/// Non-owning view of a kernel source text.
+///
+/// The kernel sources and includes embedded into the library by addkernels are static, so
+/// views of them can be handed to the compilers without copying the text. Views of embedded
+/// files also carry the MD5 digest of the text, computed when the library was built.
+class KernelSourceView
+{
+    public:
+    KernelSourceView() = default;
+    KernelSourceView(const char* data, std::size_t size, const char* md5 = nullptr)
+        : text(data), length(size), digest(md5)
+    {
+    }
+    // Implicit, so that functions taking a view also accept the sources built at runtime.
+    KernelSourceView(const std::string& s) : text(s.data()), length(s.size()) {}
+
+    const char* data() const { return text; }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    /// The MD5 of the text, or nullptr if the text was not embedded into the library.
+    const char* md5() const { return digest; }
+    std::string str() const { return {text, length}; }
+
+    private:
+    const char* text   = "";
+    std::size_t length = 0;
+    const char* digest = nullptr;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERNEL_SOURCE_VIEW_HPP_
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace miopen {
+
+/// Usage counters of an in-memory cache. A capacity of 0 means the cache is unbounded.
+struct CacheStats
+{
+    std::size_t hits      = 0;
+    std::size_t misses    = 0;
+    std::size_t evictions = 0;
+    std::size_t entries   = 0;
+    std::size_t capacity  = 0;
+    /// Approximate host and code object memory held by the entries.
+    std::size_t bytes = 0;
+};
+
+/// Map with an optional capacity that evicts the least recently used entries.
+/// Find() and GetOrInsert() refresh recency, Peek() does not. Hits and misses are counted by
+/// the owner, which knows what a hit is for its lookups.
+/// Pointers and references to an entry stay valid until the entry is evicted or erased.
+template <class Key, class Value, class Hash = std::hash<Key>>
+class LruCache
+{
+    public:
+    explicit LruCache(std::size_t capacity_ = 0) : capacity(capacity_) {}
+
+    Value* Find(const Key& key)
+    {
+        const auto it = index.find(key);
+        if(it == index.end())
+            return nullptr;
+        Touch(it->second);
+        return &it->second->second;
+    }
+
+    const Value* Peek(const Key& key) const
+    {
+        const auto it = index.find(key);
+        return it == index.end() ? nullptr : &it->second->second;
+    }
+
+    /// Inserting may evict other entries, never the one returned.
+    Value& GetOrInsert(const Key& key)
+    {
+        const auto it = index.find(key);
+        if(it != index.end())
+        {
+            Touch(it->second);
+            return it->second->second;
+        }
+        entries.emplace_front(key, Value{});
+        index.emplace(key, entries.begin());
+        Shrink();
+        return entries.front().second;
+    }
+
+    bool Erase(const Key& key)
+    {
+        const auto it = index.find(key);
+        if(it == index.end())
+            return false;
+        entries.erase(it->second);
+        index.erase(it);
+        return true;
+    }
+
+    void SetCapacity(std::size_t value)
+    {
+        capacity = value;
+        Shrink();
+    }
+
+    std::size_t GetCapacity() const { return capacity; }
+    std::size_t GetEvictions() const { return evictions; }
+    std::size_t Size() const { return entries.size(); }
+
+    /// Fills everything but hits and misses. approx_bytes(key, value) estimates the memory held
+    /// by one entry.
+    template <class F>
+    CacheStats GetStats(F approx_bytes) const
+    {
+        auto stats      = CacheStats{};
+        stats.evictions = evictions;
+        stats.entries   = entries.size();
+        stats.capacity  = capacity;
+        for(const auto& entry : entries)
+            stats.bytes += approx_bytes(entry.first, entry.second);
+        return stats;
+    }
+
+    private:
+    using Entries = std::list<std::pair<const Key, Value>>;
+
+    Entries entries; // most recently used first
+    std::unordered_map<Key, typename Entries::iterator, Hash> index;
+    std::size_t capacity;
+    std::size_t evictions = 0;
+
+    void Touch(typename Entries::iterator it) { entries.splice(entries.begin(), entries, it); }
+
+    void Shrink()
+    {
+        while(capacity != 0 && entries.size() > capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+            ++evictions;
+        }
+    }
+};
+
+} // namespace miopen
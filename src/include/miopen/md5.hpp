@@ -1,11 +1,36 @@
 #ifndef GUARD_MLOPEN_MD5_HPP
 #define GUARD_MLOPEN_MD5_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace miopen {
 
-std::string md5(std::string s);
+/// Incremental MD5, for hashing a key made of several pieces without concatenating them.
+/// MD5 is only used where the digests are stored on disk; in-process keys use FastHasher.
+class Md5Hasher
+{
+    public:
+    Md5Hasher();
+    Md5Hasher& Update(const void* data, std::size_t size);
+    Md5Hasher& Update(const std::string& s) { return Update(s.data(), s.size()); }
+    /// Finishes the hash. The hasher is reset afterwards.
+    std::string HexDigest();
+
+    struct Context
+    {
+        std::uint32_t lo, hi;
+        std::uint32_t a, b, c, d;
+        unsigned char buffer[64];
+        std::uint32_t block[16];
+    };
+
+    private:
+    Context ctx;
+};
+
+std::string md5(const std::string& s);
 
 } // namespace miopen
 
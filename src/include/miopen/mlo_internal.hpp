@@ -185,6 +185,7 @@ size_t setBotDfDescFromMLDesc(int spatial_dims, TTo& to, const TensorDescriptor&
 
 namespace solver {
 struct ConvSolution;
+struct Id;
 
 } // namespace solver
 
@@ -245,6 +246,9 @@ FindImplicitGemmWrWAllSolutions(const miopen::ConvolutionContext& ctx);
 std::vector<miopen::solver::ConvSolution>
 FindAllBwdWrW2DSolutions(const miopen::ConvolutionContext& ctx);
 
+/// Solvers which Find would try on the problem, without building their solutions.
+std::vector<miopen::solver::Id> FindAllApplicableSolvers(const miopen::ConvolutionContext& ctx);
+
 struct mlo_construct_base
 {
     mlo_construct_base(miopen::conv::Direction dir, bool do_bias = false) : _search_params(dir)
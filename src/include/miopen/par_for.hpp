@@ -27,10 +27,17 @@
 #ifndef MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 #define MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 
+#include <miopen/thread_pool.hpp>
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
+#include <exception>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <vector>
 
@@ -59,24 +66,76 @@ struct joinable_thread : std::thread
     }
 };
 
-struct thread_factory
+namespace detail {
+
+/// Shared by the threads running one par_for() loop. The iterations are handed out in chunks
+/// on demand, so that threads done with cheap iterations take over the rest of the work.
+class ParForLoop
 {
-    template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
+    public:
+    ParForLoop(std::size_t n_,
+               std::size_t chunk_,
+               std::function<void(std::size_t, std::size_t)> body_)
+        : n(n_), chunk(chunk_), body(std::move(body_))
     {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
+    }
+
+    void Run()
+    {
+        while(true)
+        {
+            const auto first = next.fetch_add(chunk);
+            if(first >= n)
+                return;
+            const auto last = std::min(n, first + chunk);
+
+            if(!failed)
             {
-                f(i);
+                try
+                {
+                    body(first, last);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(!error)
+                        error = std::current_exception();
+                    failed = true;
+                }
             }
-        });
-        work += grainsize;
-        return result;
+
+            if(done.fetch_add(last - first) + (last - first) == n)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+
+    void Wait()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [&]() { return done == n; });
+        }
+        if(error)
+            std::rethrow_exception(error);
     }
+
+    private:
+    const std::size_t n;
+    const std::size_t chunk;
+    const std::function<void(std::size_t, std::size_t)> body;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable finished;
 };
 
+} // namespace detail
+
 template <class F>
 void par_for_impl(std::size_t n, std::size_t threadsize, F f)
 {
@@ -87,14 +146,24 @@ void par_for_impl(std::size_t n, std::size_t threadsize, F f)
     }
     else
     {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
+        // Several chunks per thread to balance loops with uneven iterations.
+        const auto chunk = std::max<std::size_t>(n / (threadsize * 8), 1);
+        const auto loop  = std::make_shared<detail::ParForLoop>(
+            n, chunk, [&f](std::size_t first, std::size_t last) {
+                for(std::size_t i = first; i < last; i++)
+                    f(i);
+            });
+
+        // The calling thread works on the loop too. Thus a loop started from a pool thread always
+        // completes, even if all other pool threads are busy.
+        auto& pool         = ThreadPool::Get();
+        const auto chunks  = (n + chunk - 1) / chunk;
+        const auto helpers = std::min({threadsize - 1, chunks - 1, pool.Size()});
+        for(std::size_t i = 0; i < helpers; i++)
+            pool.Submit([loop]() { loop->Run(); });
+
+        loop->Run();
+        loop->Wait();
     }
 }
 
@@ -29,6 +29,7 @@
 
 #include <miopen/conv/problem_description.hpp>
 #include <miopen/names.hpp>
+#include <miopen/problem_key.hpp>
 #include <miopen/tensor.hpp>
 #if MIOPEN_ENABLE_SQLITE
 #include <miopen/sqlite_db.hpp>
@@ -328,12 +329,9 @@ struct ProblemDescription
 
     int mloBuildConf_Key(std::string& conf_key) const;
 
-    NetworkConfig BuildConfKey() const
-    {
-        std::string ret;
-        mloBuildConf_Key(ret);
-        return NetworkConfig{ret};
-    }
+    ProblemKey MakeKey() const;
+
+    NetworkConfig BuildConfKey() const { return MakeKey().ToNetworkConfig(); }
 };
 } // namespace miopen
 
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_PROBLEM_KEY_HPP_
+#define GUARD_MIOPEN_PROBLEM_KEY_HPP_
+
+#include <miopen/miopen.h>
+#include <miopen/names.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace miopen {
+
+/// Compact identity of a convolution problem, used to key in-memory caches.
+///
+/// Building the textual network config and db keys costs a few allocations and a stream per
+/// call, which the immediate mode paid on every convolution just to look up an invoker. The key
+/// holds the same fields as plain integers with a hash computed once, so it is cheap to build,
+/// copy, hash and compare. The textual forms are only produced from it when a db or a log needs
+/// them, and are identical to what ProblemDescription always wrote.
+struct ProblemKey
+{
+    static constexpr std::size_t max_layout_length = 15;
+
+    int spatial_dims      = 0;
+    int in_channels       = 0;
+    int in_depth          = 0;
+    int in_height         = 0;
+    int in_width          = 0;
+    int weights_depth     = 0;
+    int weights_height    = 0;
+    int weights_width     = 0;
+    int out_channels      = 0;
+    int out_depth         = 0;
+    int out_height        = 0;
+    int out_width         = 0;
+    int batch_size        = 0;
+    int pad_d             = 0;
+    int pad_h             = 0;
+    int pad_w             = 0;
+    int stride_d          = 0;
+    int stride_h          = 0;
+    int stride_w          = 0;
+    int dilation_d        = 0;
+    int dilation_h        = 0;
+    int dilation_w        = 0;
+    int group_count       = 0;
+    int bias              = 0;
+    int in_data_type      = 0;
+    int weights_data_type = 0;
+    int out_data_type     = 0;
+    /// 'F', 'B' or 'W'.
+    char direction = 0;
+    /// Zero padded, so that comparing the whole buffer is enough.
+    char in_layout[max_layout_length + 1] = {};
+
+    void SetLayout(const std::string& layout);
+    /// Has to be called after the fields are filled and before the key is used.
+    void UpdateHash();
+    std::size_t GetHash() const { return hash; }
+
+    /// The network config string, as used by the kernel cache and the find-db validation.
+    NetworkConfig ToNetworkConfig() const;
+    /// The perf-db and find-db key.
+    std::string ToDbKey() const;
+
+    friend bool operator==(const ProblemKey& left, const ProblemKey& right);
+    friend bool operator!=(const ProblemKey& left, const ProblemKey& right)
+    {
+        return !(left == right);
+    }
+    friend std::ostream& operator<<(std::ostream& stream, const ProblemKey& key);
+
+    struct Hasher
+    {
+        std::size_t operator()(const ProblemKey& key) const { return key.GetHash(); }
+    };
+
+    private:
+    std::size_t hash = 0;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_PROBLEM_KEY_HPP_
@@ -27,15 +27,21 @@
 #define MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 
 #include <miopen/db_record.hpp>
+#include <miopen/perf_field.hpp>
 
 #include <boost/optional.hpp>
 
+#include <memory>
 #include <unordered_map>
 #include <string>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 namespace miopen {
 
+class FindDbImageFile;
+
 class ReadonlyRamDb
 {
     public:
@@ -48,6 +54,9 @@ class ReadonlyRamDb
 
     boost::optional<DbRecord> FindRecord(const std::string& problem) const
     {
+        if(image)
+            return FindRecordInImage(problem);
+
         const auto it = cache.find(problem);
 
         if(it == cache.end())
@@ -79,6 +88,19 @@ class ReadonlyRamDb
         return FindRecord(key);
     }
 
+    /// Gets the find-db entries of a record. Entries of a binary image are copied straight from
+    /// its fields, without formatting and parsing them as text.
+    bool FindItems(const std::string& problem,
+                   std::vector<std::pair<std::string, FindDbData>>& items) const;
+
+    template <class TProblem>
+    bool FindItems(const TProblem& problem,
+                   std::vector<std::pair<std::string, FindDbData>>& items) const
+    {
+        const auto key = DbRecord::Serialize(problem);
+        return FindItems(key, items);
+    }
+
     template <class TProblem, class TValue>
     bool Load(const TProblem& problem, const std::string& id, TValue& value) const
     {
@@ -97,6 +119,8 @@ class ReadonlyRamDb
 
     std::string db_path;
     std::unordered_map<std::string, CacheItem> cache;
+    /// Binary image of the db made by fdb2bin. Used instead of the cache when available.
+    std::shared_ptr<const FindDbImageFile> image;
 
     ReadonlyRamDb(const ReadonlyRamDb&) = default;
     ReadonlyRamDb(ReadonlyRamDb&&)      = default;
@@ -104,6 +128,8 @@ class ReadonlyRamDb
     ReadonlyRamDb& operator=(ReadonlyRamDb&&) = default;
 
     void Prefetch(const std::string& path, bool warn_if_unreadable);
+    bool TryLoadImage(const std::string& path);
+    boost::optional<DbRecord> FindRecordInImage(const std::string& problem) const;
     void
     ParseAndLoadDb(std::istream& input_stream, const std::string& path, bool warn_if_unreadable);
 };
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_CHECKPOINT_HPP_
+#define GUARD_MIOPEN_SEARCH_CHECKPOINT_HPP_
+
+#include <miopen/search_strategy.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// Progress of a search of one shard, see SearchOptions::shard. Saved periodically, so that an
+/// interrupted search can be resumed, and so that the shards searched by several processes can
+/// be merged.
+struct SearchCheckpoint
+{
+    struct Entry
+    {
+        std::size_t candidate;
+        bool succeeded;
+        float time;
+    };
+
+    /// Number of candidates in the search space. Checkpoints of another space are ignored.
+    std::size_t total  = 0;
+    std::size_t shard  = 0;
+    std::size_t shards = 1;
+    /// The shard has been searched completely.
+    bool done = false;
+    /// The evaluated candidates in the order of evaluation.
+    std::vector<Entry> evaluated;
+
+    /// E.g. "1728,0,4,0,5/0.0123,9/-" for a search that evaluated the candidates 5 and 9 of the
+    /// first of four shards, and 9 has failed.
+    void Serialize(std::ostream& stream) const;
+    bool Deserialize(const std::string& str);
+};
+
+/// Checkpoints of the searches of a solver on a problem, stored in a text database under the key
+/// of the problem, with an ID per shard. Does nothing if the path is empty.
+class SearchCheckpointDb
+{
+    public:
+    SearchCheckpointDb(std::string path_, std::string key_, std::string solver_id_);
+
+    /// Checkpoints of all the shards.
+    std::vector<SearchCheckpoint> Load() const;
+    void Save(const SearchCheckpoint& checkpoint) const;
+    /// Removes the checkpoints of all the shards.
+    void Remove() const;
+
+    private:
+    std::string path;
+    std::string key;
+    std::string solver_id;
+
+    std::string GetId(const SearchCheckpoint& checkpoint) const;
+    bool IsOwnId(const std::string& id) const;
+};
+
+/// Reads MIOPEN_TUNING_CHECKPOINT_PATH. By default, the checkpoints are kept in the user db
+/// directory. Returns an empty string if checkpoints are disabled.
+std::string GetSearchCheckpointPath(const std::string& db_basename);
+
+/// Reads MIOPEN_TUNING_CHECKPOINT_INTERVAL, 30 s by default. Zero disables checkpoints.
+float GetSearchCheckpointInterval();
+
+/// Resumes a search from the checkpoints in db and saves its progress there every interval
+/// seconds:
+///
+///     SearchPlanner planner{options, features};
+///     SearchCheckpointer checkpointer{db, planner, options, total};
+///     while(planner.Next(i))
+///     {
+///         planner.Report(i, succeeded, time);
+///         checkpointer.Report(i, succeeded, time);
+///     }
+///     checkpointer.Finish();
+///
+/// The candidates of the planner's shard evaluated according to any of the checkpoints are
+/// restored into the planner. When the search of a shard is finished, its checkpoint is kept
+/// marked as done, so that a search of the whole space merges the results of the shards. When
+/// the search of the whole space is finished, the checkpoints of all the shards are removed.
+class SearchCheckpointer
+{
+    public:
+    SearchCheckpointer(SearchCheckpointDb db_,
+                       SearchPlanner& planner,
+                       const SearchOptions& options,
+                       std::size_t total,
+                       float interval_ = GetSearchCheckpointInterval());
+
+    void Report(std::size_t candidate, bool succeeded, float time);
+    void Finish();
+
+    private:
+    SearchCheckpointDb db;
+    SearchCheckpoint checkpoint;
+    std::chrono::duration<float> interval;
+    std::chrono::steady_clock::time_point saved;
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_CHECKPOINT_HPP_
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
+#define GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// Order in which GenericSearch() evaluates the performance configs of a solver.
+enum class SearchStrategy
+{
+    /// All the configs, in the order of the container. The default.
+    Exhaustive,
+    /// The configs in random order.
+    Random,
+    /// Simulated annealing: moves to configs which differ from the current one in as few
+    /// parameters as possible, and accepts slower ones with a probability that decreases over
+    /// time.
+    Annealing,
+    /// Starts with the configs that resemble the ones tuned for other problems, as found in the
+    /// perf-db, then goes on with the configs that the times measured so far predict to be the
+    /// fastest.
+    Model,
+};
+
+std::ostream& operator<<(std::ostream& os, SearchStrategy strategy);
+
+/// Limits of a search. Zero means no limit. All the strategies stop early when a limit is
+/// reached, and the best config found so far is used.
+struct SearchBudget
+{
+    std::size_t evaluations = 0;
+    float seconds           = 0.0f;
+    /// Number of evaluations in a row which have not improved the best time.
+    std::size_t patience = 0;
+};
+
+struct SearchOptions
+{
+    SearchStrategy strategy = SearchStrategy::Exhaustive;
+    SearchBudget budget;
+    unsigned seed = 0;
+    /// Only the candidates with index % shards == shard are searched, so that several processes
+    /// can split a search.
+    std::size_t shard  = 0;
+    std::size_t shards = 1;
+};
+
+/// Reads MIOPEN_TUNING_STRATEGY, MIOPEN_TUNING_MAX_EVALUATIONS, MIOPEN_TUNING_TIME_LIMIT,
+/// MIOPEN_TUNING_PATIENCE, MIOPEN_TUNING_SEED and MIOPEN_TUNING_SHARD.
+SearchOptions GetSearchOptions();
+
+/// Numeric fields of a serialized performance config, e.g. {16, 4, 1, 0} for "16,4,1,0". Used to
+/// compare configs with each other without knowing their type.
+std::vector<float> GetConfigFeatures(const std::string& serialized);
+
+struct SearchResult
+{
+    static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+    std::size_t best      = none;
+    float best_time       = std::numeric_limits<float>::max();
+    std::size_t evaluated = 0;
+    std::size_t failed    = 0;
+};
+
+/// Chooses the candidates 0..features.size()-1 to evaluate, one by one, until all have been
+/// evaluated or the budget is spent. Each candidate is chosen at most once:
+///
+///     SearchPlanner planner{options, features, tuned};
+///     std::size_t i;
+///     while(planner.Next(i))
+///         planner.Report(i, succeeded, time);
+///
+/// features holds the features of each candidate, see GetConfigFeatures(); they may be empty for
+/// the Exhaustive and Random strategies. tuned holds the features of configs tuned for other
+/// problems and is only used by the Model strategy.
+///
+/// Does not depend on the GPU, so strategies can be tried on a mock measure.
+class SearchPlanner
+{
+    public:
+    SearchPlanner(const SearchOptions& options,
+                  std::vector<std::vector<float>> features,
+                  std::vector<std::vector<float>> tuned = {});
+    SearchPlanner(const SearchPlanner&) = delete;
+    SearchPlanner& operator=(const SearchPlanner&) = delete;
+    ~SearchPlanner();
+
+    /// Returns false when the search is over.
+    bool Next(std::size_t& candidate);
+    /// Shall be called for each candidate returned by Next(). Several candidates may be
+    /// outstanding at once (e.g. when they are compiled ahead); the budget counts them
+    /// when they are returned, and the strategy picks the next ones without their results.
+    void Report(std::size_t candidate, bool succeeded, float time);
+    /// Accounts for a candidate evaluated earlier, e.g. by an interrupted search, as if it was
+    /// returned by Next() and reported. Returns false if the candidate is not in the shard or has
+    /// been evaluated already.
+    bool Restore(std::size_t candidate, bool succeeded, float time);
+    const SearchResult& GetResult() const;
+
+    class Strategy;
+
+    private:
+    SearchOptions options;
+    std::vector<std::vector<float>> features;
+    std::vector<std::vector<float>> tuned;
+    std::vector<char> evaluated;
+    std::unique_ptr<Strategy> strategy;
+    SearchResult result;
+    std::size_t available  = 0;
+    std::size_t issued     = 0;
+    std::size_t since_best = 0;
+    std::chrono::steady_clock::time_point start;
+};
+
+/// Evaluates a candidate. Returns false if it has failed, otherwise sets the time.
+using SearchMeasure = std::function<bool(std::size_t candidate, float& time)>;
+
+/// Runs SearchPlanner with the measure.
+SearchResult RunSearch(const SearchOptions& options,
+                       const std::vector<std::vector<float>>& features,
+                       const std::vector<std::vector<float>>& tuned,
+                       const SearchMeasure& measure);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
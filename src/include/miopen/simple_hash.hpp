@@ -27,6 +27,8 @@
 #ifndef GUARD_MLOPEN_SIMPLE_HASH_HPP
 #define GUARD_MLOPEN_SIMPLE_HASH_HPP
 
+#include <miopen/fast_hash.hpp>
+
 #include <string>
 
 namespace miopen {
@@ -34,8 +36,9 @@ struct SimpleHash
 {
     size_t operator()(const std::pair<std::string, std::string>& p) const
     {
-        using std::hash;
-        return (hash<std::string>()(p.first) ^ hash<std::string>()(p.second));
+        // Unlike combining std::hash of the parts, this keeps swapped pairs apart.
+        return static_cast<size_t>(
+            FastHasher{}.UpdatePiece(p.first).UpdatePiece(p.second).Finalize().low);
     }
 };
 
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SOLUTION_RANKER_HPP_
+#define GUARD_MIOPEN_SOLUTION_RANKER_HPP_
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Numeric description of a convolution problem, parsed from its find-db key.
+struct ConvShape
+{
+    /// The parts which have to match exactly: spatial dimensions, layout, data types and
+    /// direction.
+    std::string kind;
+    /// Logarithms of the sizes, strides, pads etc., which the distance between problems is
+    /// computed over.
+    std::vector<double> features;
+    /// Lower bound of the time in ms by the arithmetic and the memory traffic of the problem.
+    double roofline = 0.0;
+
+    /// Returns false if the key is not a convolution find-db key.
+    static bool Parse(const std::string& key, ConvShape& shape);
+
+    double Distance(const ConvShape& other) const;
+};
+
+struct RankedSolution
+{
+    std::string solver;
+    /// Estimated time, in ms.
+    float time;
+};
+
+/// Estimates the times of solvers on a problem without measuring them: each solver is expected
+/// to be as much slower than the roofline of the problem as it is on the nearest problems it was
+/// measured on, e.g. the ones in the installed find-db.
+class SolutionRanker
+{
+    public:
+    struct Sample
+    {
+        std::string key;
+        ConvShape shape;
+        /// Solvers and their times in ms.
+        std::vector<std::pair<std::string, float>> times;
+    };
+
+    /// Returns false if the key cannot be parsed.
+    bool Add(const std::string& key, std::vector<std::pair<std::string, float>> times);
+    /// Adds the records of a find-db text file. Returns the number of records added.
+    std::size_t Load(const std::string& path);
+
+    const std::vector<Sample>& GetSamples() const { return samples; }
+
+    /// The candidates with their estimated times, fastest first. Candidates which have not been
+    /// measured on any similar problem come last, in the given order. Samples with the key
+    /// `exclude` are ignored, which allows to validate the estimates on the samples themselves.
+    std::vector<RankedSolution> Rank(const std::string& key,
+                                     const std::vector<std::string>& candidates,
+                                     const std::string& exclude = "") const;
+
+    private:
+    std::vector<Sample> samples;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SOLUTION_RANKER_HPP_
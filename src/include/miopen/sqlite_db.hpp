@@ -161,6 +161,9 @@ class SQLite
     std::unique_ptr<impl> pImpl;
 
     public:
+    /// Prepared statements are borrowed from a per-connection cache keyed by the query text and
+    /// are reset and returned to it on destruction. Queries should therefore bind their values
+    /// instead of embedding them, so that each query shape is prepared only once.
     class Statement
     {
         class impl;
@@ -295,6 +298,12 @@ class SQLiteBase
         return reinterpret_cast<Derived*>(this)->FindRecordUnsafe(args...);
     }
 
+    template <typename... U>
+    inline auto FindRecords(U&... args)
+    {
+        return reinterpret_cast<Derived*>(this)->FindRecordsUnsafe(args...);
+    }
+
     template <typename... U>
     inline auto RemoveRecord(U&... args)
     {
@@ -409,9 +418,11 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             "ON perf_db.config = " + problem_config.table_name() +".id "
             "WHERE "
             "( " + clause + " )"
-            "AND (arch = '" + arch + "' ) "
-            "AND (num_cu = '" + std::to_string(num_cu) + "');";
+            "AND (arch = ? ) "
+            "AND (num_cu = ? );";
         // clang-format on
+        values.push_back(arch);
+        values.push_back(std::to_string(num_cu));
         auto stmt = SQLite::Statement{sql, select_query, values};
         DbRecord rec;
         while(true)
@@ -448,8 +459,9 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             "WHERE config IN ("
             "SELECT id FROM config WHERE ( "
             + clause + " ) )"
-            "AND solver == '" +  id + "' ;";
+            "AND solver == ? ;";
         // clang-format on
+        values.push_back(id);
         auto stmt = SQLite::Statement{sql, query, values};
         auto rc   = stmt.Step(sql);
         if(rc == SQLITE_DONE)
@@ -555,6 +567,21 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             return true;
     }
 
+    /// Copies all configs and performance records from the perf db at SOURCE_PATH into this db
+    /// within a single transaction. Records from the source replace the existing records with
+    /// the same config, solver, arch and num_cu.
+    ///
+    /// Returns false if the source cannot be read or this db cannot be written. In that case this
+    /// db is left unchanged.
+    bool ImportRecords(const std::string& source_path);
+
+    /// Copies all records of this db into the perf db at TARGET_PATH, creating it if necessary.
+    /// See ImportRecords().
+    bool ExportRecords(const std::string& target_path) const;
+
+    /// Gets the perf parameters stored for the solver ID for all problem configs.
+    std::vector<std::string> FindValues(const std::string& id);
+
     /// Searches for record with key PROBLEM_CONFIG and gets VALUES under the ID from it.
     /// Class T should have "void Serialize(PDAttr_t&) const" member function available.
     /// Class V shall have "bool Deserialize(const std::string& str)" member function available.
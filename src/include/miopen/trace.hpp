@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TRACE_HPP_
+#define GUARD_MIOPEN_TRACE_HPP_
+
+#include <miopen/config.h>
+#include <miopen/logger.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace miopen {
+namespace trace {
+
+/// Span tracing. Spans are recorded to per-thread ring buffers and can be exported in the Chrome
+/// trace event format, which chrome://tracing and https://ui.perfetto.dev open directly. Tracing
+/// is off by default; setting MIOPEN_TRACE to a file name turns it on for the whole run and
+/// writes the trace to that file at exit. When tracing is off a span costs one relaxed load and
+/// one branch at its start, and a test of the value the start left in a register at its end;
+/// nothing is allocated. Builds configured with MIOPEN_ENABLE_TRACE=Off compile the spans out:
+/// Span is then an empty type, so neither its start nor its end costs anything.
+namespace detail {
+
+extern std::atomic<bool> enabled;
+
+std::uint64_t Now();
+void Record(const char* category,
+            const char* name,
+            std::string&& args,
+            std::uint64_t start,
+            std::uint64_t end);
+
+} // namespace detail
+
+inline bool IsEnabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+void Enable(bool enable);
+/// Drops all the events recorded so far.
+void Clear();
+/// Writes the recorded events in the Chrome trace event (JSON) format. Recording goes on.
+void WriteChromeTrace(std::ostream& os);
+void WriteChromeTrace(const std::string& path);
+
+#if MIOPEN_ENABLE_TRACE
+/// Records the time from its construction to its destruction. category and name must be string
+/// literals or otherwise outlive the process; per-span details, like a solver name or a problem
+/// key, are passed as a callable which is only evaluated when tracing is on.
+class Span
+{
+    public:
+    Span(const char* category_, const char* name_) : category(category_), name(name_)
+    {
+        if(IsEnabled())
+            start = detail::Now();
+    }
+
+    template <class F>
+    Span(const char* category_, const char* name_, F&& get_args) : category(category_), name(name_)
+    {
+        if(IsEnabled())
+        {
+            args  = std::forward<F>(get_args)();
+            start = detail::Now();
+        }
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    ~Span()
+    {
+        if(start != 0)
+            detail::Record(category, name, std::move(args), start, detail::Now());
+    }
+
+    private:
+    const char* category;
+    const char* name;
+    std::string args;
+    std::uint64_t start = 0;
+};
+#else
+/// Tracing is compiled out. The span is inert: trivially destructible, so it is optimized away.
+class Span
+{
+    public:
+    Span(const char*, const char*) {}
+    template <class F>
+    Span(const char*, const char*, F&&)
+    {
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+};
+#endif
+
+} // namespace trace
+} // namespace miopen
+
+#define MIOPEN_TRACE_SPAN(category, name) \
+    const miopen::trace::Span MIOPEN_PP_CAT(miopen_trace_span_, __LINE__)(category, name)
+
+/// The detail expression is only evaluated when tracing is on.
+#define MIOPEN_TRACE_SPAN_DETAIL(category, name, ...) \
+    const miopen::trace::Span MIOPEN_PP_CAT(miopen_trace_span_, __LINE__)( \
+        category, name, [&]() -> std::string { return __VA_ARGS__; })
+
+#endif // GUARD_MIOPEN_TRACE_HPP_
@@ -2,6 +2,7 @@
 #define GUARD_MLOPEN_WRITE_FILE_HPP
 
 #include <boost/filesystem.hpp>
+#include <miopen/kernel_source_view.hpp>
 #include <miopen/manage_ptr.hpp>
 #include <fstream>
 
@@ -17,6 +18,13 @@ inline void WriteFile(const std::string& content, const boost::filesystem::path&
         MIOPEN_THROW("Failed to write to file");
 }
 
+inline void WriteFile(const KernelSourceView& content, const boost::filesystem::path& name)
+{
+    FilePtr f{std::fopen(name.string().c_str(), "w")};
+    if(std::fwrite(content.data(), 1, content.size(), f.get()) != content.size())
+        MIOPEN_THROW("Failed to write to file");
+}
+
 inline void WriteFile(const std::vector<char>& content, const boost::filesystem::path& name)
 {
     // std::cerr << "Write file: " << name << std::endl;
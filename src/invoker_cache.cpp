@@ -24,67 +24,92 @@
  *
  *******************************************************************************/
 
+#include <miopen/env.hpp>
 #include <miopen/invoker_cache.hpp>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_INVOKER_CACHE_CAPACITY)
+
 namespace miopen {
 
+InvokerCache::InvokerCache() : invokers(Value(MIOPEN_INVOKER_CACHE_CAPACITY{})) {}
+
 boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
-        return boost::none;
-    const auto& item_invokers = item->second.invokers;
+    const auto item = invokers.Find(key.first);
+    if(item == nullptr)
+        return Count(boost::none);
+    const auto& item_invokers = item->invokers;
     const auto invoker        = item_invokers.find(key.second);
     if(invoker == item_invokers.end())
-        return boost::none;
-    return invoker->second;
+        return Count(boost::none);
+    return Count(invoker->second);
 }
 
-boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
+boost::optional<const Invoker&> InvokerCache::GetFound1_0(const ProblemKey& problem,
                                                           const std::string& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end() || item->second.found_1_0.empty())
-        return boost::none;
-    const auto& item_invokers = item->second.invokers;
-    const auto& found_1_0_ids = item->second.found_1_0;
+    const auto item = invokers.Find(problem);
+    if(item == nullptr || item->found_1_0.empty())
+        return Count(boost::none);
+    const auto& item_invokers = item->invokers;
+    const auto& found_1_0_ids = item->found_1_0;
     const auto found_1_0_id   = found_1_0_ids.find(algorithm);
     if(found_1_0_id == found_1_0_ids.end())
-        return boost::none;
+        return Count(boost::none);
     const auto invoker = item_invokers.find(found_1_0_id->second);
     if(invoker == item_invokers.end())
         MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
-                     " was registered for " + network_config);
-    return invoker->second;
+                     " was registered for " + problem.ToNetworkConfig().ToString());
+    return Count(invoker->second);
 }
 
-void InvokerCache::Register(const Key& key, const Invoker& invoker)
+void InvokerCache::Register(const Key& key, const Invoker& invoker, std::size_t code_object_bytes)
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
-        it->second.invokers.insert({key.second, invoker});
-    auto& item = invokers.insert({key.first, Item{}}).first->second;
-    item.invokers.insert({key.second, invoker});
+    auto& item = invokers.GetOrInsert(key.first);
+    if(item.invokers.insert({key.second, invoker}).second)
+        item.code_object_bytes += code_object_bytes;
 }
 
-void InvokerCache::SetAsFound1_0(const std::string& network_config,
+void InvokerCache::SetAsFound1_0(const ProblemKey& problem,
                                  const std::string& algorithm,
                                  const std::string& solver_id)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-        MIOPEN_THROW("No invoker was registered for " + network_config);
+    const auto item = invokers.Find(problem);
+    if(item == nullptr)
+        MIOPEN_THROW("No invoker was registered for " + problem.ToNetworkConfig().ToString());
 
     {
         // Validating at find time
-        const auto& item_invokers = item->second.invokers;
+        const auto& item_invokers = item->invokers;
         const auto invoker        = item_invokers.find(solver_id);
         if(invoker == item_invokers.end())
             MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
-                         network_config);
+                         problem.ToNetworkConfig().ToString());
     }
 
-    item->second.found_1_0[algorithm] = solver_id;
+    item->found_1_0[algorithm] = solver_id;
+}
+
+CacheStats InvokerCache::GetStats() const
+{
+    // The code objects the invokers keep alive may be held by the kernel cache as well.
+    auto stats = invokers.GetStats([](const ProblemKey&, const Item& item) {
+        auto bytes = sizeof(ProblemKey) + sizeof(Item) + item.code_object_bytes;
+        for(const auto& found : item.found_1_0)
+            bytes += sizeof(found) + found.first.capacity() + found.second.capacity();
+        for(const auto& invoker : item.invokers)
+            bytes += sizeof(invoker) + invoker.first.capacity();
+        return bytes;
+    });
+    stats.hits   = hits;
+    stats.misses = misses;
+    return stats;
+}
+
+boost::optional<const Invoker&> InvokerCache::Count(boost::optional<const Invoker&> invoker) const
+{
+    ++(invoker ? hits : misses);
+    return invoker;
 }
 
 } // namespace miopen
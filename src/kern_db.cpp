@@ -30,7 +30,12 @@ KernDb::KernDb(const std::string& filename_,
                bool is_system,
                const std::string& arch_,
                const std::size_t num_cu_)
-    : KernDb(filename_, is_system, arch_, num_cu_, compress, decompress)
+    : KernDb(filename_,
+             is_system,
+             arch_,
+             num_cu_,
+             [](const std::string& s, bool* compressed) { return compress_blob(s, compressed); },
+             decompress_blob)
 {
 }
 
@@ -65,7 +70,64 @@ KernDb::KernDb(const std::string& filename_,
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
     }
+    content_addressed = !sql.Exec("SELECT name FROM sqlite_master WHERE type = 'table' AND "
+                                  "name = '" +
+                                  KernelConfig::blob_table_name() + "';")
+                             .empty();
+}
+
+KernDb::CompactStats KernDb::Compact()
+{
+    auto stats = CompactStats{};
+    if(dbInvalid || !content_addressed)
+        return stats;
+
+    const auto records = KernelConfig::table_name();
+    const auto blobs   = KernelConfig::blob_table_name();
+
+    InTransaction("BEGIN IMMEDIATE TRANSACTION;", [&]() {
+        sql.Exec("INSERT OR IGNORE INTO " + blobs +
+                 "(kernel_hash, kernel_blob, uncompressed_size, refcount) "
+                 "SELECT kernel_hash, kernel_blob, uncompressed_size, 0 FROM " +
+                 records + " WHERE length(kernel_blob) > 0;");
+        sql.Exec("UPDATE " + records + " SET kernel_blob = X'' WHERE length(kernel_blob) > 0;");
+        stats.moved_blobs = sql.Changes();
+        sql.Exec("UPDATE " + blobs + " SET refcount = (SELECT count(*) FROM " + records +
+                 " WHERE " + records + ".kernel_hash = " + blobs + ".kernel_hash);");
+        // Older versions could leave several records for a kernel, of which only one is found.
+        sql.Exec("DELETE FROM " + records + " WHERE id NOT IN (SELECT max(id) FROM " + records +
+                 " GROUP BY kernel_name, kernel_args);");
+        sql.Exec("DELETE FROM " + blobs + " WHERE refcount <= 0;");
+        stats.dropped_blobs = sql.Changes();
+    });
+    std::lock_guard<std::mutex> lock{*connection_mutex};
+    sql.Exec("VACUUM;");
+
+    auto count = [&](const std::string& table) {
+        auto rows = sql.Exec("SELECT count(*) AS n FROM " + table + ";");
+        return rows.empty() ? 0 : std::stoul(rows.front()["n"]);
+    };
+    stats.records = count(records);
+    stats.blobs   = count(blobs);
+    MIOPEN_LOG_I(filename << ": " << stats.records << " records, " << stats.blobs << " blobs, "
+                          << stats.moved_blobs
+                          << " blobs moved out of the records, "
+                          << stats.dropped_blobs
+                          << " unreferenced blobs dropped");
+    return stats;
+}
+
+std::string KernDb::DecodeRow(const Row& row) const
+{
+    auto decompressed_blob = row.uncompressed_size != 0
+                                 ? decompress_fn(row.blob, row.uncompressed_size)
+                                 : row.blob;
+    auto new_md5 = md5(decompressed_blob);
+    if(new_md5 != row.md5_hash)
+        MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
+    return decompressed_blob;
 }
 
 } // namespace miopen
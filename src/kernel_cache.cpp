@@ -39,6 +39,7 @@
  * limitations under the License.
  * ************************************************************************ */
 
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
@@ -47,6 +48,8 @@
 #include <iostream>
 #include <iterator>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_KERNEL_CACHE_CAPACITY)
+
 namespace miopen {
 
 static std::ostream& operator<<(std::ostream& os, const std::vector<size_t>& v)
@@ -125,23 +128,43 @@ static void ProcessParams(std::string& params)
     }
 }
 
-const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
-                                                   const std::string& network_config)
+/// Kernels of the algorithms without invokers are only built by Find.
+static bool IsBuiltByFindOnly(const std::string& algorithm)
+{
+    return algorithm == "miopenConvolutionFwdAlgoFFT" ||
+           algorithm == "miopenConvolutionBwdDataAlgoFFT" ||
+           algorithm == "miopenConvolutionBwdWeightsAlgoWinograd";
+}
+
+bool KernelCache::IsPinned(const Key& key) const
+{
+    return IsBuiltByFindOnly(key.first) || pinned_kernels.count(key) != 0;
+}
+
+std::vector<Kernel> KernelCache::GetKernels(const std::string& algorithm,
+                                            const std::string& network_config)
 {
 
     std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
 
-    const auto it = kernel_map.find(key);
-    if(it != kernel_map.end())
+    auto kernels      = static_cast<std::vector<Kernel>*>(nullptr);
+    const auto pinned = pinned_kernels.find(key);
+    if(pinned != pinned_kernels.end())
+        kernels = &pinned->second;
+    else
+        kernels = kernel_map.Find(key);
+
+    if(kernels != nullptr)
     {
-        MIOPEN_LOG_I2(it->second.size() << " kernels for key: " << key.first << " \"" << key.second
-                                        << '\"');
-        return it->second;
+        ++hits;
+        MIOPEN_LOG_I2(kernels->size() << " kernels for key: " << key.first << " \"" << key.second
+                                      << '\"');
+        return *kernels;
     }
 
-    static const std::vector<Kernel> empty{};
+    ++misses;
     MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
-    return empty;
+    return {};
 }
 
 bool KernelCache::HasKernels(const std::string& algorithm, const std::string& network_config) const
@@ -150,11 +173,17 @@ bool KernelCache::HasKernels(const std::string& algorithm, const std::string& ne
 #ifndef NDEBUG
     MIOPEN_LOG_I("Key: " << key.first << " \"" << key.second << '\"');
 #endif
-    const auto it = kernel_map.find(key);
-    if(it == kernel_map.end())
+    auto kernels      = static_cast<const std::vector<Kernel>*>(nullptr);
+    const auto pinned = pinned_kernels.find(key);
+    if(pinned != pinned_kernels.end())
+        kernels = &pinned->second;
+    else
+        kernels = kernel_map.Peek(key);
+
+    if(kernels == nullptr)
         return false;
 
-    if(it->second.empty())
+    if(kernels->empty())
     {
         MIOPEN_THROW("There should be at least one kernel in kernel cache if an entry exists");
     }
@@ -162,16 +191,17 @@ bool KernelCache::HasKernels(const std::string& algorithm, const std::string& ne
     return true;
 }
 
-bool KernelCache::HasProgram(const std::string& name, const std::string& params) const
+bool KernelCache::HasProgram(const std::string& name, std::string params) const
 {
+    ProcessParams(params);
     const auto key = std::make_pair(name, params);
-    return program_map.count(key) > 0;
+    return program_map.Peek(key) != nullptr;
 }
 
 void KernelCache::AddProgram(Program prog, const std::string& program_name, std::string params)
 {
     ProcessParams(params);
-    program_map[std::make_pair(program_name, params)] = prog;
+    program_map.GetOrInsert(std::make_pair(program_name, params)) = prog;
 }
 
 Kernel KernelCache::AddKernel(const Handle& h,
@@ -194,13 +224,15 @@ Kernel KernelCache::AddKernel(const Handle& h,
 
     Program program;
 
-    auto program_it = program_map.find(std::make_pair(program_name, params));
-    if(program_it != program_map.end())
+    const auto cached_program = program_map.Find(std::make_pair(program_name, params));
+    if(cached_program != nullptr)
     {
-        program = program_it->second;
+        ++hits;
+        program = *cached_program;
     }
     else
     {
+        ++misses;
         if(!is_kernel_miopengemm_str) // default value
             is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
                                        algorithm.find("GEMM") != std::string::npos;
@@ -216,7 +248,7 @@ Kernel KernelCache::AddKernel(const Handle& h,
                                       params);
         }
         program = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
-        program_map[std::make_pair(program_name, params)] = program;
+        program_map.GetOrInsert(std::make_pair(program_name, params)) = program;
     }
     Kernel kernel{program, kernel_name, vld, vgd};
     if(!network_config.empty() && !algorithm.empty())
@@ -228,7 +260,7 @@ Kernel KernelCache::AddKernel(const Handle& h,
 
 void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
 {
-    auto&& v = kernel_map[key];
+    auto&& v = IsPinned(key) ? pinned_kernels[key] : kernel_map.GetOrInsert(key);
     if(cache_index >= v.size())
     {
         v.resize(cache_index + 1);
@@ -243,7 +275,7 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
         MIOPEN_THROW("Network config or algorithm empty.");
     }
     const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-    auto&& v = this->kernel_map[key];
+    auto&& v = IsPinned(key) ? pinned_kernels[key] : kernel_map.GetOrInsert(key);
     if(!v.empty())
     {
         MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.first << " \"" << key.second << '\"');
@@ -251,6 +283,71 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
     v.clear();
 }
 
-KernelCache::KernelCache() {}
+void KernelCache::PinKernels(const std::string& algorithm, const std::string& network_config)
+{
+    const auto key     = std::make_pair(algorithm, network_config);
+    const auto kernels = kernel_map.Peek(key);
+    if(kernels == nullptr)
+        return;
+    pinned_kernels[key] = *kernels;
+    kernel_map.Erase(key);
+}
+
+static std::size_t GetCodeObjectSize(const Program& program)
+{
+#if MIOPEN_BACKEND_OPENCL
+    // Programs are built for the single device of the handle.
+    std::size_t size = 0;
+    if(program == nullptr ||
+       clGetProgramInfo(
+           program.get(), CL_PROGRAM_BINARY_SIZES, sizeof(size), &size, nullptr) != CL_SUCCESS)
+        return 0;
+    return size;
+#else
+    return program.GetCodeObjectSize();
+#endif
+}
+
+std::size_t KernelCache::GetCodeObjectSize(const std::string& program_name,
+                                           std::string params) const
+{
+    ProcessParams(params);
+    const auto program = program_map.Peek(std::make_pair(program_name, params));
+    return program == nullptr ? 0 : miopen::GetCodeObjectSize(*program);
+}
+
+void KernelCache::SetCapacity(std::size_t capacity)
+{
+    kernel_map.SetCapacity(capacity);
+    program_map.SetCapacity(capacity);
+}
+
+CacheStats KernelCache::GetStats() const
+{
+    // Kernels share the code objects of their programs, only the programs account for them.
+    auto stats = program_map.GetStats([](const Key& key, const Program& program) {
+        return sizeof(key) + key.first.capacity() + key.second.capacity() +
+               miopen::GetCodeObjectSize(program);
+    });
+    const auto kernels_bytes = [](const Key& key, const std::vector<Kernel>& v) {
+        return sizeof(key) + key.first.capacity() + key.second.capacity() +
+               v.capacity() * sizeof(Kernel);
+    };
+    const auto kernels = kernel_map.GetStats(kernels_bytes);
+    stats.entries += kernels.entries + pinned_kernels.size();
+    stats.evictions += kernels.evictions;
+    stats.bytes += kernels.bytes;
+    for(const auto& pinned : pinned_kernels)
+        stats.bytes += kernels_bytes(pinned.first, pinned.second);
+    stats.hits   = hits;
+    stats.misses = misses;
+    return stats;
+}
+
+KernelCache::KernelCache()
+    : kernel_map(Value(MIOPEN_KERNEL_CACHE_CAPACITY{})),
+      program_map(Value(MIOPEN_KERNEL_CACHE_CAPACITY{}))
+{
+}
 
 } // namespace miopen
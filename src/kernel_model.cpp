@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/kernel_model.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+std::size_t DivideCeil(std::size_t x, std::size_t y) { return (x + y - 1) / y; }
+
+/// Waves per SIMD that keep the ALUs busy while others wait for memory.
+const float latency_hiding_waves = 2.0f;
+/// Reuse for which the LDS bandwidth limits the throughput by half.
+const float half_throughput_reuse = 16.0f;
+/// Registers for addresses, indices and loop counters.
+const std::size_t base_vgprs = 32;
+
+} // namespace
+
+std::size_t GetWorkgroupsPerCu(const KernelModel& kernel, const DeviceModel& device)
+{
+    if(kernel.block_size == 0 || kernel.lds_bytes > device.lds_bytes)
+        return 0;
+
+    const auto waves_per_block = DivideCeil(kernel.block_size, device.wave_size);
+    if(waves_per_block > device.max_waves * device.simds_per_cu)
+        return 0;
+
+    // Registers are allocated in groups of 4.
+    auto vgprs = device.has_acc_vgprs ? std::max(kernel.vgprs, kernel.acc_vgprs)
+                                      : kernel.vgprs + kernel.acc_vgprs;
+    vgprs = DivideCeil(std::max<std::size_t>(vgprs, 1), 4) * 4;
+    if(vgprs > device.vgprs)
+        return 0;
+    const auto waves_per_simd = std::min(device.max_waves, device.vgprs / vgprs);
+
+    auto workgroups = std::min(device.max_workgroups,
+                               waves_per_simd * device.simds_per_cu / waves_per_block);
+    if(kernel.lds_bytes != 0)
+        workgroups = std::min(workgroups, device.lds_bytes / kernel.lds_bytes);
+    return workgroups;
+}
+
+float GetKernelScore(const KernelModel& kernel, const DeviceModel& device)
+{
+    const auto workgroups_per_cu = GetWorkgroupsPerCu(kernel, device);
+    if(workgroups_per_cu == 0 || kernel.grid_size == 0 || device.compute_units == 0)
+        return 0.0f;
+
+    // The busiest compute unit determines the time; the others idle for the rest of it.
+    const auto per_cu = DivideCeil(kernel.grid_size, device.compute_units);
+    const auto utilization =
+        static_cast<float>(kernel.grid_size) / (per_cu * device.compute_units);
+
+    const auto resident = std::min(static_cast<float>(workgroups_per_cu),
+                                   static_cast<float>(kernel.grid_size) / device.compute_units);
+    const auto waves_per_simd =
+        resident * DivideCeil(kernel.block_size, device.wave_size) / device.simds_per_cu;
+    const auto latency = std::min(1.0f, waves_per_simd / latency_hiding_waves);
+
+    const auto reuse = kernel.reuse / (kernel.reuse + half_throughput_reuse);
+
+    return utilization * latency * kernel.tile_efficiency * reuse;
+}
+
+std::vector<std::size_t> RankKernels(const std::vector<KernelModel>& kernels,
+                                     const DeviceModel& device,
+                                     std::size_t top_k)
+{
+    auto scores = std::vector<float>(kernels.size());
+    std::transform(kernels.begin(), kernels.end(), scores.begin(), [&](const KernelModel& k) {
+        return GetKernelScore(k, device);
+    });
+
+    auto ranked = std::vector<std::size_t>{};
+    for(std::size_t i = 0; i < kernels.size(); ++i)
+    {
+        if(scores[i] > 0.0f)
+            ranked.push_back(i);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [&](std::size_t left, std::size_t right) {
+        return scores[left] > scores[right];
+    });
+    if(top_k != 0 && ranked.size() > top_k)
+        ranked.resize(top_k);
+    return ranked;
+}
+
+KernelModel GetBlockwiseGemmModel(std::size_t gemm_m,
+                                  std::size_t gemm_n,
+                                  std::size_t m_per_block,
+                                  std::size_t n_per_block,
+                                  std::size_t k_per_block,
+                                  std::size_t block_size,
+                                  std::size_t grid_size,
+                                  std::size_t lds_bytes,
+                                  std::size_t data_size)
+{
+    auto kernel       = KernelModel{};
+    kernel.block_size = block_size;
+    kernel.grid_size  = grid_size;
+    kernel.lds_bytes  = lds_bytes;
+    if(block_size == 0 || m_per_block == 0 || n_per_block == 0)
+        return kernel;
+
+    const auto padded_m    = DivideCeil(gemm_m, m_per_block) * m_per_block;
+    const auto padded_n    = DivideCeil(gemm_n, n_per_block) * n_per_block;
+    kernel.tile_efficiency = static_cast<float>(gemm_m * gemm_n) / (padded_m * padded_n);
+
+    // Each element of the A and B tiles takes part in n_per_block and m_per_block
+    // multiply-adds respectively.
+    kernel.reuse = 2.0f * m_per_block * n_per_block / (m_per_block + n_per_block);
+
+    // The blockwise copy stages the next A and B tiles in registers on their way to LDS.
+    const auto copy_bytes = k_per_block * (m_per_block + n_per_block) * data_size;
+    kernel.vgprs          = base_vgprs + DivideCeil(copy_bytes, block_size * 4);
+    return kernel;
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,217 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/lz4.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace miopen {
+namespace {
+
+constexpr std::size_t min_match     = 4;
+constexpr std::size_t max_offset    = 65535;
+// The format requires the last match to start at least 12 bytes before the end of the input
+// and the last 5 bytes to be literals.
+constexpr std::size_t match_limit   = 12;
+constexpr std::size_t last_literals = 5;
+constexpr int hash_log              = 12;
+
+std::uint32_t Read32(const unsigned char* p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::uint32_t Hash(std::uint32_t v) { return (v * 2654435761U) >> (32 - hash_log); }
+
+void WriteLength(std::string& out, std::size_t len)
+{
+    for(; len >= 255; len -= 255)
+        out.push_back(static_cast<char>(255));
+    out.push_back(static_cast<char>(len));
+}
+
+void WriteSequence(std::string& out,
+                   const unsigned char* literals,
+                   std::size_t literal_count,
+                   std::size_t offset,
+                   std::size_t match_length)
+{
+    const auto match_code = match_length - min_match;
+    const auto token      = (std::min<std::size_t>(literal_count, 15) << 4) |
+                       std::min<std::size_t>(match_code, 15);
+    out.push_back(static_cast<char>(token));
+    if(literal_count >= 15)
+        WriteLength(out, literal_count - 15);
+    out.append(reinterpret_cast<const char*>(literals), literal_count);
+    out.push_back(static_cast<char>(offset & 0xff));
+    out.push_back(static_cast<char>(offset >> 8));
+    if(match_code >= 15)
+        WriteLength(out, match_code - 15);
+}
+
+void WriteLastLiterals(std::string& out, const unsigned char* literals, std::size_t literal_count)
+{
+    out.push_back(static_cast<char>(std::min<std::size_t>(literal_count, 15) << 4));
+    if(literal_count >= 15)
+        WriteLength(out, literal_count - 15);
+    out.append(reinterpret_cast<const char*>(literals), literal_count);
+}
+
+std::size_t ReadLength(const std::string& s, std::size_t& ip, std::size_t len)
+{
+    unsigned char b;
+    do
+    {
+        if(ip >= s.size())
+            throw std::runtime_error("lz4_decompress failed: the compressed data ends unexpectedly");
+        b = static_cast<unsigned char>(s[ip++]);
+        len += b;
+    } while(b == 255);
+    return len;
+}
+
+} // namespace
+
+std::string lz4_compress(const std::string& s, bool* compressed)
+{
+    if(s.empty())
+        throw std::runtime_error("lz4_compress failed: nothing to compress");
+
+    const auto* const src = reinterpret_cast<const unsigned char*>(s.data());
+    const auto n          = s.size();
+    auto result           = std::string{};
+    result.reserve(n + n / 255 + 16);
+
+    auto anchor = std::size_t{0};
+    if(n > match_limit)
+    {
+        auto table = std::vector<std::uint32_t>(std::size_t{1} << hash_log, 0);
+        auto i     = std::size_t{1};
+        while(i < n - match_limit)
+        {
+            const auto h   = Hash(Read32(src + i));
+            auto ref       = std::size_t{table[h]};
+            table[h]       = static_cast<std::uint32_t>(i);
+            const auto hit = ref < i && i - ref <= max_offset && Read32(src + ref) == Read32(src + i);
+            if(!hit)
+            {
+                // Skip faster over data that does not compress.
+                i += 1 + ((i - anchor) >> 6);
+                continue;
+            }
+
+            while(i > anchor && ref > 0 && src[i - 1] == src[ref - 1])
+            {
+                --i;
+                --ref;
+            }
+            auto len = min_match;
+            while(i + len < n - last_literals && src[i + len] == src[ref + len])
+                ++len;
+
+            WriteSequence(result, src + anchor, i - anchor, i - ref, len);
+            i += len;
+            anchor = i;
+        }
+    }
+    WriteLastLiterals(result, src + anchor, n - anchor);
+
+    if(compressed != nullptr)
+    {
+        *compressed = result.size() < n;
+        if(!*compressed)
+            return s;
+    }
+    return result;
+}
+
+std::string lz4_decompress(const std::string& s, unsigned int size)
+{
+    if(s.empty())
+        throw std::runtime_error("lz4_decompress failed: nothing to decompress");
+
+    auto result = std::string(size, 0);
+    auto ip     = std::size_t{0};
+    auto op     = std::size_t{0};
+    const auto overflow =
+        "lz4_decompress failed: the size of the decompressed data exceeds the given size";
+
+    for(;;)
+    {
+        if(ip >= s.size())
+            throw std::runtime_error("lz4_decompress failed: the compressed data ends unexpectedly");
+        const auto token = static_cast<unsigned char>(s[ip++]);
+
+        auto literal_count = static_cast<std::size_t>(token >> 4u);
+        if(literal_count == 15)
+            literal_count = ReadLength(s, ip, literal_count);
+        if(literal_count > s.size() - ip)
+            throw std::runtime_error("lz4_decompress failed: the compressed data ends unexpectedly");
+        if(literal_count > size - op)
+            throw std::runtime_error(overflow);
+        std::memcpy(&result[op], &s[ip], literal_count);
+        ip += literal_count;
+        op += literal_count;
+
+        if(ip == s.size())
+            break;
+
+        if(s.size() - ip < 2)
+            throw std::runtime_error("lz4_decompress failed: the compressed data ends unexpectedly");
+        const auto offset = static_cast<std::size_t>(static_cast<unsigned char>(s[ip])) |
+                            static_cast<std::size_t>(static_cast<unsigned char>(s[ip + 1])) << 8u;
+        ip += 2;
+        if(offset == 0 || offset > op)
+            throw std::runtime_error("lz4_decompress failed: a data integrity error was detected "
+                                     "in the compressed data");
+
+        auto len = static_cast<std::size_t>(token & 15u);
+        if(len == 15)
+            len = ReadLength(s, ip, len);
+        len += min_match;
+        if(len > size - op)
+            throw std::runtime_error(overflow);
+
+        auto* const dst = &result[op];
+        if(offset >= len)
+            std::memcpy(dst, dst - offset, len);
+        else
+            // Overlapping matches repeat the last offset bytes.
+            for(auto i = std::size_t{0}; i < len; ++i)
+                dst[i] = dst[i - offset];
+        op += len;
+    }
+
+    result.resize(op);
+    return result;
+}
+
+} // namespace miopen
@@ -41,18 +41,10 @@
 #include <array>
 #include <cstring>
 #include <cstdint>
-#include <sstream>
-#include <iomanip>
 
 #define MD5_DIGEST_LENGTH 16
 
-struct MD5_CTX
-{
-    uint32_t lo, hi;
-    uint32_t a, b, c, d;
-    unsigned char buffer[64];
-    uint32_t block[MD5_DIGEST_LENGTH];
-};
+using MD5_CTX = miopen::Md5Hasher::Context;
 
 /*
  * The basic MD5 functions.
@@ -300,20 +292,29 @@ static void MD5_Final(unsigned char* result, MD5_CTX* ctx)
 
 namespace miopen {
 
-std::string md5(std::string s)
+Md5Hasher::Md5Hasher() : ctx{} { MD5_Init(&ctx); }
+
+Md5Hasher& Md5Hasher::Update(const void* data, std::size_t size)
 {
-    std::array<unsigned char, MD5_DIGEST_LENGTH> result{};
+    MD5_Update(&ctx, data, size);
+    return *this;
+}
 
-    MD5_CTX ctx{};
-    MD5_Init(&ctx);
-    MD5_Update(&ctx, s.data(), s.length());
+std::string Md5Hasher::HexDigest()
+{
+    std::array<unsigned char, MD5_DIGEST_LENGTH> result{};
     MD5_Final(result.data(), &ctx);
+    MD5_Init(&ctx);
 
-    std::ostringstream sout;
-    sout << std::hex << std::setfill('0');
-    for(auto c : result)
-        sout << std::setw(2) << int{c};
-
-    return sout.str();
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(result.size() * 2, '0');
+    for(std::size_t i = 0; i < result.size(); ++i)
+    {
+        hex[2 * i]     = digits[result[i] >> 4];
+        hex[2 * i + 1] = digits[result[i] & 0xf];
+    }
+    return hex;
 }
+
+std::string md5(const std::string& s) { return Md5Hasher{}.Update(s).HexDigest(); }
 } // namespace miopen
@@ -31,6 +31,7 @@
 #include <miopen/db.hpp>
 #include <miopen/env.hpp>
 #include <miopen/gcn_asm_utils.hpp>
+#include <miopen/generic_search.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/mlo_utils.hpp>
 #include <miopen/solver.hpp>
@@ -44,6 +45,7 @@
 #include <cmath>
 #include <cstring>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <unordered_map>
@@ -91,6 +93,31 @@ miopen::PerformanceDb miopen::GetDb(const ConvolutionContext& ctx)
     return {ctx.GetPerfDbPath(), ctx.GetUserPerfDbPath()};
 }
 #endif
+
+std::vector<std::string> miopen::solver::GetTunedValues(const miopen::ConvolutionContext& ctx,
+                                                        const std::string& solver_id)
+{
+    return miopen::GetDb(ctx).FindValues(solver_id);
+}
+
+miopen::solver::SearchCheckpointDb
+miopen::solver::GetSearchCheckpointDb(const miopen::ConvolutionContext& ctx,
+                                      const std::string& solver_id)
+{
+    std::ostringstream key;
+    ctx.Serialize(key);
+    return {GetSearchCheckpointPath(ctx.GetStream().GetDbBasename()), key.str(), solver_id};
+}
+
+miopen::solver::DeviceModel miopen::solver::GetDeviceModel(const miopen::ConvolutionContext& ctx)
+{
+    auto device          = DeviceModel{};
+    device.compute_units = ctx.GetStream().GetMaxComputeUnits();
+    device.lds_bytes     = ctx.GetStream().GetLocalMemorySize();
+    device.has_acc_vgprs = miopen::StartsWith(ctx.GetStream().GetDeviceName(), "gfx908");
+    return device;
+}
+
 miopen::solver::ConvSolution
 mlo_construct_direct2D_fusion::FindSolution(const std::vector<miopen::solver::AnySolver>& solvers)
 {
@@ -256,6 +283,37 @@ FindAllBwdWrW2DSolutions(const miopen::ConvolutionContext& ctx)
     return GetBwdWrW2DSolvers().SearchForAllSolutions(ctx, GetDb(ctx));
 }
 
+std::vector<miopen::solver::Id> FindAllApplicableSolvers(const miopen::ConvolutionContext& ctx)
+{
+    auto ids          = std::vector<miopen::solver::Id>{};
+    const auto append = [&](std::vector<miopen::solver::Id>&& more) {
+        ids.insert(ids.end(), more.begin(), more.end());
+    };
+
+#if WORKAROUND_SWDEV_227826
+    const auto implicit_gemm_limit =
+        miopen::IsEnabled(MIOPEN_DEBUG_IMPLICIT_GEMM_FIND_ALL_SOLUTIONS{})
+            ? std::numeric_limits<std::size_t>::max()
+            : 1;
+#else
+    const auto implicit_gemm_limit = std::numeric_limits<std::size_t>::max();
+#endif
+
+    if(ctx.direction.IsBackwardWrW())
+    {
+        append(GetBwdWrW2DSolvers().GetApplicableIds(ctx));
+        append(GetWindogradWrWSolvers().GetApplicableIds(ctx));
+        append(GetImplicitGemmWrWSolvers().GetApplicableIds(ctx, implicit_gemm_limit));
+    }
+    else
+    {
+        append(GetDirectSolvers().GetApplicableIds(ctx));
+        append(GetWindogradSolvers().GetApplicableIds(ctx));
+        append(GetImplicitGemmSolvers().GetApplicableIds(ctx, implicit_gemm_limit));
+    }
+    return ids;
+}
+
 void miopen::ConvolutionContext::SetupFloats()
 {
     if(IsFp32() || IsFp16() || IsBfp16())
@@ -120,7 +120,8 @@ static void BuildProgram(cl_program program, cl_device_id device, const std::str
     }
 }
 
-ClProgramPtr LoadBinaryProgram(cl_context ctx, cl_device_id device, const std::string& source)
+ClProgramPtr
+LoadBinaryProgram(cl_context ctx, cl_device_id device, const KernelSourceView& source)
 {
     ClProgramPtr result{CreateProgramWithBinary(ctx, device, source.data(), source.size())};
     BuildProgram(result.get(), device);
@@ -135,7 +136,9 @@ ClProgramPtr LoadProgram(cl_context ctx,
                          const std::string& kernel_src)
 {
     bool is_binary = false;
-    std::string source;
+    // Embedded sources are used in place, only the assembled ones need storage of their own.
+    KernelSourceView source;
+    std::string assembled;
     if(is_kernel_str)
     {
         source = program_name;
@@ -143,13 +146,14 @@ ClProgramPtr LoadProgram(cl_context ctx,
     else
     {
         if(kernel_src.empty())
-            source = miopen::GetKernelSrc(program_name);
+            source = miopen::GetKernelSrcView(program_name);
         else
             source  = kernel_src;
         auto is_asm = miopen::EndsWith(program_name, ".s");
         if(is_asm)
         {
-            source    = ClAssemble(device, source, params);
+            assembled = ClAssemble(device, source.str(), params);
+            source    = assembled;
             is_binary = true;
         }
         else
@@ -173,7 +177,7 @@ ClProgramPtr LoadProgram(cl_context ctx,
         params += HipKernelWarningsString();
 #endif
 #endif
-        auto hsaco_file = HipBuild(dir, program_name, source, params, device_name);
+        auto hsaco_file = HipBuild(dir, program_name, source.str(), params, device_name);
         // load the hsaco file as a data stream and then load the binary
         std::string buf;
         bin_file_to_str(hsaco_file, buf);
@@ -38,6 +38,8 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/invoker.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solution_ranker.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
@@ -55,6 +57,7 @@
 #endif
 
 #include <cassert>
+#include <sstream>
 #include <type_traits>
 
 #include <boost/range/adaptors.hpp>
@@ -68,6 +71,7 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_FFT)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_RANKING)
 
 #if MIOPEN_USE_GEMM
 #ifdef CPPCHECK
@@ -248,13 +252,14 @@ template <class InvokeParams>
 static void EvaluateInvokers(Handle& handle,
                              const std::vector<solver::ConvSolution>& solutions,
                              const AlgorithmName& algorithm_name,
-                             const NetworkConfig& network_config,
+                             const ProblemKey& problem_key,
                              const InvokeParams& invoke_ctx,
                              DbRecord& record)
 {
     miopen::solver::ConvSolution selected{miopenStatusUnknownError};
     float best = std::numeric_limits<float>::max();
     Invoker best_invoker;
+    std::size_t best_invoker_size = 0;
 
     for(const auto& sol : solutions)
     {
@@ -283,22 +288,26 @@ static void EvaluateInvokers(Handle& handle,
         if(!sol.invoker_factory)
             MIOPEN_THROW("Invoker is not provided by solver " + sol.solver_id);
 
-        const auto invoker = handle.PrepareInvoker(*sol.invoker_factory, sol.construction_params);
+        auto code_object_bytes = std::size_t{0};
+        const auto invoker     = handle.PrepareInvoker(
+            *sol.invoker_factory, sol.construction_params, &code_object_bytes);
         invoker(handle, invoke_ctx);
         const auto elapsed = handle.GetKernelTime();
 
         MIOPEN_LOG_I(sol << ": " << elapsed << (elapsed < best ? " < " : " >= ") << best);
         if(elapsed < best)
         {
-            best         = elapsed;
-            selected     = sol;
-            best_invoker = invoker;
+            best              = elapsed;
+            selected          = sol;
+            best_invoker      = invoker;
+            best_invoker_size = code_object_bytes;
         }
     }
 
     if(selected.Succeeded())
     {
-        handle.RegisterInvoker(best_invoker, network_config, selected.solver_id, algorithm_name);
+        handle.RegisterInvoker(
+            best_invoker, problem_key, selected.solver_id, algorithm_name, best_invoker_size);
         MIOPEN_LOG_I(
             "Selected: " << selected << ": " << best << ", workspce_sz = " << selected.workspce_sz);
         record.SetValues(algorithm_name,
@@ -649,7 +658,8 @@ static void DirConvFindCore(Handle& handle,
     }
 #endif
 
-    const auto network_config = ctx.BuildConfKey();
+    const auto problem_key    = ctx.MakeKey();
+    const auto network_config = problem_key.ToNetworkConfig();
     const auto invoke_ctx =
         conv::DataInvokeParams{{xDesc, x, wDesc, w, yDesc, y}, workSpace, workSpaceSize};
 
@@ -658,7 +668,7 @@ static void DirConvFindCore(Handle& handle,
         const auto all = conv.FindWinogradSolutions(ctx);
         PrecompileSolutions(handle, all);
         const auto algorithm_name = AlgorithmName{"miopenConvolutionFwdAlgoWinograd"};
-        EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+        EvaluateInvokers(handle, all, algorithm_name, problem_key, invoke_ctx, record);
     }
 
     // Direct algo
@@ -670,7 +680,7 @@ static void DirConvFindCore(Handle& handle,
             conv.FindDataDirectSolutions(handle, xDesc, wDesc, yDesc, exhaustiveSearch, true, bufs);
         PrecompileSolutions(handle, all);
         const auto algorithm_name = AlgorithmName{"miopenConvolutionFwdAlgoDirect"};
-        EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+        EvaluateInvokers(handle, all, algorithm_name, problem_key, invoke_ctx, record);
     }
 
     // Implicit GEMM algo
@@ -682,7 +692,7 @@ static void DirConvFindCore(Handle& handle,
             handle, xDesc, wDesc, yDesc, exhaustiveSearch, true, bufs);
         PrecompileSolutions(handle, all);
         const auto algorithm_name = AlgorithmName{"miopenConvolutionFwdAlgoImplicitGEMM"};
-        EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+        EvaluateInvokers(handle, all, algorithm_name, problem_key, invoke_ctx, record);
     }
 
     // FFT algo
@@ -882,6 +892,39 @@ static void ConvForwardCheckNumerics(const Handle& handle,
     miopen::checkNumericsOutput(handle, tensors.yDesc, tensors.y);
 }
 
+static Invoker PrepareInvoker(Handle& handle,
+                              ConvolutionContext& ctx,
+                              const ProblemKey& problem_key,
+                              solver::Id solver_id,
+                              conv::Direction dir);
+
+/// The invoker found for the algorithm may have been evicted from the invoker cache since find.
+/// Prepares it again for the solver that find has stored to the user find-db, if any.
+static boost::optional<const Invoker&> RestoreFoundInvoker(Handle& handle,
+                                                           ConvolutionContext& ctx,
+                                                           const ProblemKey& problem_key,
+                                                           const AlgorithmName& algorithm_name,
+                                                           conv::Direction dir)
+{
+    if(!CheckInvokerSupport(algorithm_name))
+        return boost::none;
+
+    const UserFindDbRecord record{handle, ctx};
+    if(record.empty())
+        return boost::none;
+
+    for(const auto& pair : record)
+    {
+        if(pair.first != algorithm_name.ToString())
+            continue;
+        MIOPEN_LOG_I2("Restoring invoker of " << pair.first << ": " << pair.second.solver_id);
+        PrepareInvoker(handle, ctx, problem_key, solver::Id{pair.second.solver_id}, dir);
+        return handle.GetInvoker(problem_key, boost::none, algorithm_name);
+    }
+
+    return boost::none;
+}
+
 void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
                                                const void* alpha,
                                                const TensorDescriptor& xDesc,
@@ -915,8 +958,11 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
         auto ctx =
             ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward}; // forward
         ctx.SetStream(&handle);
-        const auto network_config = ctx.BuildConfKey();
-        const auto& invoker       = handle.GetInvoker(network_config, boost::none, algorithm_name);
+        const auto problem_key = ctx.MakeKey();
+        auto invoker           = handle.GetInvoker(problem_key, boost::none, algorithm_name);
+        if(!invoker)
+            invoker = RestoreFoundInvoker(
+                handle, ctx, problem_key, algorithm_name, conv::Direction::Forward);
 
         if(invoker)
         {
@@ -925,6 +971,8 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
             return;
         }
 
+        const auto network_config = problem_key.ToNetworkConfig();
+
         switch(algo)
         {
         case miopenConvolutionFwdAlgoDirect:
@@ -1403,7 +1451,140 @@ void ConvolutionDescriptor::ConvFwdFFT(const Handle& handle,
     }
 }
 
-std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(const TensorDescriptor& wDesc,
+static inline bool IsAlgorithmDisabled(const miopenConvAlgorithm_t algo)
+{
+    switch(algo)
+    { // clang-format off
+    case miopenConvolutionAlgoGEMM:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) || !MIOPEN_USE_GEMM;
+    case miopenConvolutionAlgoDirect:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{});
+    case miopenConvolutionAlgoFFT:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_FFT{});
+    case miopenConvolutionAlgoWinograd:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_WINOGRAD{});
+    case miopenConvolutionAlgoImplicitGEMM:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM{});
+    default: // Disable future algos by default to enforce explicit handling:
+        return true;
+    } // clang-format on
+}
+
+static ConvolutionContext MakeFallbackContext(Handle& handle, const ProblemDescription& problem)
+{
+    auto ctx = ConvolutionContext{problem};
+    ctx.SetStream(&handle);
+    ctx.DetectRocm();
+    ctx.SetupFloats();
+    return ctx;
+}
+
+/// Solvers which can run without a find-db record, i.e. GEMM and the solvers which support
+/// invokers, unranked and without workspace sizes, so counting them stays cheap.
+/// Returns none if the fallback is disabled.
+static std::vector<std::string>
+GetFallbackCandidates(const ConvolutionContext& ctx,
+                      const conv::Direction dir,
+                      const std::function<int(const std::string&)>& algoResolver,
+                      const bool gemm_applicable)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+    {
+        MIOPEN_LOG_I("Fallback path disabled");
+        return {};
+    }
+
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_RANKING{}))
+    {
+        if(!gemm_applicable)
+        {
+            MIOPEN_LOG_I("Fallback path, GEMM disabled");
+            return {};
+        }
+        MIOPEN_LOG_I("Fallback path, GEMM");
+        return {solver::Id::gemm().ToString()};
+    }
+
+    auto candidates = std::vector<std::string>{};
+    if(gemm_applicable)
+        candidates.push_back(solver::Id::gemm().ToString());
+    for(const auto& solver_id : FindAllApplicableSolvers(ctx))
+    {
+        const auto algo = solver_id.GetAlgo(dir);
+        // Other solvers need the kernels recorded in the find-db to run.
+        if(!CheckInvokerSupport(algo))
+            continue;
+        if(IsAlgorithmDisabled(static_cast<miopenConvAlgorithm_t>(algoResolver(algo))))
+            continue;
+        candidates.push_back(solver_id.ToString());
+    }
+    return candidates;
+}
+
+static std::size_t
+GetFallbackSolutionCount(Handle& handle,
+                         const ProblemDescription& problem,
+                         const conv::Direction dir,
+                         const std::function<int(const std::string&)>& algoResolver,
+                         const bool gemm_applicable)
+{
+    const auto ctx = MakeFallbackContext(handle, problem);
+    return GetFallbackCandidates(ctx, dir, algoResolver, gemm_applicable).size();
+}
+
+/// Up to maxSolutionCount of the fallback candidates. Their times are estimated by
+/// SolutionRanker from the nearest problems in the find-db, and the fastest come first.
+/// Workspace sizes are only computed for the solutions returned.
+/// gemm_workspace is empty when GEMM is not applicable.
+static std::vector<miopenConvSolution_t>
+GetFallbackSolutions(Handle& handle,
+                     const ProblemDescription& problem,
+                     const conv::Direction dir,
+                     const std::function<int(const std::string&)>& algoResolver,
+                     const std::function<std::size_t()>& gemm_workspace,
+                     const std::size_t maxSolutionCount)
+{
+    const auto ctx = MakeFallbackContext(handle, problem);
+    const auto candidates =
+        GetFallbackCandidates(ctx, dir, algoResolver, static_cast<bool>(gemm_workspace));
+    if(candidates.empty())
+        return {};
+
+    auto ranked = std::vector<RankedSolution>{};
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_RANKING{}))
+    {
+        for(const auto& candidate : candidates)
+            ranked.push_back({candidate, -1.0f});
+    }
+    else
+    {
+        std::ostringstream key;
+        problem.Serialize(key);
+        ranked = FindDbRecord::GetRanker(handle).Rank(key.str(), candidates);
+    }
+
+    auto solutions = std::vector<miopenConvSolution_t>{};
+    solutions.reserve(std::min(ranked.size(), maxSolutionCount));
+    for(const auto& entry : ranked)
+    {
+        if(solutions.size() >= maxSolutionCount)
+            break;
+        const auto solver_id = solver::Id{entry.solver};
+        const auto workspace = solver_id == solver::Id::gemm()
+                                   ? gemm_workspace()
+                                   : solver_id.GetSolver().GetWorkspaceSize(ctx);
+        const auto algo = solver_id == solver::Id::gemm()
+                              ? miopenConvolutionAlgoGEMM
+                              : static_cast<miopenConvAlgorithm_t>(
+                                    algoResolver(solver_id.GetAlgo(dir)));
+        MIOPEN_LOG_I2("Fallback path, " << entry.solver << ": " << entry.time << " ms");
+        solutions.push_back({entry.time, workspace, solver_id.Value(), algo});
+    }
+    return solutions;
+}
+
+std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& wDesc,
                                                                const TensorDescriptor& xDesc,
                                                                const TensorDescriptor& yDesc) const
 {
@@ -1411,13 +1592,14 @@ std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(const TensorDescr
     // Regular (find-db) path have been verified during Find().
     ValidateGroupCount(xDesc, wDesc, *this);
 
-    if(IsGemmApplicableFwd(wDesc, xDesc, yDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
-    {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
-    }
-    MIOPEN_LOG_I("Fallback path, GEMM disabled");
+    const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+    const auto count   = GetFallbackSolutionCount(handle,
+                                                problem,
+                                                conv::Direction::Forward,
+                                                StringToConvolutionFwdAlgo,
+                                                IsGemmApplicableFwd(wDesc, xDesc, yDesc));
+    if(count > 0)
+        return count;
     /// When count=0 the reason could be:
     /// * (1) Convolution is not implemented in the library at all, so Find() would fail as
     ///   well. This is case when rc = miopenStatusNotImplemented is correct.
@@ -1433,19 +1615,22 @@ std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(const TensorDescr
                  "Requested convolution is not supported or immedate mode fallback has failed.");
 }
 
-std::size_t ConvolutionDescriptor::GetBwdSolutionCountFallback(const TensorDescriptor& dyDesc,
+std::size_t ConvolutionDescriptor::GetBwdSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& dyDesc,
                                                                const TensorDescriptor& wDesc,
                                                                const TensorDescriptor& dxDesc) const
 {
     ValidateGroupCount(dxDesc, wDesc, *this); // See comment in Forward method.
 
-    if(IsGemmApplicableBwd(dyDesc, wDesc, dxDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
-    {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
-    }
-    MIOPEN_LOG_I("Fallback path, GEMM disabled");
+    const auto problem =
+        ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+    const auto count = GetFallbackSolutionCount(handle,
+                                                problem,
+                                                conv::Direction::BackwardData,
+                                                StringToConvolutionBwdDataAlgo,
+                                                IsGemmApplicableBwd(dyDesc, wDesc, dxDesc));
+    if(count > 0)
+        return count;
     // See comment in Forward method.
     MIOPEN_THROW(miopenStatusNotImplemented,
                  "Requested convolution is not supported or immedate mode fallback has failed.");
@@ -1513,19 +1698,21 @@ bool ConvolutionDescriptor::IsGemmApplicableBwd(const TensorDescriptor& dyDesc,
 #endif
 }
 
-std::size_t ConvolutionDescriptor::GetWrwSolutionCountFallback(const TensorDescriptor& dyDesc,
+std::size_t ConvolutionDescriptor::GetWrwSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& dyDesc,
                                                                const TensorDescriptor& xDesc,
                                                                const TensorDescriptor& dwDesc) const
 {
     ValidateGroupCount(xDesc, dwDesc, *this); // See comment in Forward method.
 
-    if(IsGemmApplicableWrw(xDesc, dyDesc, dwDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
-    {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
-    }
-    MIOPEN_LOG_I("Fallback path, GEMM disabled");
+    const auto problem = MakeWrwProblem(dyDesc, xDesc, dwDesc);
+    const auto count   = GetFallbackSolutionCount(handle,
+                                                problem,
+                                                conv::Direction::BackwardWeights,
+                                                StringToConvolutionBwdWeightsAlgo,
+                                                IsGemmApplicableWrw(xDesc, dyDesc, dwDesc));
+    if(count > 0)
+        return count;
     // See comment in Forward method.
     MIOPEN_THROW(miopenStatusNotImplemented,
                  "Requested convolution is not supported or immedate mode fallback has failed.");
@@ -1549,26 +1736,7 @@ std::size_t ConvolutionDescriptor::GetForwardSolutionCount(Handle& handle,
     const auto n       = GetSolutionCount(handle, problem);
     if(n > 0)
         return n;
-    return GetFwdSolutionCountFallback(wDesc, xDesc, yDesc);
-}
-
-static inline bool IsAlgorithmDisabled(const miopenConvAlgorithm_t algo)
-{
-    switch(algo)
-    { // clang-format off
-    case miopenConvolutionAlgoGEMM:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) || !MIOPEN_USE_GEMM;
-    case miopenConvolutionAlgoDirect:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{});
-    case miopenConvolutionAlgoFFT:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_FFT{});
-    case miopenConvolutionAlgoWinograd:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_WINOGRAD{});
-    case miopenConvolutionAlgoImplicitGEMM:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM{});
-    default: // Disable future algos by default to enforce explicit handling:
-        return true;
-    } // clang-format on
+    return GetFwdSolutionCountFallback(handle, wDesc, xDesc, yDesc);
 }
 
 void GetSolutions(Handle& handle,
@@ -1587,7 +1755,7 @@ void GetSolutions(Handle& handle,
     }
 
     // Read all what we have, then sort and write out up to max asked.
-    // Fallback path currently returns only one solution, so no need to sort there.
+    // Fallback path sorts its solutions by itself.
     struct SortWrapper : miopenConvSolution_t // For emplace and sort.
     {
         SortWrapper(const float& t,
@@ -1658,29 +1826,25 @@ void ConvolutionDescriptor::GetForwardSolutionsFallback(Handle& handle,
     // This check is needed on fallback path only.
     // Regular (find-db) path have been verified during Find().
     ValidateGroupCount(xDesc, wDesc, *this);
-    auto i = std::size_t{0};
 
-    if(IsGemmApplicableFwd(wDesc, xDesc, yDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
-    {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
-        {
-            solutions[i].algorithm = miopenConvolutionAlgoGEMM;
-            solutions[i].time      = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size =
-                ForwardGetValidWorkSpaceSizeGemm(handle, wDesc, xDesc, yDesc);
-            solutions[i].solution_id = solver::Id::gemm().Value();
-            ++i;
-        }
-    }
-    else
-        MIOPEN_LOG_I("Fallback path, GEMM disabled");
+    auto gemm_workspace = std::function<std::size_t()>{};
+    if(IsGemmApplicableFwd(wDesc, xDesc, yDesc))
+        gemm_workspace = [&]() {
+            return ForwardGetValidWorkSpaceSizeGemm(handle, wDesc, xDesc, yDesc);
+        };
 
-    *solutionCount = i;
+    const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+    const auto fallback = GetFallbackSolutions(handle,
+                                               problem,
+                                               conv::Direction::Forward,
+                                               StringToConvolutionFwdAlgo,
+                                               gemm_workspace,
+                                               maxSolutionCount);
+    std::copy(fallback.begin(), fallback.end(), solutions);
+    *solutionCount = fallback.size();
 }
 
-void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& /*handle*/,
+void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& handle,
                                                     const TensorDescriptor& dyDesc,
                                                     const TensorDescriptor& wDesc,
                                                     const TensorDescriptor& dxDesc,
@@ -1689,28 +1853,24 @@ void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& /*handle*/,
                                                     miopenConvSolution_t* const solutions) const
 {
     ValidateGroupCount(dxDesc, wDesc, *this);
-    auto i = std::size_t{0};
 
-    if(IsGemmApplicableBwd(dyDesc, wDesc, dxDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
-    {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
-        {
-            solutions[i].algorithm      = miopenConvolutionAlgoGEMM;
-            solutions[i].time           = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size = BackwardGetValidWorkSpaceSizeGemm(dyDesc, wDesc, dxDesc);
-            solutions[i].solution_id    = solver::Id::gemm().Value();
-            ++i;
-        }
-    }
-    else
-        MIOPEN_LOG_I("Fallback path, GEMM disabled");
+    auto gemm_workspace = std::function<std::size_t()>{};
+    if(IsGemmApplicableBwd(dyDesc, wDesc, dxDesc))
+        gemm_workspace = [&]() { return BackwardGetValidWorkSpaceSizeGemm(dyDesc, wDesc, dxDesc); };
 
-    *solutionCount = i;
+    const auto problem =
+        ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+    const auto fallback = GetFallbackSolutions(handle,
+                                               problem,
+                                               conv::Direction::BackwardData,
+                                               StringToConvolutionBwdDataAlgo,
+                                               gemm_workspace,
+                                               maxSolutionCount);
+    std::copy(fallback.begin(), fallback.end(), solutions);
+    *solutionCount = fallback.size();
 }
 
-void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& /*handle*/,
+void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& handle,
                                                     const TensorDescriptor& dyDesc,
                                                     const TensorDescriptor& xDesc,
                                                     const TensorDescriptor& dwDesc,
@@ -1719,25 +1879,20 @@ void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& /*handle*/,
                                                     miopenConvSolution_t* const solutions) const
 {
     ValidateGroupCount(xDesc, dwDesc, *this);
-    auto i = std::size_t{0};
 
-    if(IsGemmApplicableWrw(dyDesc, xDesc, dwDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
-    {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
-        {
-            solutions[i].algorithm      = miopenConvolutionAlgoGEMM;
-            solutions[i].time           = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size = WrwGetValidWorkSpaceSizeGemm(dyDesc, xDesc, dwDesc);
-            solutions[i].solution_id    = solver::Id::gemm().Value();
-            ++i;
-        }
-    }
-    else
-        MIOPEN_LOG_I("Fallback path, GEMM disabled");
+    auto gemm_workspace = std::function<std::size_t()>{};
+    if(IsGemmApplicableWrw(dyDesc, xDesc, dwDesc))
+        gemm_workspace = [&]() { return WrwGetValidWorkSpaceSizeGemm(dyDesc, xDesc, dwDesc); };
 
-    *solutionCount = i;
+    const auto problem = MakeWrwProblem(dyDesc, xDesc, dwDesc);
+    const auto fallback = GetFallbackSolutions(handle,
+                                               problem,
+                                               conv::Direction::BackwardWeights,
+                                               StringToConvolutionBwdWeightsAlgo,
+                                               gemm_workspace,
+                                               maxSolutionCount);
+    std::copy(fallback.begin(), fallback.end(), solutions);
+    *solutionCount = fallback.size();
 }
 
 void ConvolutionDescriptor::GetForwardSolutions(Handle& handle,
@@ -1881,7 +2036,7 @@ static std::vector<KernelInvoke> CompileSolver(const Handle& handle,
 
 static Invoker PrepareInvoker(Handle& handle,
                               ConvolutionContext& ctx,
-                              const NetworkConfig& config,
+                              const ProblemKey& problem_key,
                               solver::Id solver_id,
                               conv::Direction dir)
 {
@@ -1891,9 +2046,15 @@ static Invoker PrepareInvoker(Handle& handle,
     const auto solver = solver_id.GetSolver();
     auto db           = GetDb(ctx);
     auto solution     = solver.FindSolution(ctx, db);
-    auto invoker = handle.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
-
-    handle.RegisterInvoker(invoker, config, solver_id, AlgorithmName(solver_id.GetAlgo(dir)));
+    auto code_object_bytes = std::size_t{0};
+    auto invoker           = handle.PrepareInvoker(
+        *solution.invoker_factory, solution.construction_params, &code_object_bytes);
+
+    handle.RegisterInvoker(invoker,
+                           problem_key,
+                           solver_id,
+                           AlgorithmName(solver_id.GetAlgo(dir)),
+                           code_object_bytes);
     return invoker;
 }
 
@@ -1902,11 +2063,11 @@ static Invoker LoadOrPrepareInvoker(Handle& handle,
                                     solver::Id solver_id,
                                     conv::Direction dir)
 {
-    const auto config = ctx.BuildConfKey();
-    auto invoker      = handle.GetInvoker(config, solver_id);
+    const auto problem_key = ctx.MakeKey();
+    auto invoker           = handle.GetInvoker(problem_key, solver_id);
     if(invoker)
         return *invoker;
-    return PrepareInvoker(handle, ctx, config, solver_id, dir);
+    return PrepareInvoker(handle, ctx, problem_key, solver_id, dir);
 }
 
 static bool CheckInvokerSupport(const solver::Id solver_id, conv::Direction dir)
@@ -2002,6 +2163,14 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
 
     ConvForwardCheckNumerics(handle, tensors, [&]() {
+        const auto dispatch_key =
+            conv::DispatchKey{conv::Direction::Forward, solver_id, xDesc, wDesc, yDesc, *this};
+        if(const auto invoker = handle.GetImmediateInvoker(dispatch_key))
+        {
+            (*invoker)(handle, conv::DataInvokeParams{tensors, workSpace, workSpaceSize});
+            return;
+        }
+
         auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
         ctx.SetStream(&handle);
 
@@ -2009,6 +2178,7 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
         {
             const auto invoker =
                 LoadOrPrepareInvoker(handle, ctx, solver_id, conv::Direction::Forward);
+            handle.RegisterImmediateInvoker(dispatch_key, invoker);
             const auto invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
             invoker(handle, invoke_ctx);
             return;
@@ -2137,7 +2307,8 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
     else
     {
         perf_db = UserFindDbRecord::TryLoad(handle, problem, [&](DbRecord& record) {
-            const auto network_config = problem.BuildConfKey();
+            const auto problem_key    = problem.MakeKey();
+            const auto network_config = problem_key.ToNetworkConfig();
             const auto invoke_ctx     = conv::DataInvokeParams{
                 {dyDesc, dy, wDesc, w, dxDesc, dx}, workSpace, workSpaceSize};
 
@@ -2152,7 +2323,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
                 const auto all            = FindWinogradSolutions(ctx);
                 const auto algorithm_name = AlgorithmName{"miopenConvolutionBwdDataAlgoWinograd"};
                 PrecompileSolutions(handle, all);
-                EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+                EvaluateInvokers(handle, all, algorithm_name, problem_key, invoke_ctx, record);
             }
 
             // Direct algo
@@ -2164,7 +2335,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
                     handle, dxDesc, wDesc, dyDesc, exhaustiveSearch, false, bufs);
                 const auto algorithm_name = AlgorithmName{"miopenConvolutionBwdDataAlgoDirect"};
                 PrecompileSolutions(handle, all);
-                EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+                EvaluateInvokers(handle, all, algorithm_name, problem_key, invoke_ctx, record);
             }
 
             // Implicit GEMM algo
@@ -2177,7 +2348,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
                 PrecompileSolutions(handle, all);
                 const auto algorithm_name =
                     AlgorithmName{"miopenConvolutionBwdDataAlgoImplicitGEMM"};
-                EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+                EvaluateInvokers(handle, all, algorithm_name, problem_key, invoke_ctx, record);
             }
 
             if(GetSpatialDimension() == 2 && GetConvDilations()[0] == 1 &&
@@ -2511,8 +2682,11 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
 
         auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
         ctx.SetStream(&handle);
-        const auto network_config = ctx.BuildConfKey();
-        const auto& invoker       = handle.GetInvoker(network_config, boost::none, algorithm_name);
+        const auto problem_key = ctx.MakeKey();
+        auto invoker           = handle.GetInvoker(problem_key, boost::none, algorithm_name);
+        if(!invoker)
+            invoker = RestoreFoundInvoker(
+                handle, ctx, problem_key, algorithm_name, conv::Direction::BackwardData);
 
         if(invoker)
         {
@@ -2521,6 +2695,8 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
             return;
         }
 
+        const auto network_config = problem_key.ToNetworkConfig();
+
         switch(algo)
         {
         case miopenConvolutionBwdDataAlgoDirect:
@@ -2875,7 +3051,7 @@ std::size_t ConvolutionDescriptor::GetBackwardSolutionCount(Handle& handle,
     const auto count = GetSolutionCount(handle, problem);
     if(count > 0)
         return count;
-    return GetBwdSolutionCountFallback(dyDesc, wDesc, dxDesc);
+    return GetBwdSolutionCountFallback(handle, dyDesc, wDesc, dxDesc);
 }
 
 void ConvolutionDescriptor::GetBackwardSolutions(Handle& handle,
@@ -2982,12 +3158,21 @@ void ConvolutionDescriptor::ConvolutionBackwardImmediate(Handle& handle,
         }
         ValidateGroupCount(dxDesc, wDesc, *this);
 
+        const auto dispatch_key = conv::DispatchKey{
+            conv::Direction::BackwardData, solver_id, dxDesc, wDesc, dyDesc, *this};
+        if(const auto invoker = handle.GetImmediateInvoker(dispatch_key))
+        {
+            (*invoker)(handle, conv::DataInvokeParams{tensors, workSpace, workSpaceSize});
+            return;
+        }
+
         auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
 
         if(CheckInvokerSupport(solver_id, conv::Direction::BackwardData))
         {
             const auto invoker =
                 LoadOrPrepareInvoker(handle, ctx, solver_id, conv::Direction::BackwardData);
+            handle.RegisterImmediateInvoker(dispatch_key, invoker);
             const auto invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
             invoker(handle, invoke_ctx);
             return;
@@ -3515,7 +3700,8 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
             ctx.SetBufs(bufs);
             ctx.SetupFloats();
             ctx.DetectRocm();
-            const auto network_config = ctx.BuildConfKey();
+            const auto problem_key    = ctx.MakeKey();
+            const auto network_config = problem_key.ToNetworkConfig();
             const auto invoke_ctx =
                 conv::WrWInvokeParams{{dyDesc, dy, xDesc, x, dwDesc, dw}, workSpace, workSpaceSize};
             // direct convolution
@@ -3523,7 +3709,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
             {
                 const auto all            = FindAllBwdWrW2DSolutions(ctx);
                 const auto algorithm_name = AlgorithmName{"miopenConvolutionBwdWeightsAlgoDirect"};
-                EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+                EvaluateInvokers(handle, all, algorithm_name, problem_key, invoke_ctx, record);
             }
 
             try
@@ -3807,7 +3993,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                 const auto all = FindImplicitGemmWrWAllSolutions(ctx);
                 const auto algorithm_name =
                     AlgorithmName{"miopenConvolutionBwdWeightsAlgoImplicitGEMM"};
-                EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+                EvaluateInvokers(handle, all, algorithm_name, problem_key, invoke_ctx, record);
             }
         });
     }
@@ -3897,8 +4083,11 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(Handle& handle,
         auto ctx =
             ConvolutionContext{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
         ctx.SetStream(&handle);
-        const auto network_config = ctx.BuildConfKey();
-        const auto& invoker       = handle.GetInvoker(network_config, boost::none, algorithm_name);
+        const auto problem_key = ctx.MakeKey();
+        auto invoker           = handle.GetInvoker(problem_key, boost::none, algorithm_name);
+        if(!invoker)
+            invoker = RestoreFoundInvoker(
+                handle, ctx, problem_key, algorithm_name, conv::Direction::BackwardWeights);
 
         if(invoker)
         {
@@ -3907,6 +4096,8 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(Handle& handle,
             return;
         }
 
+        const auto network_config = problem_key.ToNetworkConfig();
+
         switch(algo)
         {
         case miopenConvolutionBwdWeightsAlgoDirect:
@@ -4379,7 +4570,7 @@ std::size_t ConvolutionDescriptor::GetWrwSolutionCount(Handle& handle,
     const auto count   = GetSolutionCount(handle, problem);
     if(count > 0)
         return count;
-    return GetWrwSolutionCountFallback(dyDesc, xDesc, dwDesc);
+    return GetWrwSolutionCountFallback(handle, dyDesc, xDesc, dwDesc);
 }
 
 void ConvolutionDescriptor::GetWrwSolutions(Handle& handle,
@@ -4476,6 +4667,14 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
     ConvWrwCheckNumerics(handle, tensors, &beta, [&]() {
         ValidateGroupCount(xDesc, dwDesc, *this);
 
+        const auto dispatch_key = conv::DispatchKey{
+            conv::Direction::BackwardWeights, solver_id, xDesc, dwDesc, dyDesc, *this};
+        if(const auto invoker = handle.GetImmediateInvoker(dispatch_key))
+        {
+            (*invoker)(handle, conv::WrWInvokeParams{tensors, workSpace, workSpaceSize});
+            return;
+        }
+
         auto ctx =
             ConvolutionContext{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
         ctx.SetStream(&handle);
@@ -4484,6 +4683,7 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
         {
             const auto invoker =
                 LoadOrPrepareInvoker(handle, ctx, solver_id, conv::Direction::BackwardWeights);
+            handle.RegisterImmediateInvoker(dispatch_key, invoker);
             const auto invoke_ctx = conv::WrWInvokeParams{tensors, workSpace, workSpaceSize};
             invoker(handle, invoke_ctx);
             return;
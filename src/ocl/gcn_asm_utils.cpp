@@ -256,7 +256,7 @@ static void AmdgcnAssembleQuiet(const std::string& source, const std::string& pa
 static bool GcnAssemblerHasBug34765Impl()
 {
     auto p = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
-    miopen::WriteFile(miopen::GetKernelSrc("bugzilla_34765_detect"), p);
+    miopen::WriteFile(miopen::GetKernelSrcView("bugzilla_34765_detect"), p);
     const auto& src = p.string();
     try
     {
@@ -279,7 +279,7 @@ bool GcnAssemblerHasBug34765()
 static bool GcnAssemblerSupportsOption(const std::string& option)
 {
     auto p = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
-    miopen::WriteFile(miopen::GetKernelSrc("dummy_kernel"), p);
+    miopen::WriteFile(miopen::GetKernelSrcView("dummy_kernel"), p);
     const auto& src = p.string();
     try
     {
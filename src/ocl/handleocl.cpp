@@ -28,6 +28,7 @@
 
 #include <miopen/binary_cache.hpp>
 #include <miopen/config.h>
+#include <miopen/db.hpp>
 #include <miopen/device_name.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle_lock.hpp>
@@ -38,6 +39,7 @@
 #include <miopen/manage_ptr.hpp>
 #include <miopen/ocldeviceinfo.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
 
 #if MIOPEN_USE_MIOPENGEMM
 #include <miopen/gemm_geometry.hpp>
@@ -442,7 +444,7 @@ Handle::Handle() : impl(new HandleImpl())
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+Handle::~Handle() { PlainTextDb::FlushPendingWrites(); }
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -506,8 +508,11 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
 }
 
 Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
-                               const std::vector<solver::KernelInfo>& kernels) const
+                               const std::vector<solver::KernelInfo>& kernels,
+                               std::size_t* code_object_bytes) const
 {
+    MIOPEN_TRACE_SPAN_DETAIL(
+        "invoker", "PrepareInvoker", kernels.empty() ? "" : kernels.front().kernel_name);
     std::vector<Kernel> built;
     for(auto& k : kernels)
     {
@@ -522,6 +527,10 @@ Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
                                                         k.comp_options,
                                                         kernels.size());
         built.push_back(kernel);
+        // The program has just been used, so it has not been evicted.
+        if(code_object_bytes != nullptr)
+            *code_object_bytes +=
+                this->impl->cache.GetCodeObjectSize(k.kernel_file, k.comp_options);
     }
     return factory(built);
 }
@@ -537,8 +546,14 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+void Handle::PinKernels(const std::string& algorithm, const std::string& network_config) const
+{
+
+    this->impl->cache.PinKernels(algorithm, network_config);
+}
+
+std::vector<Kernel> Handle::GetKernelsImpl(const std::string& algorithm,
+                                           const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -568,6 +583,7 @@ Program Handle::LoadProgram(const std::string& program_name,
         this->GetDeviceName(), this->GetMaxComputeUnits(), program_name, params, is_kernel_str);
     if(hsaco.empty())
     {
+        MIOPEN_TRACE_SPAN_DETAIL("compile", "Compile", program_name);
         CompileTimer ct;
         auto p = miopen::LoadProgram(miopen::GetContext(this->GetStream()),
                                      miopen::GetDevice(this->GetStream()),
@@ -607,6 +623,27 @@ Program Handle::LoadProgram(const std::string& program_name,
     }
 }
 
+std::vector<boost::optional<Program>>
+Handle::LoadCachedPrograms(const std::vector<std::pair<std::string, std::string>>& programs) const
+{
+    const auto binaries =
+        miopen::LoadBinaries(this->GetDeviceName(), this->GetMaxComputeUnits(), programs);
+    auto loaded = std::vector<boost::optional<Program>>(programs.size());
+    for(auto i = 0u; i < binaries.size(); ++i)
+    {
+        if(binaries[i].empty())
+            continue;
+        loaded[i] = LoadBinaryProgram(miopen::GetContext(this->GetStream()),
+                                      miopen::GetDevice(this->GetStream()),
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+                                      binaries[i]);
+#else
+                                      miopen::LoadFile(binaries[i]));
+#endif
+    }
+    return loaded;
+}
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -619,6 +656,13 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
+CacheStats Handle::GetKernelCacheStats() const { return this->impl->cache.GetStats(); }
+
+void Handle::SetKernelCacheCapacity(std::size_t capacity) const
+{
+    this->impl->cache.SetCapacity(capacity);
+}
+
 void Handle::Finish() const { clFinish(this->GetStream()); }
 
 void Handle::Flush() const { clFlush(this->GetStream()); }
@@ -2,49 +2,49 @@
 
 #include <miopen/convolution.hpp>
 
-#include <functional>
-#include <sstream>
-#include <tuple>
+#include <ostream>
 
 namespace miopen {
 
-std::function<void(std::ostream&)>
-PrintDHW(char sep, int spatial_dims, int depth, int height, int width)
+ProblemKey ProblemDescription::MakeKey() const
 {
-    return [=](std::ostream& stream) {
-        if(spatial_dims > 2)
-            stream << depth << sep;
-        stream << height << sep << width;
-    };
-}
-
-std::ostream& operator<<(std::ostream& stream, std::function<void(std::ostream&)>&& manipulator)
-{
-    manipulator(stream);
-    return stream;
+    ProblemKey key;
+    key.spatial_dims      = spatial_dims;
+    key.in_channels       = n_inputs;
+    key.in_depth          = in_depth;
+    key.in_height         = in_height;
+    key.in_width          = in_width;
+    key.weights_depth     = kernel_size_d;
+    key.weights_height    = kernel_size_h;
+    key.weights_width     = kernel_size_w;
+    key.out_channels      = n_outputs;
+    key.out_depth         = out_depth;
+    key.out_height        = out_height;
+    key.out_width         = out_width;
+    key.batch_size        = batch_sz;
+    key.pad_d             = pad_d;
+    key.pad_h             = pad_h;
+    key.pad_w             = pad_w;
+    key.stride_d          = kernel_stride_d;
+    key.stride_h          = kernel_stride_h;
+    key.stride_w          = kernel_stride_w;
+    key.dilation_d        = kernel_dilation_d;
+    key.dilation_h        = kernel_dilation_h;
+    key.dilation_w        = kernel_dilation_w;
+    key.group_count       = group_counts;
+    key.bias              = bias;
+    key.in_data_type      = in_data_type;
+    key.weights_data_type = weights_data_type;
+    key.out_data_type     = out_data_type;
+    key.direction         = direction.IsForward() ? 'F' : direction.IsBackwardData() ? 'B' : 'W';
+    key.SetLayout(in_layout);
+    key.UpdateHash();
+    return key;
 }
 
 int ProblemDescription::mloBuildConf_Key(std::string& conf_key) const
 {
-    std::ostringstream ss;
-
-    ss << n_inputs;
-    ss << 'x' << PrintDHW('x', spatial_dims, in_depth, in_height, in_width);
-    ss << 'x' << PrintDHW('x', spatial_dims, kernel_size_d, kernel_size_h, kernel_size_w);
-    ss << 'x' << n_outputs;
-    ss << 'x' << PrintDHW('x', spatial_dims, out_depth, out_height, out_width);
-    ss << 'x' << batch_sz;
-    ss << 'x' << in_layout;
-    ss << 'x' << EncodeDataTypesForKey(in_data_type, weights_data_type, out_data_type);
-    ss << 'x' << PrintDHW('x', spatial_dims, pad_d, pad_h, pad_w);
-    ss << 'x' << PrintDHW('x', spatial_dims, kernel_stride_d, kernel_stride_h, kernel_stride_w);
-    ss << 'x'
-       << PrintDHW('x', spatial_dims, kernel_dilation_d, kernel_dilation_h, kernel_dilation_w);
-    ss << 'x' << group_counts;
-    ss << 'x' << (direction.IsForward() ? "1" : "0");
-
-    conf_key = ss.str();
-
+    conf_key = MakeKey().ToNetworkConfig();
     return (0);
 }
 
@@ -52,35 +52,7 @@ void ProblemDescription::Serialize(std::ostream& stream) const
 {
     if(!direction.IsKnown())
         MIOPEN_THROW("!direction.IsKnown()");
-    const auto sep = '-';
-    // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F
-    // clang-format off
-    stream << n_inputs;
-    stream << sep << PrintDHW(sep, spatial_dims, in_depth, in_height, in_width);
-    stream << sep << PrintDHW('x', spatial_dims, kernel_size_d, kernel_size_h, kernel_size_w);
-    stream << sep << n_outputs;
-    stream << sep << PrintDHW(sep, spatial_dims, out_depth, out_height, out_width);
-    stream << sep << batch_sz;
-    stream << sep << PrintDHW('x', spatial_dims, pad_d, pad_h, pad_w);
-    stream << sep << PrintDHW('x', spatial_dims, kernel_stride_d, kernel_stride_h, kernel_stride_w);
-    stream << sep << PrintDHW('x', spatial_dims, kernel_dilation_d, kernel_dilation_h, kernel_dilation_w);
-    stream << sep << bias;
-    stream << sep << in_layout;
-    stream << sep << EncodeDataTypesForKey(in_data_type, weights_data_type, out_data_type);
-    stream << sep << (direction.IsForward() ? "F" : direction.IsBackwardData() ? "B" : "W");
-    // clang-format on
-    // New performance config entries shall come into variable/optional part of db key.
-    // This is to support backward compatibility with previous versions of databases.
-    std::ostringstream optional;
-    {
-        // Group count > 1 identifies Group/Depthwise modes.
-        if(group_counts != 1)
-            optional << 'g' << group_counts;
-    }
-    if(!optional.str().empty())
-    {
-        stream << '_' << optional.str();
-    }
+    stream << MakeKey().ToDbKey();
 }
 
 ProblemDescription::ProblemDescription(const TensorDescriptor& in,
@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/problem_key.hpp>
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/each_args.hpp>
+#include <miopen/errors.hpp>
+
+#include <cstring>
+#include <ostream>
+#include <tuple>
+#include <utility>
+
+namespace miopen {
+
+namespace {
+
+auto Tie(const ProblemKey& key)
+{
+    return std::tie(key.spatial_dims,
+                    key.in_channels,
+                    key.in_depth,
+                    key.in_height,
+                    key.in_width,
+                    key.weights_depth,
+                    key.weights_height,
+                    key.weights_width,
+                    key.out_channels,
+                    key.out_depth,
+                    key.out_height,
+                    key.out_width,
+                    key.batch_size,
+                    key.pad_d,
+                    key.pad_h,
+                    key.pad_w,
+                    key.stride_d,
+                    key.stride_h,
+                    key.stride_w,
+                    key.dilation_d,
+                    key.dilation_h,
+                    key.dilation_w,
+                    key.group_count,
+                    key.bias,
+                    key.in_data_type,
+                    key.weights_data_type,
+                    key.out_data_type,
+                    key.direction);
+}
+
+struct KeyWriter
+{
+    std::string& out;
+    int spatial_dims;
+
+    void Append(int value) { out += std::to_string(value); }
+    void Append(char value) { out += value; }
+    void Append(const char* value) { out += value; }
+    void Append(const std::string& value) { out += value; }
+
+    template <class T, class U, class... Ts>
+    void Append(const T& value, const U& next, const Ts&... rest)
+    {
+        Append(value);
+        Append(next, rest...);
+    }
+
+    void AppendDHW(char sep, int depth, int height, int width)
+    {
+        if(spatial_dims > 2)
+            Append(depth, sep);
+        Append(height, sep, width);
+    }
+};
+
+template <class F, class Tuple, std::size_t... Is>
+void EachElement(F f, const Tuple& tuple, std::index_sequence<Is...>)
+{
+    each_args(f, std::get<Is>(tuple)...);
+}
+
+} // namespace
+
+void ProblemKey::SetLayout(const std::string& layout)
+{
+    if(layout.size() > max_layout_length)
+        MIOPEN_THROW("Layout is too long for a problem key: " + layout);
+    std::memset(in_layout, 0, sizeof(in_layout));
+    std::memcpy(in_layout, layout.data(), layout.size());
+}
+
+void ProblemKey::UpdateHash()
+{
+    // FNV-1a over the values rather than over the bytes of the struct, as padding is not
+    // guaranteed to be zeroed.
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    const auto mix  = [&](std::uint64_t value) {
+        h ^= value;
+        h *= 0x100000001b3ULL;
+    };
+    const auto fields = Tie(*this);
+    EachElement([&](auto value) { mix(static_cast<std::uint32_t>(value)); },
+                fields,
+                std::make_index_sequence<std::tuple_size<decltype(fields)>::value>{});
+    for(const auto c : in_layout)
+        mix(static_cast<unsigned char>(c));
+    hash = static_cast<std::size_t>(h);
+}
+
+bool operator==(const ProblemKey& left, const ProblemKey& right)
+{
+    return left.hash == right.hash && Tie(left) == Tie(right) &&
+           std::memcmp(left.in_layout, right.in_layout, sizeof(left.in_layout)) == 0;
+}
+
+NetworkConfig ProblemKey::ToNetworkConfig() const
+{
+    const auto data_types =
+        EncodeDataTypesForKey(static_cast<miopenDataType_t>(in_data_type),
+                              static_cast<miopenDataType_t>(weights_data_type),
+                              static_cast<miopenDataType_t>(out_data_type));
+
+    std::string ret;
+    ret.reserve(128);
+    auto w = KeyWriter{ret, spatial_dims};
+
+    w.Append(in_channels, 'x');
+    w.AppendDHW('x', in_depth, in_height, in_width);
+    w.Append('x');
+    w.AppendDHW('x', weights_depth, weights_height, weights_width);
+    w.Append('x', out_channels, 'x');
+    w.AppendDHW('x', out_depth, out_height, out_width);
+    w.Append('x', batch_size, 'x', in_layout, 'x', data_types, 'x');
+    w.AppendDHW('x', pad_d, pad_h, pad_w);
+    w.Append('x');
+    w.AppendDHW('x', stride_d, stride_h, stride_w);
+    w.Append('x');
+    w.AppendDHW('x', dilation_d, dilation_h, dilation_w);
+    w.Append('x', group_count, 'x', direction == 'F' ? "1" : "0");
+
+    return NetworkConfig{ret};
+}
+
+std::string ProblemKey::ToDbKey() const
+{
+    const auto data_types =
+        EncodeDataTypesForKey(static_cast<miopenDataType_t>(in_data_type),
+                              static_cast<miopenDataType_t>(weights_data_type),
+                              static_cast<miopenDataType_t>(out_data_type));
+    const auto sep = '-';
+
+    std::string ret;
+    ret.reserve(128);
+    auto w = KeyWriter{ret, spatial_dims};
+
+    // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F
+    w.Append(in_channels, sep);
+    w.AppendDHW(sep, in_depth, in_height, in_width);
+    w.Append(sep);
+    w.AppendDHW('x', weights_depth, weights_height, weights_width);
+    w.Append(sep, out_channels, sep);
+    w.AppendDHW(sep, out_depth, out_height, out_width);
+    w.Append(sep, batch_size, sep);
+    w.AppendDHW('x', pad_d, pad_h, pad_w);
+    w.Append(sep);
+    w.AppendDHW('x', stride_d, stride_h, stride_w);
+    w.Append(sep);
+    w.AppendDHW('x', dilation_d, dilation_h, dilation_w);
+    w.Append(sep, bias, sep, in_layout, sep, data_types, sep, direction);
+
+    // New performance config entries shall come into variable/optional part of db key.
+    // This is to support backward compatibility with previous versions of databases.
+    // Group count > 1 identifies Group/Depthwise modes.
+    if(group_count != 1)
+        w.Append('_', 'g', group_count);
+
+    return ret;
+}
+
+std::ostream& operator<<(std::ostream& stream, const ProblemKey& key)
+{
+    return stream << key.ToDbKey();
+}
+
+} // namespace miopen
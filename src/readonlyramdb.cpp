@@ -25,8 +25,12 @@
  *******************************************************************************/
 
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/env.hpp>
+#include <miopen/find_db_image.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/trace.hpp>
 
 #if MIOPEN_EMBED_DB
 #include <miopen_data.hpp>
@@ -34,28 +38,79 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
+#include <atomic>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <sstream>
-#include <map>
+#include <unordered_map>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FIND_DB_BINARY_IMAGE)
 
 namespace miopen {
+
+/// Read-only memory mapping of a find-db image file produced by fdb2bin.
+class FindDbImageFile
+{
+    public:
+    FindDbImageFile(const std::string& path)
+        : file(path.c_str(), boost::interprocess::read_only),
+          region(file, boost::interprocess::read_only),
+          view(static_cast<const char*>(region.get_address()), region.get_size())
+    {
+    }
+
+    const find_db_image::View& View() const { return view; }
+
+    private:
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+    find_db_image::View view;
+};
+
 extern boost::optional<std::string>&
 testing_find_db_path_override(); /// \todo Remove when #1723 is resolved.
+namespace {
+using ReadonlyRamDbInstances = std::unordered_map<std::string, ReadonlyRamDb*>;
+} // namespace
+
 ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path,
                                         bool warn_if_unreadable,
                                         const std::string& /*arch*/,
                                         const std::size_t /*num_cu*/)
 {
+    // Readers only load the currently published snapshot of the instances map and never lock.
+    // A snapshot is immutable after publication. Writers (first use of a path) serialize on the
+    // mutex, publish a copy extended with the new instance and keep the previous snapshots
+    // alive, as readers may still be looking into them. There are very few paths during the
+    // application lifetime, so the total footprint of the snapshots is negligible.
+    static std::atomic<const ReadonlyRamDbInstances*> published{nullptr};
     static std::mutex mutex;
-    const std::lock_guard<std::mutex> lock{mutex};
+    static std::vector<std::unique_ptr<const ReadonlyRamDbInstances>> snapshots;
 
-    static auto instances = std::map<std::string, ReadonlyRamDb*>{};
-    const auto it         = instances.find(path);
+    {
+        const auto instances = published.load(std::memory_order_acquire);
+        if(instances != nullptr)
+        {
+            const auto it = instances->find(path);
+            if(it != instances->end())
+                return *it->second;
+        }
+    }
 
-    if(it != instances.end())
-        return *it->second;
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    const auto current = published.load(std::memory_order_relaxed);
+    if(current != nullptr)
+    {
+        const auto it = current->find(path);
+        if(it != current->end())
+            return *it->second;
+    }
 
     // The ReadonlyRamDb objects allocated here by "new" shall be alive during
     // the calling app lifetime. Size of each is very small, and there couldn't
@@ -65,8 +120,13 @@ ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path,
     // these objects thus avoiding bothering with MP/MT syncronization.
     // These will be destroyed altogether with heap.
     auto instance = new ReadonlyRamDb{path};
-    instances.emplace(path, instance);
     instance->Prefetch(path, warn_if_unreadable);
+
+    auto next = current != nullptr ? std::make_unique<ReadonlyRamDbInstances>(*current)
+                                   : std::make_unique<ReadonlyRamDbInstances>();
+    next->emplace(path, instance);
+    published.store(next.get(), std::memory_order_release);
+    snapshots.emplace_back(std::move(next));
     return *instance;
 }
 
@@ -120,8 +180,134 @@ void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream,
     }
 }
 
+static std::string GetImagePath(const std::string& path)
+{
+    const std::string text_ext = ".txt";
+    if(path.size() > text_ext.size() &&
+       path.compare(path.size() - text_ext.size(), text_ext.size(), text_ext) == 0)
+        return path.substr(0, path.size() - text_ext.size()) + ".bin";
+    return path + ".bin";
+}
+
+// The text db may have been replaced after the image was made, e.g. by a user. Copies keep the
+// size but not always the timestamp, so the digest decides when only the timestamp differs.
+static bool IsImageUpToDate(const find_db_image::View& view, const std::string& path)
+{
+    auto ec              = boost::system::error_code{};
+    const auto text_size = boost::filesystem::file_size(path, ec);
+    if(ec)
+        return true; // Only the image is installed.
+    if(text_size != view.SourceSize())
+        return false;
+
+    const auto mtime = boost::filesystem::last_write_time(path, ec);
+    if(!ec && mtime == view.SourceMtime())
+        return true;
+
+    auto text   = std::ifstream{path, std::ios::in | std::ios::binary};
+    auto hasher = Md5Hasher{};
+    char buffer[64 * 1024];
+    while(text.read(buffer, sizeof(buffer)) || text.gcount() > 0)
+        hasher.Update(buffer, text.gcount());
+    MIOPEN_LOG_I2("Find-db image timestamp differs from " << path << ", compared the digests");
+    return !text.bad() && hasher.HexDigest() == view.SourceMd5();
+}
+
+bool ReadonlyRamDb::TryLoadImage(const std::string& path)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_FIND_DB_BINARY_IMAGE{}))
+        return false;
+
+    const auto image_path = GetImagePath(path);
+    auto ec               = boost::system::error_code{};
+
+    if(!boost::filesystem::exists(image_path, ec))
+        return false;
+
+    try
+    {
+        const auto loaded = std::make_shared<const FindDbImageFile>(image_path);
+
+        if(!loaded->View().IsValid())
+        {
+            MIOPEN_LOG_W("Invalid or incompatible find-db image: " << image_path);
+            return false;
+        }
+
+        if(!IsImageUpToDate(loaded->View(), path))
+        {
+            MIOPEN_LOG_I("Find-db image is stale, using the text db: " << image_path);
+            return false;
+        }
+
+        image = loaded;
+        MIOPEN_LOG_I2("Mapped find-db image: " << image_path << ", "
+                                               << image->View().RecordCount()
+                                               << " records");
+        return true;
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map find-db image <" << image_path << ">: " << ex.what());
+        return false;
+    }
+}
+
+boost::optional<DbRecord> ReadonlyRamDb::FindRecordInImage(const std::string& problem) const
+{
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+
+    const auto& view  = image->View();
+    const auto record = view.Find(problem.data(), problem.size());
+
+    if(record == nullptr)
+        return boost::none;
+
+    auto ret = DbRecord{problem};
+    for(auto item = view.ItemsBegin(*record); item != view.ItemsEnd(*record); ++item)
+        ret.map.emplace(view.String(item->id), find_db_image::FormatItemValues(view, *item));
+    return ret;
+}
+
+bool ReadonlyRamDb::FindItems(const std::string& problem,
+                              std::vector<std::pair<std::string, FindDbData>>& items) const
+{
+    if(!image)
+    {
+        const auto record = FindRecord(problem);
+        if(!record)
+            return false;
+        const auto range = record->As<FindDbData>();
+        items.assign(range.begin(), range.end());
+        return true;
+    }
+
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+
+    const auto& view  = image->View();
+    const auto record = view.Find(problem.data(), problem.size());
+
+    if(record == nullptr)
+        return false;
+
+    items.clear();
+    items.reserve(record->item_count);
+    for(auto item = view.ItemsBegin(*record); item != view.ItemsEnd(*record); ++item)
+    {
+        auto data                      = FindDbData{};
+        data.solver_id                 = view.String(item->solver_id);
+        data.time                      = item->time;
+        data.workspace                 = item->workspace;
+        data.kcache_key.algorithm_name = view.String(item->kcache_algorithm);
+        data.kcache_key.network_config = view.String(item->kcache_network_config);
+        items.emplace_back(view.String(item->id), std::move(data));
+    }
+    return true;
+}
+
 void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
 {
+    MIOPEN_TRACE_SPAN_DETAIL("db", "Prefetch", path);
     Measure("Prefetch", [this, &path, warn_if_unreadable]() {
 
         constexpr bool isEmbedded = MIOPEN_EMBED_DB;
@@ -143,6 +329,9 @@ void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
         }
         else
         {
+            if(!testing_find_db_path_override() && TryLoadImage(path))
+                return;
+
             auto input_stream = std::ifstream{path};
             ParseAndLoadDb(input_stream, path, warn_if_unreadable);
         }
@@ -0,0 +1,261 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/search_checkpoint.hpp>
+
+#include <miopen/config.h>
+#include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <cstdlib>
+#include <sstream>
+#include <utility>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_CHECKPOINT_PATH)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_CHECKPOINT_INTERVAL)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+/// The problem config of a checkpoint record.
+struct CheckpointKey
+{
+    const std::string& key;
+
+    void Serialize(std::ostream& stream) const { stream << key; }
+};
+
+} // namespace
+
+void SearchCheckpoint::Serialize(std::ostream& stream) const
+{
+    stream << total << ',' << shard << ',' << shards << ',' << (done ? 1 : 0);
+    for(const auto& entry : evaluated)
+    {
+        stream << ',' << entry.candidate << '/';
+        if(entry.succeeded)
+            stream << entry.time;
+        else
+            stream << '-';
+    }
+}
+
+bool SearchCheckpoint::Deserialize(const std::string& str)
+{
+    auto checkpoint = SearchCheckpoint{};
+    auto ss         = std::istringstream{str};
+    auto field      = std::string{};
+
+    std::size_t header[4];
+    for(auto& value : header)
+    {
+        if(!std::getline(ss, field, ',') || field.empty())
+            return false;
+        char* end = nullptr;
+        value     = std::strtoull(field.c_str(), &end, 10);
+        if(*end != '\0')
+            return false;
+    }
+    checkpoint.total  = header[0];
+    checkpoint.shard  = header[1];
+    checkpoint.shards = header[2];
+    checkpoint.done   = header[3] != 0;
+    if(checkpoint.shards == 0 || checkpoint.shard >= checkpoint.shards)
+        return false;
+
+    while(std::getline(ss, field, ','))
+    {
+        char* end       = nullptr;
+        auto entry      = Entry{};
+        entry.candidate = std::strtoull(field.c_str(), &end, 10);
+        if(end == field.c_str() || *end != '/' || entry.candidate >= checkpoint.total)
+            return false;
+        const auto p_time = end + 1;
+        entry.succeeded   = *p_time != '-';
+        entry.time        = entry.succeeded ? std::strtof(p_time, &end) : 0.0f;
+        if(entry.succeeded ? (end == p_time || *end != '\0') : p_time[1] != '\0')
+            return false;
+        checkpoint.evaluated.push_back(entry);
+    }
+
+    *this = std::move(checkpoint);
+    return true;
+}
+
+SearchCheckpointDb::SearchCheckpointDb(std::string path_, std::string key_, std::string solver_id_)
+    : path(std::move(path_)), key(std::move(key_)), solver_id(std::move(solver_id_))
+{
+}
+
+std::string SearchCheckpointDb::GetId(const SearchCheckpoint& checkpoint) const
+{
+    if(checkpoint.shards == 1)
+        return solver_id;
+    return solver_id + '#' + std::to_string(checkpoint.shard) + '/' +
+           std::to_string(checkpoint.shards);
+}
+
+bool SearchCheckpointDb::IsOwnId(const std::string& id) const
+{
+    return id.compare(0, solver_id.size(), solver_id) == 0 &&
+           (id.size() == solver_id.size() || id[solver_id.size()] == '#');
+}
+
+std::vector<SearchCheckpoint> SearchCheckpointDb::Load() const
+{
+    auto checkpoints = std::vector<SearchCheckpoint>{};
+    if(path.empty())
+        return checkpoints;
+
+    const auto record = PlainTextDb{path}.FindRecord(key);
+    if(!record)
+        return checkpoints;
+    for(const auto& pair : record->As<SearchCheckpoint>())
+    {
+        if(!IsOwnId(pair.first))
+            continue;
+        if(pair.second.total == 0)
+        {
+            MIOPEN_LOG_W("Ignoring a corrupt checkpoint of " << pair.first << " in " << path);
+            continue;
+        }
+        checkpoints.push_back(pair.second);
+    }
+    return checkpoints;
+}
+
+void SearchCheckpointDb::Save(const SearchCheckpoint& checkpoint) const
+{
+    if(path.empty())
+        return;
+    auto db = PlainTextDb{path};
+    if(!db.Update(CheckpointKey{key}, GetId(checkpoint), checkpoint))
+        MIOPEN_LOG_W("Unable to save the checkpoint of " << solver_id << " to " << path);
+    // Do not leave the checkpoint in the write-behind queue, where a crash would lose it.
+    PlainTextDb::FlushPendingWrites();
+}
+
+void SearchCheckpointDb::Remove() const
+{
+    if(path.empty())
+        return;
+    auto db           = PlainTextDb{path};
+    const auto record = db.FindRecord(key);
+    if(!record)
+        return;
+    for(const auto& pair : record->As<SearchCheckpoint>())
+    {
+        if(IsOwnId(pair.first))
+            db.Remove(key, pair.first);
+    }
+    PlainTextDb::FlushPendingWrites();
+}
+
+std::string GetSearchCheckpointPath(const std::string& db_basename)
+{
+    if(GetSearchCheckpointInterval() <= 0.0f)
+        return "";
+    const char* const p_path = GetStringEnv(MIOPEN_TUNING_CHECKPOINT_PATH{});
+    if(p_path != nullptr)
+        return p_path;
+#if !MIOPEN_DISABLE_USERDB
+    if(GetUserDbPath().empty())
+        return "";
+    return GetUserDbPath() + "/" + db_basename + "." + GetUserDbSuffix() + ".tuning.txt";
+#else
+    (void)(db_basename);
+    return "";
+#endif
+}
+
+float GetSearchCheckpointInterval()
+{
+    const char* const p_seconds = GetStringEnv(MIOPEN_TUNING_CHECKPOINT_INTERVAL{});
+    if(p_seconds == nullptr)
+        return 30.0f;
+    return std::strtof(p_seconds, nullptr);
+}
+
+SearchCheckpointer::SearchCheckpointer(SearchCheckpointDb db_,
+                                       SearchPlanner& planner,
+                                       const SearchOptions& options,
+                                       std::size_t total,
+                                       float interval_)
+    : db(std::move(db_)), interval(interval_), saved(std::chrono::steady_clock::now())
+{
+    checkpoint.total  = total;
+    checkpoint.shard  = options.shard;
+    checkpoint.shards = options.shards;
+
+    for(const auto& loaded : db.Load())
+    {
+        if(loaded.total != total)
+        {
+            MIOPEN_LOG_W("Ignoring the checkpoint of a search among " << loaded.total
+                                                                      << " configs instead of "
+                                                                      << total);
+            continue;
+        }
+        for(const auto& entry : loaded.evaluated)
+        {
+            if(planner.Restore(entry.candidate, entry.succeeded, entry.time))
+                checkpoint.evaluated.push_back(entry);
+        }
+    }
+
+    if(!checkpoint.evaluated.empty())
+        MIOPEN_LOG_I("Resuming the search after " << checkpoint.evaluated.size() << " configs");
+}
+
+void SearchCheckpointer::Report(std::size_t candidate, bool succeeded, float time)
+{
+    checkpoint.evaluated.push_back({candidate, succeeded, time});
+    if(interval.count() <= 0.0f)
+        return;
+    const auto now = std::chrono::steady_clock::now();
+    if(now - saved < interval)
+        return;
+    db.Save(checkpoint);
+    saved = now;
+}
+
+void SearchCheckpointer::Finish()
+{
+    if(checkpoint.shards == 1)
+    {
+        db.Remove();
+        return;
+    }
+    checkpoint.done = true;
+    db.Save(checkpoint);
+}
+
+} // namespace solver
+} // namespace miopen
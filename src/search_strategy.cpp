@@ -0,0 +1,557 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/search_strategy.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <utility>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_STRATEGY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_MAX_EVALUATIONS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_TIME_LIMIT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_PATIENCE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_SEED)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_SHARD)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+const char* ToCString(const SearchStrategy strategy)
+{
+    switch(strategy)
+    {
+    case SearchStrategy::Exhaustive: return "EXHAUSTIVE";
+    case SearchStrategy::Random: return "RANDOM";
+    case SearchStrategy::Annealing: return "ANNEALING";
+    case SearchStrategy::Model: return "MODEL";
+    }
+    return "<Unknown>";
+}
+
+SearchStrategy GetSearchStrategy()
+{
+    const char* const p_asciz = miopen::GetStringEnv(MIOPEN_TUNING_STRATEGY{});
+    if(p_asciz == nullptr)
+        return SearchStrategy::Exhaustive;
+    std::string str = p_asciz;
+    for(auto& c : str)
+        c = toupper(static_cast<unsigned char>(c));
+    for(const auto strategy : {SearchStrategy::Exhaustive,
+                               SearchStrategy::Random,
+                               SearchStrategy::Annealing,
+                               SearchStrategy::Model})
+    {
+        if(str == ToCString(strategy))
+            return strategy;
+    }
+    MIOPEN_LOG_NQE("Wrong MIOPEN_TUNING_STRATEGY, using default.");
+    return SearchStrategy::Exhaustive;
+}
+
+/// Parses "shard/shards", e.g. "2/8" for the third of eight shards.
+void GetSearchShard(SearchOptions& options)
+{
+    const char* const p_asciz = miopen::GetStringEnv(MIOPEN_TUNING_SHARD{});
+    if(p_asciz == nullptr)
+        return;
+    char* end          = nullptr;
+    const auto shard   = std::strtoul(p_asciz, &end, 10);
+    const auto p_slash = end;
+    const auto shards  = *p_slash == '/' ? std::strtoul(p_slash + 1, &end, 10) : 0;
+    if(p_slash == p_asciz || *p_slash != '/' || *end != '\0' || shard >= shards)
+    {
+        MIOPEN_LOG_NQE("Wrong MIOPEN_TUNING_SHARD, searching all the configs.");
+        return;
+    }
+    options.shard  = shard;
+    options.shards = shards;
+}
+
+std::vector<std::size_t> GetShuffled(std::size_t size, std::mt19937& rng)
+{
+    auto order = std::vector<std::size_t>(size);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    return order;
+}
+
+std::size_t GetDistance(const std::vector<float>& left, const std::vector<float>& right)
+{
+    const auto common = std::min(left.size(), right.size());
+    auto distance     = std::max(left.size(), right.size()) - common;
+    for(std::size_t i = 0; i < common; ++i)
+    {
+        if(left[i] != right[i])
+            ++distance;
+    }
+    return distance;
+}
+
+} // namespace
+
+class SearchPlanner::Strategy
+{
+    public:
+    explicit Strategy(const std::vector<char>& evaluated_) : evaluated(evaluated_) {}
+    Strategy(const Strategy&) = delete;
+    Strategy& operator=(const Strategy&) = delete;
+    virtual ~Strategy() = default;
+
+    /// Is only called when there are candidates left.
+    virtual std::size_t Pick() = 0;
+    virtual void Update(std::size_t candidate, bool succeeded, float time)
+    {
+        (void)candidate;
+        (void)succeeded;
+        (void)time;
+    }
+
+    protected:
+    bool IsEvaluated(std::size_t i) const { return evaluated[i] != 0; }
+
+    private:
+    const std::vector<char>& evaluated;
+};
+
+namespace {
+
+/// Exhaustive and random searches.
+class OrderedStrategy : public SearchPlanner::Strategy
+{
+    public:
+    OrderedStrategy(const std::vector<char>& evaluated_, std::vector<std::size_t> order_)
+        : Strategy(evaluated_), order(std::move(order_))
+    {
+    }
+
+    std::size_t Pick() override
+    {
+        while(IsEvaluated(order[position]))
+            ++position;
+        return order[position];
+    }
+
+    private:
+    std::vector<std::size_t> order;
+    std::size_t position = 0;
+};
+
+class AnnealingStrategy : public SearchPlanner::Strategy
+{
+    public:
+    AnnealingStrategy(const std::vector<char>& evaluated_,
+                      const std::vector<std::vector<float>>& features_,
+                      unsigned seed)
+        : Strategy(evaluated_),
+          features(features_),
+          rng(seed),
+          random(evaluated_, GetShuffled(features_.size(), rng))
+    {
+    }
+
+    std::size_t Pick() override
+    {
+        if(current == SearchResult::none)
+            return random.Pick();
+
+        // The nearest candidates which have not been evaluated yet.
+        neighbors.clear();
+        auto nearest = std::numeric_limits<std::size_t>::max();
+        for(std::size_t i = 0; i < features.size(); ++i)
+        {
+            if(IsEvaluated(i))
+                continue;
+            const auto distance = GetDistance(features[current], features[i]);
+            if(distance < nearest)
+            {
+                nearest = distance;
+                neighbors.clear();
+            }
+            if(distance == nearest)
+                neighbors.push_back(i);
+        }
+        if(nearest > 1)
+        {
+            // All the neighbors have been tried, so this is a local minimum. Restart from a
+            // random candidate.
+            current     = SearchResult::none;
+            has_current = false;
+            temperature = temperature_max;
+            return random.Pick();
+        }
+        return neighbors[std::uniform_int_distribution<std::size_t>{0, neighbors.size() - 1}(rng)];
+    }
+
+    void Update(std::size_t candidate, bool succeeded, float time) override
+    {
+        if(succeeded)
+        {
+            if(!has_current || time <= current_time ||
+               uniform(rng) < std::exp(-(time / current_time - 1.0f) / temperature))
+            {
+                current      = candidate;
+                current_time = time;
+                has_current  = true;
+            }
+        }
+        else if(!has_current)
+        {
+            current = candidate;
+        }
+        temperature = std::max(temperature * cooling, temperature_min);
+    }
+
+    private:
+    const float cooling         = 0.95f;
+    const float temperature_min = 0.001f;
+    const float temperature_max = 0.1f;
+    /// The relative slowdown which is accepted with probability 1/e.
+    float temperature = temperature_max;
+
+    const std::vector<std::vector<float>>& features;
+    std::mt19937 rng;
+    OrderedStrategy random;
+    std::uniform_real_distribution<float> uniform{0.0f, 1.0f};
+    std::vector<std::size_t> neighbors;
+    /// Stays the first failed candidate until a candidate succeeds.
+    std::size_t current = SearchResult::none;
+    float current_time  = 0.0f;
+    bool has_current    = false;
+};
+
+class ModelStrategy : public SearchPlanner::Strategy
+{
+    public:
+    ModelStrategy(const std::vector<char>& evaluated_,
+                  const std::vector<std::vector<float>>& features_,
+                  const std::vector<std::vector<float>>& tuned,
+                  unsigned seed)
+        : Strategy(evaluated_),
+          features(features_),
+          rng(seed),
+          random(evaluated_, GetShuffled(features_.size(), rng)),
+          has_prior(!tuned.empty()),
+          prior(features_.size(), 0.0),
+          weighted_sum(features_.size(), 0.0),
+          weights(features_.size(), 0.0),
+          fail_weights(features_.size(), 0.0)
+    {
+        const auto n = features.size();
+        for(const auto& f : features)
+            dims = std::max(dims, f.size());
+
+        // Prior: how much a candidate resembles the configs tuned for other problems. Each of
+        // its parameters scores the log-frequency of its value among the tuned configs, smoothed
+        // so that values never seen do not rule a candidate out.
+        for(std::size_t d = 0; d < dims && has_prior; ++d)
+        {
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                const auto value = Feature(i, d);
+                const auto count = std::count_if(tuned.begin(), tuned.end(), [&](auto&& t) {
+                    return d < t.size() && t[d] == value;
+                });
+                prior[i] += std::log((static_cast<double>(count) + 1.0) /
+                                     (static_cast<double>(tuned.size()) + 2.0));
+            }
+        }
+
+        // Parameters are scaled to the same range, so that a step of 1 in a small parameter
+        // weighs the same as a step of 256 in a large one.
+        scale.assign(dims, 1.0f);
+        for(std::size_t d = 0; d < dims; ++d)
+        {
+            auto low  = std::numeric_limits<float>::max();
+            auto high = std::numeric_limits<float>::lowest();
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                low  = std::min(low, Feature(i, d));
+                high = std::max(high, Feature(i, d));
+            }
+            if(high > low)
+                scale[d] = 1.0f / (high - low);
+        }
+    }
+
+    std::size_t Pick() override
+    {
+        const auto n = features.size();
+        auto next    = SearchResult::none;
+        if(!succeeded && has_prior)
+        {
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                if(IsEvaluated(i))
+                    continue;
+                if(next == SearchResult::none || prior[i] > prior[next])
+                    next = i;
+            }
+            return next;
+        }
+        if(!succeeded || uniform(rng) < explore)
+            return random.Pick();
+
+        const auto penalty = worst + std::log(2.0);
+        auto best          = std::numeric_limits<double>::max();
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            if(IsEvaluated(i))
+                continue;
+            const auto estimate =
+                (weighted_sum[i] + fail_weights[i] * penalty) / (weights[i] + fail_weights[i]);
+            if(estimate < best || (estimate == best && prior[i] > prior[next]))
+            {
+                best = estimate;
+                next = i;
+            }
+        }
+        return next;
+    }
+
+    /// Updates the inverse distance weighted estimates of the log-time of the candidates. Failed
+    /// candidates count as slower than the slowest one measured.
+    void Update(std::size_t candidate, bool success, float time) override
+    {
+        const auto log_time = success ? std::log(std::max(static_cast<double>(time), 1e-9)) : 0.0;
+        if(success)
+        {
+            succeeded = true;
+            worst     = std::max(worst, log_time);
+        }
+
+        for(std::size_t i = 0; i < features.size(); ++i)
+        {
+            if(IsEvaluated(i))
+                continue;
+            auto distance = 0.0;
+            for(std::size_t d = 0; d < dims; ++d)
+            {
+                const auto delta = (Feature(i, d) - Feature(candidate, d)) * scale[d];
+                distance += delta * delta;
+            }
+            const auto weight = 1.0 / (distance + 1e-6);
+            if(success)
+            {
+                weighted_sum[i] += weight * log_time;
+                weights[i] += weight;
+            }
+            else
+            {
+                fail_weights[i] += weight;
+            }
+        }
+    }
+
+    private:
+    /// Share of the evaluations spent on random candidates, so that the search does not get
+    /// stuck in the region of the first good candidates.
+    const float explore = 0.1f;
+
+    const std::vector<std::vector<float>>& features;
+    std::mt19937 rng;
+    OrderedStrategy random;
+    std::uniform_real_distribution<float> uniform{0.0f, 1.0f};
+    bool has_prior;
+    bool succeeded = false;
+    std::size_t dims = 0;
+    std::vector<float> scale;
+    std::vector<double> prior;
+    std::vector<double> weighted_sum;
+    std::vector<double> weights;
+    std::vector<double> fail_weights;
+    double worst = std::numeric_limits<double>::lowest();
+
+    float Feature(std::size_t i, std::size_t d) const
+    {
+        return d < features[i].size() ? features[i][d] : 0.0f;
+    }
+};
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const SearchStrategy strategy)
+{
+    return os << ToCString(strategy);
+}
+
+SearchOptions GetSearchOptions()
+{
+    auto options                = SearchOptions{};
+    options.strategy            = GetSearchStrategy();
+    options.budget.evaluations  = Value(MIOPEN_TUNING_MAX_EVALUATIONS{});
+    options.budget.patience     = Value(MIOPEN_TUNING_PATIENCE{});
+    options.seed                = Value(MIOPEN_TUNING_SEED{});
+    const char* const p_seconds = GetStringEnv(MIOPEN_TUNING_TIME_LIMIT{});
+    if(p_seconds != nullptr)
+        options.budget.seconds = std::strtof(p_seconds, nullptr);
+    GetSearchShard(options);
+    return options;
+}
+
+std::vector<float> GetConfigFeatures(const std::string& serialized)
+{
+    auto features = std::vector<float>{};
+    const char* p = serialized.c_str();
+    while(*p != '\0')
+    {
+        if(std::isdigit(static_cast<unsigned char>(*p)) == 0)
+        {
+            ++p;
+            continue;
+        }
+        char* end = nullptr;
+        features.push_back(std::strtof(p, &end));
+        p = end;
+    }
+    return features;
+}
+
+SearchPlanner::SearchPlanner(const SearchOptions& options_,
+                             std::vector<std::vector<float>> features_,
+                             std::vector<std::vector<float>> tuned_)
+    : options(options_),
+      features(std::move(features_)),
+      tuned(std::move(tuned_)),
+      evaluated(features.size(), 0),
+      start(std::chrono::steady_clock::now())
+{
+    if(options.shards == 0)
+        MIOPEN_THROW("Wrong number of search shards");
+    for(std::size_t i = 0; i < features.size(); ++i)
+    {
+        // The candidates of the other shards are never picked.
+        if(i % options.shards != options.shard)
+            evaluated[i] = 1;
+        else
+            ++available;
+    }
+
+    switch(options.strategy)
+    {
+    case SearchStrategy::Exhaustive:
+    {
+        auto order = std::vector<std::size_t>(features.size());
+        std::iota(order.begin(), order.end(), 0);
+        strategy = std::make_unique<OrderedStrategy>(evaluated, std::move(order));
+    }
+    break;
+    case SearchStrategy::Random:
+    {
+        auto rng = std::mt19937{options.seed};
+        strategy = std::make_unique<OrderedStrategy>(evaluated, GetShuffled(features.size(), rng));
+    }
+    break;
+    case SearchStrategy::Annealing:
+        strategy = std::make_unique<AnnealingStrategy>(evaluated, features, options.seed);
+        break;
+    case SearchStrategy::Model:
+        strategy = std::make_unique<ModelStrategy>(evaluated, features, tuned, options.seed);
+        break;
+    }
+    if(!strategy)
+        MIOPEN_THROW("Unknown search strategy");
+}
+
+SearchPlanner::~SearchPlanner() = default;
+
+bool SearchPlanner::Next(std::size_t& candidate)
+{
+    const auto& budget = options.budget;
+    if(issued == available)
+        return false;
+    if(budget.evaluations != 0 && issued >= budget.evaluations)
+        return false;
+    if(budget.patience != 0 && since_best >= budget.patience)
+        return false;
+    if(budget.seconds > 0.0f)
+    {
+        const auto elapsed =
+            std::chrono::duration<float>(std::chrono::steady_clock::now() - start);
+        if(elapsed.count() >= budget.seconds)
+            return false;
+    }
+
+    candidate            = strategy->Pick();
+    evaluated[candidate] = 1;
+    ++issued;
+    return true;
+}
+
+void SearchPlanner::Report(std::size_t candidate, bool succeeded, float time)
+{
+    ++result.evaluated;
+    ++since_best;
+    if(!succeeded)
+        ++result.failed;
+    else if(time < result.best_time)
+    {
+        result.best      = candidate;
+        result.best_time = time;
+        since_best       = 0;
+    }
+    strategy->Update(candidate, succeeded, time);
+}
+
+bool SearchPlanner::Restore(std::size_t candidate, bool succeeded, float time)
+{
+    if(candidate >= features.size() || evaluated[candidate] != 0)
+        return false;
+    evaluated[candidate] = 1;
+    ++issued;
+    Report(candidate, succeeded, time);
+    return true;
+}
+
+const SearchResult& SearchPlanner::GetResult() const { return result; }
+
+SearchResult RunSearch(const SearchOptions& options,
+                       const std::vector<std::vector<float>>& features,
+                       const std::vector<std::vector<float>>& tuned,
+                       const SearchMeasure& measure)
+{
+    SearchPlanner planner{options, features, tuned};
+    std::size_t candidate;
+    while(planner.Next(candidate))
+    {
+        auto time            = 0.0f;
+        const auto succeeded = measure(candidate, time);
+        planner.Report(candidate, succeeded, time);
+    }
+    return planner.GetResult();
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,284 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/solution_ranker.hpp>
+
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <sstream>
+
+namespace miopen {
+
+namespace {
+
+/// Assumed device throughput. Only their ratio matters, as the absolute scale cancels out in the
+/// estimates.
+const double peak_flops_per_ms = 1e10;
+const double peak_bytes_per_ms = 5e8;
+/// Neighbours each estimate is averaged over.
+const std::size_t neighbours = 5;
+/// Keeps the nearest neighbours from dominating the average completely.
+const double distance_offset = 0.1;
+/// Filter sizes and strides decide which algorithms are efficient, so they weigh more.
+const double shape_weight = 2.0;
+
+std::vector<std::string> Split(const std::string& s, char sep)
+{
+    std::vector<std::string> tokens;
+    std::istringstream ss(s);
+    std::string token;
+    while(std::getline(ss, token, sep))
+        tokens.push_back(token);
+    return tokens;
+}
+
+/// Reads `count` non-negative integers separated by `sep`.
+bool ParseNumbers(const std::string& token, char sep, std::size_t count, std::vector<double>& out)
+{
+    const char* p = token.c_str();
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        if(i != 0)
+        {
+            if(*p != sep)
+                return false;
+            ++p;
+        }
+        char* end        = nullptr;
+        const auto value = std::strtol(p, &end, 10);
+        if(end == p || value < 0)
+            return false;
+        out.push_back(static_cast<double>(value));
+        p = end;
+    }
+    return *p == '\0';
+}
+
+double Product(const std::vector<double>& values, std::size_t first, std::size_t count)
+{
+    return std::accumulate(values.begin() + first,
+                           values.begin() + first + count,
+                           1.0,
+                           std::multiplies<double>{});
+}
+
+std::size_t GetElementSize(const std::string& types)
+{
+    if(StartsWith(types, "FP16") || StartsWith(types, "BF16"))
+        return 2;
+    if(StartsWith(types, "INT8"))
+        return 1;
+    return 4;
+}
+
+struct Neighbour
+{
+    double distance;
+    double log_ratio;
+};
+
+} // namespace
+
+bool ConvShape::Parse(const std::string& key, ConvShape& shape)
+{
+    // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F[_g2], with 3 spatial dimensions for 3D.
+    const auto tokens = Split(key, '-');
+    if(tokens.size() != 15 && tokens.size() != 17)
+        return false;
+    const std::size_t dims = tokens.size() == 15 ? 2 : 3;
+
+    // in_c, in_spatial, filter, out_c, out_spatial, n, pads, strides, dilations
+    std::vector<double> v;
+    auto t = std::size_t{0};
+    if(!ParseNumbers(tokens[t++], '-', 1, v))
+        return false;
+    for(std::size_t i = 0; i < dims; ++i)
+        if(!ParseNumbers(tokens[t++], '-', 1, v))
+            return false;
+    if(!ParseNumbers(tokens[t++], 'x', dims, v) || !ParseNumbers(tokens[t++], '-', 1, v))
+        return false;
+    for(std::size_t i = 0; i < dims; ++i)
+        if(!ParseNumbers(tokens[t++], '-', 1, v))
+            return false;
+    if(!ParseNumbers(tokens[t++], '-', 1, v))
+        return false;
+    for(std::size_t i = 0; i < 3; ++i)
+        if(!ParseNumbers(tokens[t++], 'x', dims, v))
+            return false;
+    ++t; // bias
+
+    const auto& layout    = tokens[t++];
+    const auto& types     = tokens[t++];
+    const auto& direction = tokens[t++];
+    if(direction.empty() || std::string{"FBW"}.find(direction[0]) == std::string::npos)
+        return false;
+    auto groups = 1.0;
+    if(direction.size() > 1)
+    {
+        std::vector<double> g;
+        if(!StartsWith(direction.substr(1), "_g") ||
+           !ParseNumbers(direction.substr(3), '-', 1, g) || g[0] == 0)
+            return false;
+        groups = g[0];
+    }
+
+    const auto in_c        = v[0];
+    const auto in_spatial  = Product(v, 1, dims);
+    const auto filter      = Product(v, 1 + dims, dims);
+    const auto out_c       = v[1 + 2 * dims];
+    const auto out_spatial = Product(v, 2 + 2 * dims, dims);
+    const auto n           = v[2 + 3 * dims];
+
+    // Backward data problems are keyed by the output of the forward convolution first. Either
+    // way, the smaller of the spatial sizes is that output.
+    const auto weights = in_c * out_c / groups * filter;
+    const auto flops   = 2.0 * n * weights * std::min(in_spatial, out_spatial);
+    const auto bytes =
+        (n * in_c * in_spatial + n * out_c * out_spatial + weights) * GetElementSize(types);
+
+    shape.kind     = std::to_string(dims) + '-' + layout + '-' + types + '-' + direction[0];
+    shape.roofline = std::max(flops / peak_flops_per_ms, bytes / peak_bytes_per_ms);
+    shape.features.clear();
+    for(std::size_t i = 0; i < v.size(); ++i)
+    {
+        const auto is_filter = i >= 1 + dims && i < 1 + 2 * dims;
+        const auto is_stride = i >= 3 + 4 * dims && i < 3 + 5 * dims;
+        shape.features.push_back(std::log2(1.0 + v[i]) *
+                                 (is_filter || is_stride ? shape_weight : 1.0));
+    }
+    shape.features.push_back(std::log2(groups));
+    return true;
+}
+
+double ConvShape::Distance(const ConvShape& other) const
+{
+    auto sum = 0.0;
+    for(std::size_t i = 0; i < features.size() && i < other.features.size(); ++i)
+        sum += (features[i] - other.features[i]) * (features[i] - other.features[i]);
+    return std::sqrt(sum);
+}
+
+bool SolutionRanker::Add(const std::string& key, std::vector<std::pair<std::string, float>> times)
+{
+    auto sample = Sample{key, {}, std::move(times)};
+    if(!ConvShape::Parse(key, sample.shape))
+        return false;
+    samples.push_back(std::move(sample));
+    return true;
+}
+
+std::size_t SolutionRanker::Load(const std::string& path)
+{
+    auto added = std::size_t{0};
+    for(const auto& record : PlainTextDb{path, true}.ExportRecords())
+    {
+        std::vector<std::pair<std::string, float>> times;
+        for(const auto& pair : record.As<FindDbData>())
+            times.emplace_back(pair.second.solver_id, pair.second.time);
+        if(Add(record.GetKey(), std::move(times)))
+            ++added;
+    }
+    return added;
+}
+
+std::vector<RankedSolution> SolutionRanker::Rank(const std::string& key,
+                                                 const std::vector<std::string>& candidates,
+                                                 const std::string& exclude) const
+{
+    std::vector<RankedSolution> ranked;
+    ConvShape shape;
+    if(!ConvShape::Parse(key, shape))
+    {
+        for(const auto& candidate : candidates)
+            ranked.push_back({candidate, -1.0f});
+        return ranked;
+    }
+
+    // The nearest problems each candidate was measured on, nearest first.
+    std::vector<std::vector<Neighbour>> nearest(candidates.size());
+    for(const auto& sample : samples)
+    {
+        if(sample.shape.kind != shape.kind || sample.key == exclude)
+            continue;
+
+        const auto distance = shape.Distance(sample.shape);
+        for(const auto& time : sample.times)
+        {
+            const auto candidate = std::find(candidates.begin(), candidates.end(), time.first);
+            if(candidate == candidates.end() || !(time.second > 0.0f))
+                continue;
+
+            auto& list        = nearest[candidate - candidates.begin()];
+            const auto ratio  = std::log(time.second / sample.shape.roofline);
+            const auto insert = std::find_if(list.begin(), list.end(), [&](const Neighbour& n) {
+                return n.distance > distance;
+            });
+            if(insert == list.end() && list.size() >= neighbours)
+                continue;
+            list.insert(insert, Neighbour{distance, ratio});
+            if(list.size() > neighbours)
+                list.pop_back();
+        }
+    }
+
+    auto slowest = 0.0f;
+    for(std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        if(nearest[i].empty())
+            continue;
+        auto weights = 0.0;
+        auto ratio   = 0.0;
+        for(const auto& neighbour : nearest[i])
+        {
+            const auto weight = 1.0 / (neighbour.distance + distance_offset);
+            weights += weight;
+            ratio += weight * neighbour.log_ratio;
+        }
+        const auto time = static_cast<float>(shape.roofline * std::exp(ratio / weights));
+        slowest         = std::max(slowest, time);
+        ranked.push_back({candidates[i], time});
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto& left, const auto& right) {
+        return left.time < right.time;
+    });
+
+    // Nothing is known about the rest, except that they are applicable.
+    const auto unknown =
+        slowest > 0.0f ? 2.0f * slowest : static_cast<float>(shape.roofline);
+    for(std::size_t i = 0; i < candidates.size(); ++i)
+        if(nearest[i].empty())
+            ranked.push_back({candidates[i], unknown});
+    return ranked;
+}
+
+} // namespace miopen
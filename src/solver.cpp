@@ -28,14 +28,18 @@
 #include <miopen/conv_algo_name.hpp>
 
 #include <miopen/db.hpp>
+#include <miopen/errors.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/par_for.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/any_solver.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <ostream>
+#include <set>
+#include <utility>
 
 namespace miopen {
 namespace solver {
@@ -55,6 +59,8 @@ std::ostream& operator<<(std::ostream& os, const KernelInfo& k)
 
 std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels)
 {
+    MIOPEN_TRACE_SPAN_DETAIL(
+        "compile", "PrecompileKernels", std::to_string(kernels.size()) + " kernels");
     CompileTimer ct;
     std::vector<Program> programs(kernels.size());
 
@@ -74,6 +80,7 @@ void PrecompileSolutions(const Handle& h, const std::vector<ConvSolution>& sols)
 {
     // Find all kernels that need to be compiled from the solutions
     std::vector<KernelInfo> kernels;
+    std::set<std::pair<std::string, std::string>> seen;
     for(auto&& sol : sols)
     {
         if(!sol.Succeeded())
@@ -82,21 +89,69 @@ void PrecompileSolutions(const Handle& h, const std::vector<ConvSolution>& sols)
         {
             if(h.HasProgram(kernel.kernel_file, kernel.comp_options))
                 continue;
+            if(!seen.emplace(kernel.kernel_file, kernel.comp_options).second)
+                continue;
             kernels.push_back(kernel);
         }
     }
 
+    // Take whatever the binary cache has with a single lookup and compile the rest only
+    std::vector<std::pair<std::string, std::string>> names;
+    names.reserve(kernels.size());
+    for(const auto& k : kernels)
+        names.emplace_back(k.kernel_file, k.comp_options);
+    const auto cached = h.LoadCachedPrograms(names);
+
+    std::vector<KernelInfo> uncached;
+    for(std::size_t i = 0; i < kernels.size(); i++)
+    {
+        if(cached[i])
+            h.AddProgram(cached[i].get(), kernels[i].kernel_file, kernels[i].comp_options);
+        else
+            uncached.push_back(kernels[i]);
+    }
+    MIOPEN_LOG_I2(kernels.size() - uncached.size() << " of " << kernels.size()
+                                                   << " programs loaded from the binary cache");
+
     // Precompile the kernels in parallel, but dont add them to the cache
-    std::vector<Program> programs = PrecompileKernels(h, kernels);
+    std::vector<Program> programs = PrecompileKernels(h, uncached);
 
     // Add programs to the cache
     for(std::size_t i = 0; i < programs.size(); i++)
     {
-        const KernelInfo& k = kernels[i];
+        const KernelInfo& k = uncached[i];
         h.AddProgram(programs[i], k.kernel_file, k.comp_options);
     }
 }
 
+SolutionPrograms BuildSolutionPrograms(const Handle& h, const ConvSolution& s)
+{
+    SolutionPrograms built;
+    for(const auto& k : s.construction_params)
+    {
+        try
+        {
+            built.programs.push_back(h.LoadProgram(k.kernel_file, k.comp_options, false, ""));
+            built.kernels.push_back(k);
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_I2("Failed to build " << k.kernel_file << " ahead: " << ex.what());
+        }
+    }
+    return built;
+}
+
+void AddSolutionPrograms(const Handle& h, const SolutionPrograms& built)
+{
+    for(std::size_t i = 0; i < built.programs.size(); i++)
+    {
+        const KernelInfo& k = built.kernels[i];
+        if(!h.HasProgram(k.kernel_file, k.comp_options))
+            h.AddProgram(built.programs[i], k.kernel_file, k.comp_options);
+    }
+}
+
 std::ostream& operator<<(std::ostream& os, const ConvSolution& s)
 {
     auto strings =
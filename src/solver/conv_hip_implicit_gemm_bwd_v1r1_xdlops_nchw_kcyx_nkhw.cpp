@@ -718,6 +718,42 @@ PerformanceImplicitGemmBwdV1R1Xdlops::CalculateLdsNumberOfByte(const Convolution
     return std::make_tuple(lds_size, true);
 }
 
+KernelModel
+PerformanceImplicitGemmBwdV1R1Xdlops::GetKernelModel(const ConvolutionContext& ctx) const
+{
+    int gemm_m = 0;
+    int gemm_n = 0;
+    std::tie(std::ignore, gemm_m, gemm_n, std::ignore) =
+        ConvHipImplicitGemmBwdDataV1R1Xdlops::CalculateGemmSize(ctx);
+
+    int block_size        = 0;
+    int grid_size         = 0;
+    std::size_t lds_size  = 0;
+    bool valid_block_size = false;
+    bool valid_grid_size  = false;
+    bool valid_lds_size   = false;
+    std::tie(block_size, valid_block_size) = CalculateBlockSize();
+    std::tie(grid_size, valid_grid_size)   = CalculateGridSize(ctx);
+    std::tie(lds_size, valid_lds_size)     = CalculateLdsNumberOfByte(ctx);
+
+    if(!valid_block_size || !valid_grid_size || !valid_lds_size)
+        return {};
+
+    auto model = GetBlockwiseGemmModel(gemm_m,
+                                       gemm_n,
+                                       GemmMPerBlock,
+                                       GemmNPerBlock,
+                                       GemmKPerBlock * GemmKPack,
+                                       block_size,
+                                       grid_size,
+                                       lds_size,
+                                       ctx.IsFp32() ? sizeof(float) : sizeof(half_float::half));
+
+    // Each wave accumulates its GemmMPerWave x GemmNPerWave tile in AGPRs.
+    model.acc_vgprs = GemmMPerWave * GemmNPerWave / 64;
+    return model;
+}
+
 std::size_t
 ConvHipImplicitGemmBwdDataV1R1Xdlops::GetWorkspaceSize(const ConvolutionContext& ctx) const
 {
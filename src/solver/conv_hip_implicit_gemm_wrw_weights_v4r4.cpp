@@ -412,6 +412,38 @@ PerformanceImplicitGemmV4R4WrW::CalculateLdsNumberOfByte(const ConvolutionContex
     return std::make_tuple(lds_size, true);
 }
 
+KernelModel PerformanceImplicitGemmV4R4WrW::GetKernelModel(const ConvolutionContext& ctx) const
+{
+    int gemm_m = 0;
+    int gemm_n = 0;
+    std::tie(gemm_m, gemm_n, std::ignore) = ConvHipImplicitGemmV4R4WrW::CalculateGemmSize(ctx);
+
+    int grid_size        = 0;
+    std::size_t lds_size = 0;
+    bool valid_grid_size = false;
+    bool valid_lds_size  = false;
+    std::tie(grid_size, valid_grid_size) = CalculateGridSize(ctx);
+    std::tie(lds_size, valid_lds_size)   = CalculateLdsNumberOfByte(ctx);
+
+    if(!valid_grid_size || !valid_lds_size)
+        return {};
+
+    auto model = GetBlockwiseGemmModel(gemm_m,
+                                       gemm_n,
+                                       GemmMPerBlock,
+                                       GemmNPerBlock,
+                                       GemmKPerBlock,
+                                       BlockSize,
+                                       grid_size,
+                                       lds_size,
+                                       sizeof(float));
+
+    // Thread tile of C, plus the double-buffered A and B fragments read from LDS.
+    model.vgprs += GemmMPerBlock * GemmNPerBlock / BlockSize +
+                   2 * 2 * (GemmMPerThread + GemmNPerThread);
+    return model;
+}
+
 bool PerformanceImplicitGemmV4R4WrW::IsValidValue() const
 {
     // clang-format off
@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <miopen/sqlite_db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -50,12 +51,16 @@
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 extern "C" {
 int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_routines* pApi);
 }
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SQLITE_STATEMENT_CACHE)
+
 class SQLite::impl
 {
     struct SQLiteCloser
@@ -174,8 +179,52 @@ class SQLite::impl
         isValid = (rc == 0);
     }
 
+    using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
+
+    /// Takes an idle prepared statement for the query out of the cache. Returns nullptr on miss.
+    sqlite3_stmt_ptr TakeStatement(const std::string& query)
+    {
+        std::lock_guard<std::mutex> lock(statements_mutex);
+        const auto it = statements.find(query);
+        if(it == statements.end() || it->second.empty())
+            return nullptr;
+        auto stmt = std::move(it->second.back());
+        it->second.pop_back();
+        return stmt;
+    }
+
+    /// Resets the statement and keeps it for the next query of the same shape. Statements that
+    /// do not fit into the cache are finalized.
+    void ReturnStatement(const std::string& query, sqlite3_stmt_ptr stmt)
+    {
+        if(miopen::IsDisabled(MIOPEN_DEBUG_SQLITE_STATEMENT_CACHE{}))
+            return;
+        sqlite3_reset(stmt.get());
+        sqlite3_clear_bindings(stmt.get());
+
+        std::lock_guard<std::mutex> lock(statements_mutex);
+        auto it = statements.find(query);
+        if(it == statements.end())
+        {
+            if(statements.size() >= max_cached_queries)
+                return;
+            it = statements.emplace(query, std::vector<sqlite3_stmt_ptr>{}).first;
+        }
+        if(it->second.size() < max_idle_statements_per_query)
+            it->second.push_back(std::move(stmt));
+    }
+
     sqlite3_ptr ptrDb = nullptr;
     bool isValid;
+
+    private:
+    static constexpr std::size_t max_cached_queries            = 64;
+    static constexpr std::size_t max_idle_statements_per_query = 16;
+
+    // Declared after ptrDb so that cached statements are finalized before the connection is
+    // closed.
+    std::mutex statements_mutex;
+    std::unordered_map<std::string, std::vector<sqlite3_stmt_ptr>> statements;
 };
 
 static int find_callback(void* _res, int argc, char** argv, char** azColName)
@@ -242,11 +291,15 @@ bool SQLite::Valid() const { return pImpl->isValid; }
 
 class SQLite::Statement::impl
 {
-    using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
+    using sqlite3_stmt_ptr = SQLite::impl::sqlite3_stmt_ptr;
     sqlite3_stmt_ptr Prepare(const SQLite& sql, const std::string& query)
     {
-        sqlite3_stmt* ptr = nullptr;
         MIOPEN_LOG_I2(query);
+        auto cached = connection->TakeStatement(query);
+        if(cached != nullptr)
+            return cached;
+
+        sqlite3_stmt* ptr = nullptr;
         auto rc =
             sqlite3_prepare_v2(sql.pImpl->ptrDb.get(), query.c_str(), query.size(), &ptr, nullptr);
         if(rc != SQLITE_OK)
@@ -258,8 +311,12 @@ class SQLite::Statement::impl
     }
 
     public:
-    impl(const SQLite& sql, const std::string& query) { ptrStmt = Prepare(sql, query); }
+    impl(const SQLite& sql, const std::string& query) : connection(sql.pImpl.get()), key(query)
+    {
+        ptrStmt = Prepare(sql, query);
+    }
     impl(const SQLite& sql, const std::string& query, const std::vector<std::string>& vals)
+        : connection(sql.pImpl.get()), key(query)
     {
         ptrStmt = Prepare(sql, query);
         int cnt = 1;
@@ -273,6 +330,20 @@ class SQLite::Statement::impl
         MIOPEN_LOG_I2("[" << JoinStrings(vals, ",") << "]");
     }
 
+    ~impl()
+    {
+        if(ptrStmt != nullptr)
+            connection->ReturnStatement(key, std::move(ptrStmt));
+    }
+
+    impl(const impl&) = delete;
+    impl& operator=(const impl&) = delete;
+
+    private:
+    SQLite::impl* connection;
+    std::string key;
+
+    public:
     sqlite3_stmt_ptr ptrStmt = nullptr;
 };
 
@@ -421,4 +492,120 @@ SQLitePerfDb::SQLitePerfDb(const std::string& filename_,
         }
     }
 }
+
+bool SQLitePerfDb::ImportRecords(const std::string& source_path)
+{
+    if(dbInvalid)
+        return false;
+
+    ProblemDescription prob_desc{conv::Direction::Forward};
+    const auto fields = prob_desc.FieldNames();
+    auto matches      = std::vector<std::string>{};
+    for(const auto& field : fields)
+        matches.push_back("(dst." + field + " = src." + field + ")");
+
+    // clang-format off
+    const auto import_configs =
+        "INSERT OR IGNORE INTO main." + ProblemDescription::table_name() + "(" +
+            JoinStrings(fields, ",") + ") "
+        "SELECT " + JoinStrings(fields, ",") + " FROM source." +
+            ProblemDescription::table_name() + ";";
+    const auto import_perf =
+        "INSERT OR REPLACE INTO main.perf_db(config, solver, arch, num_cu, params) "
+        "SELECT dst.id, perf.solver, perf.arch, perf.num_cu, perf.params "
+        "FROM source.perf_db AS perf "
+        "INNER JOIN source." + ProblemDescription::table_name() + " AS src "
+        "ON perf.config = src.id "
+        "INNER JOIN main." + ProblemDescription::table_name() + " AS dst "
+        "ON " + JoinStrings(matches, " AND ") + ";";
+    // clang-format on
+
+    MIOPEN_LOG_I("Importing records from " << source_path << " into " << filename);
+
+    if(!boost::filesystem::exists(source_path))
+    {
+        MIOPEN_LOG_E("Database not found: " << source_path);
+        return false;
+    }
+
+    // Statements are not cached here: they refer to a schema that is detached afterwards.
+    try
+    {
+        sql.Exec("ATTACH DATABASE '" + ReplaceString(source_path, "'", "''") + "' AS source;");
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_E("Unable to open database " << source_path << ": " << ex.what());
+        return false;
+    }
+
+    auto success = false;
+    try
+    {
+        const auto tables = sql.Exec("SELECT name FROM source.sqlite_master WHERE type = 'table' "
+                                     "AND (name = '" +
+                                     ProblemDescription::table_name() + "' OR name = 'perf_db');");
+        if(tables.size() != 2)
+        {
+            MIOPEN_LOG_E("Not a performance database: " << source_path);
+        }
+        else
+        {
+            sql.Exec("BEGIN IMMEDIATE TRANSACTION;");
+            try
+            {
+                sql.Exec(import_configs);
+                sql.Exec(import_perf);
+                const auto imported = sql.Changes();
+                sql.Exec("COMMIT TRANSACTION;");
+                MIOPEN_LOG_I(imported << " performance records imported from " << source_path);
+                success = true;
+            }
+            catch(const Exception&)
+            {
+                sql.Exec("ROLLBACK TRANSACTION;");
+                throw;
+            }
+        }
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_E("Unable to import records from " << source_path << ": " << ex.what());
+    }
+
+    sql.Exec("DETACH DATABASE source;");
+    return success;
+}
+
+std::vector<std::string> SQLitePerfDb::FindValues(const std::string& id)
+{
+    auto values = std::vector<std::string>{};
+    if(dbInvalid)
+        return values;
+    const auto query = "SELECT params FROM perf_db "
+                       "WHERE (solver = ?) AND (arch = ?) AND (num_cu = ?);";
+    auto stmt = SQLite::Statement{sql, query, {id, arch, std::to_string(num_cu)}};
+    while(true)
+    {
+        const auto rc = stmt.Step(sql);
+        if(rc == SQLITE_ROW)
+            values.push_back(stmt.ColumnText(0));
+        else if(rc == SQLITE_DONE)
+            break;
+        else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+    return values;
+}
+
+bool SQLitePerfDb::ExportRecords(const std::string& target_path) const
+{
+    if(dbInvalid)
+        return false;
+    if(boost::filesystem::equivalent(filename, target_path))
+        return true;
+
+    auto target = SQLitePerfDb{target_path, false, arch, num_cu};
+    return target.ImportRecords(filename);
+}
 } // namespace miopen
@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/thread_pool.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace miopen {
+
+namespace {
+constexpr auto not_a_worker = std::numeric_limits<std::size_t>::max();
+
+// Lets tasks submitted from a worker go to the queue of that worker.
+thread_local std::size_t current_worker = not_a_worker; // NOLINT
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t size)
+{
+    assert(size > 0);
+    queues.reserve(size);
+    for(std::size_t i = 0; i < size; ++i)
+        queues.emplace_back(std::make_unique<Queue>());
+    threads.reserve(size);
+    for(std::size_t i = 0; i < size; ++i)
+        threads.emplace_back([this, i]() { Work(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cond.notify_all();
+    for(auto& thread : threads)
+        thread.join();
+}
+
+ThreadPool& ThreadPool::Get()
+{
+    // The thread calling par_for() also does a share of the work.
+    static ThreadPool pool{std::max(std::thread::hardware_concurrency(), 2u) - 1};
+    return pool;
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+    std::size_t id = current_worker;
+    if(id == not_a_worker || id >= queues.size())
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        id = next++ % queues.size();
+    }
+
+    {
+        auto& queue = *queues[id];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++pending;
+    }
+    cond.notify_one();
+}
+
+std::function<void()> ThreadPool::Pop(std::size_t id)
+{
+    // The own queue is used as a stack to keep nested loops local, stealing takes the oldest task.
+    for(std::size_t i = 0; i < queues.size(); ++i)
+    {
+        auto& queue = *queues[(id + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(queue.tasks.empty())
+            continue;
+        std::function<void()> task;
+        if(i == 0)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        return task;
+    }
+    return {};
+}
+
+void ThreadPool::Work(std::size_t id)
+{
+    current_worker = id;
+
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&]() { return stop || pending > 0; });
+            if(pending == 0)
+                return;
+            --pending;
+        }
+
+        // A task is counted in pending only after it has been queued, so one is there to take.
+        auto task = Pop(id);
+        while(!task)
+        {
+            std::this_thread::yield();
+            task = Pop(id);
+        }
+        task();
+    }
+}
+
+} // namespace miopen
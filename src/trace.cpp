@@ -0,0 +1,424 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/trace.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace miopen {
+namespace trace {
+
+/// Enables tracing and names the file the trace is written to at exit.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE)
+
+/// Maximum number of events kept per thread. The oldest events are overwritten first.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_BUFFER_SIZE)
+
+namespace {
+
+struct Event
+{
+    const char* category;
+    const char* name;
+    std::string args;
+    std::uint64_t start;
+    std::uint64_t duration;
+    std::size_t tid;
+};
+
+/// Events are appended to blocks which are written once and never reused, so a block can be read
+/// by another thread while its owner appends to it: the owner publishes each event by a release
+/// store of the block size. Appending takes no lock, only starting a new block does.
+struct Block
+{
+    static constexpr std::size_t capacity = 256;
+
+    std::array<Event, capacity> events;
+    std::atomic<std::size_t> size{0};
+};
+
+/// Buffers are owned by the registry and lent to threads, and a thread returns its buffer at
+/// exit. This keeps the events of finished threads and bounds the number of buffers by the
+/// number of threads alive at once, however many threads are started over time.
+struct Buffer
+{
+    /// Guards blocks and skipped, but not the contents of the blocks.
+    std::mutex mutex;
+    /// Oldest first. Readers take copies, so blocks dropped meanwhile stay alive until they finish.
+    std::deque<std::shared_ptr<Block>> blocks;
+    /// Events of the oldest block dropped by Clear().
+    std::size_t skipped = 0;
+    /// The last block, only used by the thread which holds the buffer.
+    Block* current = nullptr;
+};
+
+class Registry
+{
+    public:
+    Registry() : capacity(std::max<std::size_t>(Value(MIOPEN_TRACE_BUFFER_SIZE{}, 16384), 1))
+    {
+    }
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    Buffer* Acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!spare.empty())
+        {
+            const auto buffer = spare.back();
+            spare.pop_back();
+            return buffer;
+        }
+        buffers.push_back(std::make_unique<Buffer>());
+        return buffers.back().get();
+    }
+
+    void Release(Buffer* buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        spare.push_back(buffer);
+    }
+
+    std::size_t NextThreadId()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ++threads;
+    }
+
+    /// Only called by the thread which holds the buffer.
+    void Append(Buffer& buffer, Event&& event) const
+    {
+        auto size = Block::capacity;
+        if(buffer.current != nullptr)
+            size = buffer.current->size.load(std::memory_order_relaxed);
+        if(size == Block::capacity)
+        {
+            NewBlock(buffer);
+            size = 0;
+        }
+        buffer.current->events[size] = std::move(event);
+        buffer.current->size.store(size + 1, std::memory_order_release);
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(const auto& buffer : buffers)
+        {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            if(buffer->blocks.empty())
+                continue;
+            // The owner may still be appending to the last block.
+            buffer->blocks.erase(buffer->blocks.begin(), buffer->blocks.end() - 1);
+            buffer->skipped = buffer->blocks.back()->size.load(std::memory_order_acquire);
+        }
+    }
+
+    std::vector<Event> Collect()
+    {
+        std::vector<Event> events;
+        std::lock_guard<std::mutex> lock(mutex);
+        for(const auto& buffer : buffers)
+        {
+            auto blocks  = std::deque<std::shared_ptr<Block>>{};
+            auto skipped = std::size_t{0};
+            {
+                std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+                blocks  = buffer->blocks;
+                skipped = buffer->skipped;
+            }
+
+            auto sizes = std::vector<std::size_t>{};
+            auto total = std::size_t{0};
+            for(const auto& block : blocks)
+            {
+                sizes.push_back(block->size.load(std::memory_order_acquire));
+                total += sizes.back();
+            }
+            // Keeps the newest capacity events, as a ring buffer would.
+            auto drop = std::max(skipped, total > capacity ? total - capacity : 0);
+            for(std::size_t i = 0; i < blocks.size(); ++i)
+            {
+                const auto first = std::min(drop, sizes[i]);
+                drop -= first;
+                events.insert(events.end(),
+                              blocks[i]->events.begin() + first,
+                              blocks[i]->events.begin() + sizes[i]);
+            }
+        }
+        return events;
+    }
+
+    private:
+    const std::size_t capacity;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    std::vector<Buffer*> spare;
+    std::size_t threads = 0;
+
+    void NewBlock(Buffer& buffer) const
+    {
+        auto block = std::make_shared<Block>();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.current = block.get();
+        buffer.blocks.push_back(std::move(block));
+        // Drops the oldest block once the others hold enough events without it.
+        while((buffer.blocks.size() - 1) * Block::capacity >= capacity + Block::capacity)
+        {
+            buffer.blocks.pop_front();
+            buffer.skipped = 0;
+        }
+    }
+};
+
+/// Writes the trace to the file named by MIOPEN_TRACE when the process exits.
+class ExitWriter
+{
+    public:
+    ExitWriter()
+    {
+        const auto path = GetStringEnv(MIOPEN_TRACE{});
+        if(path != nullptr)
+            exit_path = path;
+    }
+
+    ExitWriter(const ExitWriter&) = delete;
+    ExitWriter& operator=(const ExitWriter&) = delete;
+
+    ~ExitWriter()
+    {
+        detail::enabled = false;
+        if(exit_path.empty())
+            return;
+        try
+        {
+            WriteChromeTrace(exit_path);
+        }
+        catch(...)
+        {
+            // Throwing from here terminates the application.
+        }
+    }
+
+    private:
+    std::string exit_path;
+};
+
+Registry& GetRegistry()
+{
+    // Never destroyed: threads which outlive the static objects constructed after it, such as
+    // those of the pool par_for() runs on, return their buffers to it when they exit.
+    static auto& registry = *new Registry; // NOLINT
+    static ExitWriter exit_writer;
+    return registry;
+}
+
+class ThreadState
+{
+    public:
+    ThreadState() : registry(GetRegistry()), buffer(registry.Acquire()), tid(registry.NextThreadId())
+    {
+    }
+
+    ThreadState(const ThreadState&) = delete;
+    ThreadState& operator=(const ThreadState&) = delete;
+
+    ~ThreadState() { registry.Release(buffer); }
+
+    void Append(Event&& event)
+    {
+        event.tid = tid;
+        registry.Append(*buffer, std::move(event));
+    }
+
+    private:
+    Registry& registry;
+    Buffer* buffer;
+    std::size_t tid;
+};
+
+bool InitEnabled()
+{
+    if(GetStringEnv(MIOPEN_TRACE{}) == nullptr)
+        return false;
+    // Constructs the registry now, so that it outlives all the objects which may trace.
+    GetRegistry();
+    return true;
+}
+
+void WriteString(std::ostream& os, const char* s)
+{
+    os << '"';
+    for(; *s != '\0'; ++s)
+    {
+        const auto c = *s;
+        switch(c)
+        {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\r': os << "\\r"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                os << escaped;
+            }
+            else
+            {
+                os << c;
+            }
+        }
+    }
+    os << '"';
+}
+
+int GetProcessId()
+{
+#ifdef __linux__
+    return getpid();
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+namespace detail {
+
+std::atomic<bool> enabled{InitEnabled()};
+
+std::uint64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void Record(const char* category,
+            const char* name,
+            std::string&& args,
+            std::uint64_t start,
+            std::uint64_t end)
+{
+    thread_local ThreadState state;
+    state.Append({category, name, std::move(args), start, end - start, 0});
+}
+
+} // namespace detail
+
+void Enable(bool enable)
+{
+    if(enable)
+        GetRegistry();
+    detail::enabled = enable;
+}
+
+void Clear() { GetRegistry().Clear(); }
+
+void WriteChromeTrace(std::ostream& os)
+{
+    auto events = GetRegistry().Collect();
+    std::sort(events.begin(), events.end(), [](const Event& left, const Event& right) {
+        return left.start < right.start;
+    });
+
+    const auto pid    = GetProcessId();
+    const auto origin = events.empty() ? 0 : events.front().start;
+    std::vector<std::size_t> tids;
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    os << "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+       << ",\"tid\":0,\"args\":{\"name\":\"MIOpen\"}}";
+
+    const auto old_flags     = os.flags();
+    const auto old_precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+
+    for(const auto& event : events)
+    {
+        tids.push_back(event.tid);
+        os << ",\n{\"name\":";
+        WriteString(os, event.name);
+        os << ",\"cat\":";
+        WriteString(os, event.category);
+        os << ",\"ph\":\"X\",\"ts\":" << (event.start - origin) / 1000.
+           << ",\"dur\":" << event.duration / 1000. << ",\"pid\":" << pid
+           << ",\"tid\":" << event.tid;
+        if(!event.args.empty())
+        {
+            os << ",\"args\":{\"detail\":";
+            WriteString(os, event.args.c_str());
+            os << '}';
+        }
+        os << '}';
+    }
+
+    os.flags(old_flags);
+    os.precision(old_precision);
+
+    std::sort(tids.begin(), tids.end());
+    tids.erase(std::unique(tids.begin(), tids.end()), tids.end());
+    for(const auto tid : tids)
+    {
+        os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << tid
+           << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+    }
+    os << "\n]}\n";
+}
+
+void WriteChromeTrace(const std::string& path)
+{
+    std::ofstream file(path);
+    if(!file)
+        MIOPEN_THROW("Cannot open trace file: " + path);
+    WriteChromeTrace(file);
+    if(!file)
+        MIOPEN_THROW("Cannot write trace file: " + path);
+}
+
+} // namespace trace
+} // namespace miopen
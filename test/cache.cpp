@@ -27,10 +27,15 @@
 #include <miopen/binary_cache.hpp>
 #include <miopen/kern_db.hpp>
 #include <miopen/temp_file.hpp>
+#include <miopen/compression.hpp>
+#include <miopen/lz4.hpp>
 
 #include <miopen/md5.hpp>
 #include "test.hpp"
 
+#include <thread>
+#include <vector>
+
 #if MIOPEN_ENABLE_SQLITE
 std::string random_string(size_t length)
 {
@@ -83,6 +88,47 @@ void check_bz2_decompress()
     EXPECT(decompressed_str == miopen::decompress(compressed_str, orig_str.size() + 10));
 }
 
+void check_lz4()
+{
+    CHECK(throws([&]() { miopen::lz4_compress(""); }));
+
+    // Kernel binaries repeat instruction words, which the random strings alone would not.
+    auto orig_str = random_string(1000);
+    for(auto i = 0; i < 64; ++i)
+        orig_str += random_string(4) + std::string(64, '\x20') + orig_str.substr(i * 8, 48);
+    bool success = false;
+    const auto compressed_str = miopen::lz4_compress(orig_str, &success);
+    EXPECT(success);
+    EXPECT(compressed_str.size() < orig_str.size());
+    EXPECT(miopen::lz4_decompress(compressed_str, orig_str.size()) == orig_str);
+    EXPECT(miopen::lz4_decompress(compressed_str, orig_str.size() + 10) == orig_str);
+    CHECK(throws([&]() { miopen::lz4_decompress(compressed_str, 10); }));
+    CHECK(throws([&]() {
+        miopen::lz4_decompress(compressed_str.substr(0, compressed_str.size() / 2),
+                               orig_str.size());
+    }));
+
+    for(const auto size : {1, 12, 13, 100})
+    {
+        const auto short_str = random_string(size);
+        EXPECT(miopen::lz4_decompress(miopen::lz4_compress(short_str), size) == short_str);
+    }
+
+    const auto random_str = random_string(4096);
+    EXPECT(miopen::lz4_compress(random_str, &success) == random_str);
+    EXPECT(!success);
+
+    // Blobs of either codec are decompressed regardless of the codec in use.
+    for(const auto codec : {miopen::CompressionCodec::Bzip2, miopen::CompressionCodec::Lz4})
+    {
+        const auto blob = miopen::compress_blob(orig_str, &success, codec);
+        EXPECT(success);
+        EXPECT(miopen::GetBlobCodec(blob) == codec);
+        EXPECT(miopen::decompress_blob(blob, orig_str.size()) == orig_str);
+    }
+    EXPECT(miopen::decompress_blob(miopen::compress(orig_str), orig_str.size()) == orig_str);
+}
+
 void check_kern_db()
 {
     miopen::KernelConfig cfg0;
@@ -105,6 +151,120 @@ void check_kern_db()
         CHECK(readout.get() == cfg0.kernel_blob);
         CHECK(clean_db.RemoveRecordUnsafe(cfg0));
         CHECK(!clean_db.FindRecordUnsafe(cfg0));
+
+        // Repeated queries reuse the cached prepared statements, which must not keep the values
+        // bound by the previous query.
+        miopen::KernelConfig cfg1;
+        cfg1.kernel_name = "kernel'2";
+        cfg1.kernel_args = random_string(512);
+        cfg1.kernel_blob = random_string(8192);
+
+        CHECK(clean_db.StoreRecordUnsafe(cfg0));
+        CHECK(clean_db.StoreRecordUnsafe(cfg1));
+        for(auto i = 0; i < 4; ++i)
+        {
+            auto readout0 = clean_db.FindRecordUnsafe(cfg0);
+            auto readout1 = clean_db.FindRecordUnsafe(cfg1);
+            CHECK(readout0 && readout0.get() == cfg0.kernel_blob);
+            CHECK(readout1 && readout1.get() == cfg1.kernel_blob);
+        }
+        CHECK(clean_db.RemoveRecordUnsafe(cfg1));
+        CHECK(!clean_db.FindRecordUnsafe(cfg1));
+        CHECK(clean_db.FindRecordUnsafe(cfg0));
+
+        // Batched lookups return the records in the order of the keys, with misses left empty.
+        std::vector<miopen::KernelConfig> cfgs;
+        for(auto i = 0; i < 16; ++i)
+        {
+            miopen::KernelConfig cfg;
+            cfg.kernel_name = "kernel" + std::to_string(i);
+            cfg.kernel_args = random_string(64);
+            cfg.kernel_blob = random_string(4096);
+            if(i % 3 != 0)
+                CHECK(clean_db.StoreRecordUnsafe(cfg));
+            cfgs.push_back(cfg);
+        }
+        const auto readouts = clean_db.FindRecordsUnsafe(cfgs);
+        CHECK(readouts.size() == cfgs.size());
+        for(auto i = 0u; i < cfgs.size(); ++i)
+        {
+            if(i % 3 != 0)
+                CHECK(readouts[i] && readouts[i].get() == cfgs[i].kernel_blob);
+            else
+                CHECK(!readouts[i]);
+        }
+        CHECK(clean_db.FindRecordsUnsafe(std::vector<miopen::KernelConfig>{}).empty());
+        CHECK(empty_db.FindRecordsUnsafe(cfgs).size() == cfgs.size());
+    }
+
+    {
+        // Identical binaries are stored once and dropped together with the last record.
+        miopen::TempFile temp_file("tmp-kerndb");
+        miopen::KernDb dedup_db(std::string(temp_file), false, "gfx906", 60);
+        const auto blob_count = [&]() {
+            return std::stoi(dedup_db.sql.Exec("SELECT count(*) AS n FROM kern_blob;")[0]["n"]);
+        };
+
+        auto cfg1        = cfg0;
+        cfg1.kernel_args = random_string(512);
+        CHECK(dedup_db.StoreRecordUnsafe(cfg0));
+        CHECK(dedup_db.StoreRecordUnsafe(cfg1));
+        CHECK(blob_count() == 1);
+        CHECK(dedup_db.sql.Exec("SELECT refcount FROM kern_blob;")[0]["refcount"] == "2");
+        CHECK(dedup_db.FindRecordUnsafe(cfg1).get() == cfg0.kernel_blob);
+
+        CHECK(dedup_db.RemoveRecordUnsafe(cfg0));
+        CHECK(blob_count() == 1);
+        CHECK(dedup_db.FindRecordUnsafe(cfg1).get() == cfg0.kernel_blob);
+        CHECK(dedup_db.RemoveRecordUnsafe(cfg1));
+        CHECK(blob_count() == 0);
+
+        // Records written before the blob table existed keep the binary inline until compacted.
+        for(const auto& cfg : {cfg0, cfg1})
+        {
+            auto stmt = miopen::SQLite::Statement{
+                dedup_db.sql,
+                "INSERT INTO kern_db (kernel_name, kernel_args, kernel_blob, kernel_hash, "
+                "uncompressed_size) VALUES(?, ?, ?, ?, 0);"};
+            stmt.BindText(1, cfg.kernel_name);
+            stmt.BindText(2, cfg.kernel_args);
+            stmt.BindBlob(3, cfg.kernel_blob);
+            stmt.BindText(4, miopen::md5(cfg.kernel_blob));
+            CHECK(stmt.Step(dedup_db.sql) == SQLITE_DONE);
+        }
+        CHECK(blob_count() == 0);
+        CHECK(dedup_db.FindRecordUnsafe(cfg0).get() == cfg0.kernel_blob);
+
+        const auto legacy = dedup_db.Compact();
+        CHECK(legacy.records == 2);
+        CHECK(legacy.blobs == 1);
+        CHECK(legacy.moved_blobs == 2);
+        CHECK(blob_count() == 1);
+        CHECK(dedup_db.FindRecordUnsafe(cfg0).get() == cfg0.kernel_blob);
+        CHECK(dedup_db.FindRecordUnsafe(cfg1).get() == cfg0.kernel_blob);
+    }
+
+    {
+        // Records written with bzip2 by earlier versions load along with the new ones.
+        miopen::TempFile temp_file("tmp-kerndb");
+        auto cfg1        = cfg0;
+        cfg1.kernel_name = "kernel2";
+        cfg1.kernel_blob = std::string(4096, 'x') + random_string(64);
+        {
+            miopen::KernDb bz2_db(std::string(temp_file),
+                                  false,
+                                  "gfx906",
+                                  60,
+                                  [](const std::string& str, bool* success) {
+                                      return miopen::compress(str, success);
+                                  },
+                                  miopen::decompress);
+            CHECK(bz2_db.StoreRecordUnsafe(cfg1));
+        }
+        miopen::KernDb db(std::string(temp_file), false, "gfx906", 60);
+        CHECK(db.StoreRecordUnsafe(cfg0));
+        CHECK(db.FindRecordUnsafe(cfg0).get() == cfg0.kernel_blob);
+        CHECK(db.FindRecordUnsafe(cfg1).get() == cfg1.kernel_blob);
     }
 
     {
@@ -130,6 +290,59 @@ void check_kern_db()
         CHECK(err_db.RemoveRecordUnsafe(cfg0));
     }
 }
+
+void check_kern_db_threads()
+{
+    miopen::TempFile temp_file("tmp-kerndb");
+    miopen::KernDb db(std::string(temp_file), false, "gfx906", 60);
+
+    // Threads share the connection of the database, so their transactions must not interleave.
+    const auto n_threads = 8;
+    const auto n_records = 32;
+    auto cfgs            = std::vector<miopen::KernelConfig>{};
+    for(auto i = 0; i < n_threads * n_records; ++i)
+    {
+        miopen::KernelConfig cfg;
+        cfg.kernel_name = "kernel" + std::to_string(i);
+        cfg.kernel_args = random_string(64);
+        // A few distinct binaries, so that the threads also share blobs.
+        cfg.kernel_blob = std::string(1024, static_cast<char>('a' + i % 5));
+        cfgs.push_back(cfg);
+    }
+
+    auto threads = std::vector<std::thread>{};
+    for(auto t = 0; t < n_threads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for(auto i = t * n_records; i < (t + 1) * n_records; ++i)
+            {
+                db.StoreRecordUnsafe(cfgs[i]);
+                db.FindRecordUnsafe(cfgs[i]);
+                if(i % 4 == 0)
+                    db.RemoveRecordUnsafe(cfgs[i]);
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    const auto readouts = db.FindRecordsUnsafe(cfgs);
+    for(auto i = 0u; i < cfgs.size(); ++i)
+    {
+        if(i % 4 == 0)
+            CHECK(!readouts[i]);
+        else
+            CHECK(readouts[i] && readouts[i].get() == cfgs[i].kernel_blob);
+    }
+    auto refcounts = db.sql.Exec("SELECT sum(refcount) AS n FROM kern_blob;");
+    CHECK(std::stoi(refcounts[0]["n"]) == n_threads * n_records * 3 / 4);
+
+    // A transaction that is already open on the connection is not joined.
+    db.sql.Exec("BEGIN TRANSACTION;");
+    CHECK(throws([&]() { db.StoreRecordUnsafe(cfgs[0]); }));
+    db.sql.Exec("ROLLBACK TRANSACTION;");
+    CHECK(!db.FindRecordUnsafe(cfgs[0]));
+}
 #endif
 
 void check_cache_file()
@@ -152,6 +365,8 @@ int main()
 #if MIOPEN_ENABLE_SQLITE
     check_bz2_compress();
     check_bz2_decompress();
+    check_lz4();
     check_kern_db();
+    check_kern_db_threads();
 #endif
 }
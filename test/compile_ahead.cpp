@@ -0,0 +1,198 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compile_ahead.hpp>
+
+#include "test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using miopen::CompileAhead;
+
+/// Stands for a tuning loop: "compiling" a config takes compile_ms on a host thread, and
+/// "running" it takes run_ms on the caller's thread.
+struct MockTuning
+{
+    std::size_t configs;
+    int compile_ms;
+    int run_ms;
+
+    /// Returns the wall time of the loop in milliseconds.
+    double Run(std::size_t depth, std::size_t threads) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto position    = std::size_t{0};
+        CompileAhead<std::size_t> ahead{depth,
+                                        threads,
+                                        [&](std::size_t& i) {
+                                            if(position == configs)
+                                                return false;
+                                            i = position++;
+                                            return true;
+                                        },
+                                        [&](std::size_t i) {
+                                            Sleep(compile_ms);
+                                            return i + 1;
+                                        }};
+        std::size_t i;
+        std::size_t binary;
+        auto n = std::size_t{0};
+        while(ahead.Pop(i, binary))
+        {
+            EXPECT(i == n);
+            EXPECT(binary == i + 1);
+            Sleep(run_ms);
+            ++n;
+        }
+        EXPECT(n == configs);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    static void Sleep(int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+};
+
+void check_overlap()
+{
+    const auto tuning   = MockTuning{16, 20, 10};
+    const auto serial   = tuning.Run(0, 0);
+    const auto pipeline = tuning.Run(8, 4);
+    // Serial: 16 * (20 + 10) ms. Pipelined: the compilation of 4 configs at once is hidden
+    // behind the runs, so about 20 + 16 * 10 ms.
+    EXPECT(serial >= 16 * 30);
+    EXPECT(pipeline < serial * 0.6);
+}
+
+void check_threads()
+{
+    // next() is only called on the caller's thread, prepare() only on the workers unless the
+    // depth is 0.
+    for(const auto depth : {0, 1, 5})
+    {
+        std::atomic<std::size_t> on_caller{0};
+        const auto caller   = std::this_thread::get_id();
+        auto position       = std::size_t{0};
+        auto next_on_caller = true;
+        CompileAhead<int> ahead{static_cast<std::size_t>(depth),
+                                3,
+                                [&](std::size_t& i) {
+                                    next_on_caller &= std::this_thread::get_id() == caller;
+                                    i = position;
+                                    return position++ < 10;
+                                },
+                                [&](std::size_t) {
+                                    if(std::this_thread::get_id() == caller)
+                                        ++on_caller;
+                                    return 0;
+                                }};
+        std::size_t i;
+        int value;
+        while(ahead.Pop(i, value))
+        {
+        }
+        EXPECT(next_on_caller);
+        EXPECT(on_caller == (depth == 0 ? 10 : 0));
+    }
+}
+
+void check_early_stop()
+{
+    // The search may stop before all the prepared candidates are popped. No more than depth
+    // candidates are prepared in excess.
+    std::atomic<std::size_t> prepared{0};
+    {
+        auto position = std::size_t{0};
+        CompileAhead<int> ahead{4,
+                                2,
+                                [&](std::size_t& i) {
+                                    i = position++;
+                                    return true;
+                                },
+                                [&](std::size_t) {
+                                    ++prepared;
+                                    return 0;
+                                }};
+        std::size_t i;
+        int value;
+        for(auto n = 0; n < 3; ++n)
+            EXPECT(ahead.Pop(i, value));
+        EXPECT(position <= 3 + 4);
+    }
+    EXPECT(prepared <= 3 + 4);
+}
+
+void check_error()
+{
+    // An exception is thrown from Pop() of the candidate which has failed, and the rest
+    // are not affected.
+    for(const auto depth : {0, 3})
+    {
+        auto position = std::size_t{0};
+        CompileAhead<std::size_t> ahead{static_cast<std::size_t>(depth),
+                                        2,
+                                        [&](std::size_t& i) {
+                                            i = position;
+                                            return position++ < 6;
+                                        },
+                                        [&](std::size_t i) {
+                                            if(i == 2)
+                                                throw std::runtime_error("build failed");
+                                            return i;
+                                        }};
+        std::size_t i;
+        std::size_t value;
+        auto popped = std::vector<std::size_t>{};
+        auto failed = 0;
+        while(true)
+        {
+            try
+            {
+                if(!ahead.Pop(i, value))
+                    break;
+                EXPECT(value == i);
+                popped.push_back(i);
+            }
+            catch(const std::runtime_error&)
+            {
+                ++failed;
+            }
+        }
+        EXPECT(failed == 1);
+        EXPECT(popped == (std::vector<std::size_t>{0, 1, 3, 4, 5}));
+    }
+}
+
+int main()
+{
+    check_overlap();
+    check_threads();
+    check_early_stop();
+    check_error();
+}
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/dispatch_cache.hpp>
+#include <miopen/convolution.hpp>
+
+#include "test.hpp"
+
+#include <memory>
+#include <vector>
+
+using miopen::ConvolutionDescriptor;
+using miopen::TensorDescriptor;
+using miopen::conv::Direction;
+using miopen::conv::DispatchCache;
+using miopen::conv::DispatchKey;
+
+int main()
+{
+    const auto solver_id = miopen::solver::Id{"ConvOclDirectFwd"};
+    const auto other_id  = miopen::solver::Id{"ConvOclDirectFwd1x1"};
+    auto conv            = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+    const auto in        = TensorDescriptor{miopenFloat, {8, 16, 32, 32}};
+    const auto weights   = TensorDescriptor{miopenFloat, {32, 16, 3, 3}};
+    const auto out       = conv.GetForwardOutputTensor(in, weights);
+    const auto in_3d     = TensorDescriptor{miopenFloat, {8, 16, 4, 32, 32}};
+
+    auto calls                    = 0;
+    const miopen::Invoker invoker = [&](const miopen::Handle&, const boost::any&) { ++calls; };
+
+    auto cache     = DispatchCache{};
+    const auto key = DispatchKey{Direction::Forward, solver_id, in, weights, out, conv};
+    EXPECT(cache.Find(key) == nullptr);
+
+    cache.Store(key, invoker);
+    const auto* found = cache.Find(key);
+    EXPECT(found != nullptr);
+    EXPECT(found != nullptr && static_cast<bool>(*found));
+
+    // Equal descriptors that are different objects hit.
+    const auto in_copy = TensorDescriptor{miopenFloat, {8, 16, 32, 32}};
+    EXPECT(cache.Find({Direction::Forward, solver_id, in_copy, weights, out, conv}) == found);
+
+    EXPECT(cache.Find({Direction::BackwardData, solver_id, in, weights, out, conv}) == nullptr);
+    EXPECT(cache.Find({Direction::Forward, other_id, in, weights, out, conv}) == nullptr);
+    EXPECT(cache.Find({Direction::Forward, solver_id, out, weights, in, conv}) == nullptr);
+    EXPECT(cache.Find({Direction::Forward, solver_id, in_3d, weights, out, conv}) == nullptr);
+
+    const auto in_half = TensorDescriptor{miopenHalf, {8, 16, 32, 32}};
+    EXPECT(cache.Find({Direction::Forward, solver_id, in_half, weights, out, conv}) == nullptr);
+
+    const auto in_strided =
+        TensorDescriptor{miopenFloat, {8, 16, 32, 32}, {16 * 32 * 64, 32 * 64, 64, 1}};
+    EXPECT(cache.Find({Direction::Forward, solver_id, in_strided, weights, out, conv}) ==
+           nullptr);
+
+    // A descriptor changed in place after the call was cached must not hit.
+    conv.group_count = 2;
+    EXPECT(cache.Find(key) == nullptr);
+    conv.group_count = 1;
+    conv.pads        = {0, 0};
+    EXPECT(cache.Find(key) == nullptr);
+    conv.pads = {1, 1};
+    EXPECT(cache.Find(key) == found);
+
+    // Entries are dropped, releasing their invokers, once the invoker cache has evicted any.
+    const auto held      = std::make_shared<int>(0);
+    const auto other_key = DispatchKey{Direction::BackwardData, solver_id, in, weights, out, conv};
+    cache.Store(other_key, [held](const miopen::Handle&, const boost::any&) {});
+    cache.SetGeneration(0);
+    EXPECT(cache.Find(key) == found);
+    cache.SetGeneration(1);
+    EXPECT(cache.Find(key) == nullptr);
+    EXPECT(cache.Find(other_key) == nullptr);
+    EXPECT(held.use_count() == 1);
+    cache.Store(key, invoker);
+    cache.SetGeneration(1);
+    EXPECT(cache.Find(key) != nullptr);
+
+    EXPECT(calls == 0);
+}
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "serialize.hpp"
+#include "cpu_conv.hpp"
+#include "test.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+struct conv_case
+{
+    std::size_t n, c, k, groups;
+    std::vector<std::size_t> in_len, wei_len;
+    std::vector<int> pads, strides, dilations;
+
+    std::vector<std::size_t> out_len() const
+    {
+        std::vector<std::size_t> out;
+        for(std::size_t i = 0; i < in_len.size(); ++i)
+        {
+            const auto span = dilations[i] * (wei_len[i] - 1) + 1;
+            out.push_back((in_len[i] + 2 * pads[i] - span) / strides[i] + 1);
+        }
+        return out;
+    }
+
+    template <class T>
+    tensor<T> make(std::size_t d0, std::size_t d1, const std::vector<std::size_t>& spatial) const
+    {
+        std::vector<std::size_t> lens{d0, d1};
+        lens.insert(lens.end(), spatial.begin(), spatial.end());
+        tensor<T> t{lens};
+        for(auto& x : t.data)
+            x = static_cast<T>(static_cast<float>(std::rand() % 17 - 8) / 8);
+        return t;
+    }
+};
+
+// Multiples of 1/8 keep every partial sum exact in double, so the GEMM engines must match the
+// direct loops bit for bit whatever the summation order. Winograd transforms are not exact.
+void check_equal(const tensor<float>& ref, const tensor<float>& out, bool exact)
+{
+    EXPECT(ref.data.size() == out.data.size());
+    for(std::size_t i = 0; i < ref.data.size(); ++i)
+    {
+        if(exact)
+            EXPECT_EQUAL(ref.data[i], out.data[i]);
+        else
+            EXPECT(std::abs(ref.data[i] - out.data[i]) <=
+                   1e-4 * std::max(1.0f, std::abs(ref.data[i])));
+    }
+}
+
+void check_engines(const conv_case& cc)
+{
+    const auto dim = cc.in_len.size();
+    const auto in  = cc.make<float>(cc.n, cc.c, cc.in_len);
+    const auto wei = cc.make<float>(cc.k, cc.c / cc.groups, cc.wei_len);
+    const auto out = cc.make<float>(cc.n, cc.k, cc.out_len());
+
+    auto fwd = [&](cpu_conv_engine engine) {
+        auto y = out;
+        cpu_convolution_forward(
+            dim, in, wei, y, cc.pads, cc.strides, cc.dilations, cc.groups, engine);
+        return y;
+    };
+    auto bwd = [&](cpu_conv_engine engine) {
+        auto x = in;
+        cpu_convolution_backward_data(
+            dim, x, wei, out, cc.pads, cc.strides, cc.dilations, cc.groups, engine);
+        return x;
+    };
+    auto wrw = [&](cpu_conv_engine engine) {
+        auto w = wei;
+        cpu_convolution_backward_weight(
+            dim, in, w, out, cc.pads, cc.strides, cc.dilations, cc.groups, engine);
+        return w;
+    };
+
+    const auto fwd_ref = fwd(cpu_conv_engine::direct);
+    const auto bwd_ref = bwd(cpu_conv_engine::direct);
+    const auto wrw_ref = wrw(cpu_conv_engine::direct);
+    check_equal(fwd_ref, fwd(cpu_conv_engine::gemm), true);
+    check_equal(bwd_ref, bwd(cpu_conv_engine::gemm), true);
+    check_equal(wrw_ref, wrw(cpu_conv_engine::gemm), true);
+
+    const auto winograd = dim == 2 && cc.wei_len[0] == 3 && cc.wei_len[1] == 3 &&
+                          cc.strides[0] == 1 && cc.strides[1] == 1 && cc.dilations[0] == 1 &&
+                          cc.dilations[1] == 1;
+    if(winograd)
+        check_equal(fwd_ref, fwd(cpu_conv_engine::winograd), false);
+    else
+        CHECK(throws([&] { fwd(cpu_conv_engine::winograd); }));
+    CHECK(throws([&] { bwd(cpu_conv_engine::winograd); }));
+}
+
+int main()
+{
+    std::srand(0);
+    // clang-format off
+    check_engines({2, 3, 4, 1, {17}, {3}, {1}, {2}, {1}});
+    check_engines({1, 4, 6, 2, {9}, {2}, {0}, {1}, {3}});
+    check_engines({2, 3, 5, 1, {7, 6}, {3, 3}, {1, 1}, {1, 1}, {1, 1}});
+    check_engines({1, 4, 4, 2, {13, 11}, {3, 3}, {1, 0}, {1, 1}, {1, 1}});
+    check_engines({2, 8, 6, 2, {10, 9}, {3, 3}, {2, 1}, {1, 1}, {1, 1}});
+    check_engines({1, 2, 3, 1, {12, 10}, {3, 3}, {1, 1}, {2, 1}, {1, 2}});
+    check_engines({1, 6, 6, 3, {9, 8}, {1, 1}, {0, 0}, {2, 2}, {1, 1}});
+    check_engines({2, 3, 2, 1, {8, 7}, {5, 4}, {2, 1}, {3, 2}, {1, 1}});
+    check_engines({1, 2, 4, 2, {5, 6, 7}, {3, 2, 3}, {1, 0, 1}, {1, 2, 1}, {1, 1, 2}});
+    // clang-format on
+}
@@ -27,14 +27,19 @@
 #define GUARD_CPU_CONV_HPP
 
 #include "test.hpp"
+#include "host_gemm.hpp"
 #include <array>
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
 #include <utility>
+#include <vector>
 
 #include "tensor_holder.hpp"
 #include <miopen/stringutils.hpp>
@@ -47,13 +52,13 @@ static constexpr auto make_array(T x, Ts... xs)
 }
 
 template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
-void cpu_convolution_forward_impl(const tensor<Tin>& in,
-                                  const tensor<Twei>& wei,
-                                  tensor<Tout>& out,
-                                  const Range& pads,
-                                  const Range& strides,
-                                  const Range& dilations,
-                                  std::size_t group_count)
+void cpu_convolution_forward_direct(const tensor<Tin>& in,
+                                    const tensor<Twei>& wei,
+                                    tensor<Tout>& out,
+                                    const Range& pads,
+                                    const Range& strides,
+                                    const Range& dilations,
+                                    std::size_t group_count)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
@@ -130,13 +135,13 @@ void cpu_convolution_forward_impl(const tensor<Tin>& in,
 }
 
 template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
-void cpu_convolution_backward_data_impl(tensor<Tin>& in,
-                                        const tensor<Twei>& wei,
-                                        const tensor<Tout>& out,
-                                        const Range& pads,
-                                        const Range& strides,
-                                        const Range& dilations,
-                                        std::size_t group_count)
+void cpu_convolution_backward_data_direct(tensor<Tin>& in,
+                                          const tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
@@ -215,13 +220,13 @@ void cpu_convolution_backward_data_impl(tensor<Tin>& in,
 }
 
 template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
-void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
-                                          tensor<Twei>& wei,
-                                          const tensor<Tout>& out,
-                                          const Range& pads,
-                                          const Range& strides,
-                                          const Range& dilations,
-                                          std::size_t group_count)
+void cpu_convolution_backward_weight_direct(const tensor<Tin>& in,
+                                            tensor<Twei>& wei,
+                                            const tensor<Tout>& out,
+                                            const Range& pads,
+                                            const Range& strides,
+                                            const Range& dilations,
+                                            std::size_t group_count)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
@@ -294,6 +299,588 @@ void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
     });
 }
 
+enum class cpu_conv_engine
+{
+    automatic,
+    direct,
+    gemm,
+    winograd,
+};
+
+namespace cpu_conv_detail {
+
+// Problem sizes of a convolution. Spatial positions are handled as linear indices, with
+// tables of the per dimension coordinates and of the tensor offsets.
+template <std::size_t ConvDim>
+struct conv_shape
+{
+    using coords = std::array<std::ptrdiff_t, ConvDim>;
+
+    std::size_t n, c_per_group, k_per_group, groups;
+    coords in_len, wei_len, out_len, pads, strides, dilations;
+    std::vector<std::size_t> in_str, wei_str, out_str;
+    std::vector<coords> in_pos, wei_pos, out_pos;
+    std::vector<std::size_t> in_off, wei_off, out_off;
+
+    template <class Tin, class Twei, class Tout, class Range>
+    conv_shape(const tensor<Tin>& in,
+               const tensor<Twei>& wei,
+               const tensor<Tout>& out,
+               const Range& pads_,
+               const Range& strides_,
+               const Range& dilations_,
+               std::size_t group_count)
+        : n(in.desc.GetLengths()[0]),
+          c_per_group(wei.desc.GetLengths()[1]),
+          k_per_group(wei.desc.GetLengths()[0] / group_count),
+          groups(group_count),
+          in_str(in.desc.GetStrides()),
+          wei_str(wei.desc.GetStrides()),
+          out_str(out.desc.GetStrides())
+    {
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            in_len[i]    = in.desc.GetLengths()[2 + i];
+            wei_len[i]   = wei.desc.GetLengths()[2 + i];
+            out_len[i]   = out.desc.GetLengths()[2 + i];
+            pads[i]      = pads_[i];
+            strides[i]   = strides_[i];
+            dilations[i] = dilations_[i];
+        }
+        make_table(in_len, in_str, in_pos, in_off);
+        make_table(wei_len, wei_str, wei_pos, wei_off);
+        make_table(out_len, out_str, out_pos, out_off);
+    }
+
+    std::size_t in_spatial() const { return in_pos.size(); }
+    std::size_t wei_spatial() const { return wei_pos.size(); }
+    std::size_t out_spatial() const { return out_pos.size(); }
+
+    // Offset of the input element used by output position os and filter position ws, or -1
+    // if it lies in the padding.
+    std::ptrdiff_t in_window(std::size_t os, std::size_t ws) const
+    {
+        std::ptrdiff_t off = 0;
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            const auto x =
+                out_pos[os][i] * strides[i] + wei_pos[ws][i] * dilations[i] - pads[i];
+            if(x < 0 || x >= in_len[i])
+                return -1;
+            off += x * in_str[2 + i];
+        }
+        return off;
+    }
+
+    // Offset of the output element that input position is gets from filter position ws, or -1
+    // if there is none.
+    std::ptrdiff_t out_window(std::size_t is, std::size_t ws) const
+    {
+        std::ptrdiff_t off = 0;
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            const auto x = in_pos[is][i] + pads[i] - wei_pos[ws][i] * dilations[i];
+            if(x < 0 || x % strides[i] != 0 || x / strides[i] >= out_len[i])
+                return -1;
+            off += (x / strides[i]) * out_str[2 + i];
+        }
+        return off;
+    }
+
+    private:
+    static void make_table(const coords& len,
+                           const std::vector<std::size_t>& str,
+                           std::vector<coords>& pos,
+                           std::vector<std::size_t>& off)
+    {
+        const auto size = std::accumulate(
+            len.begin(), len.end(), std::size_t{1}, std::multiplies<std::size_t>());
+        pos.resize(size);
+        off.resize(size);
+        for(std::size_t s = 0; s < size; ++s)
+        {
+            auto rest = s;
+            off[s]    = 0;
+            for(std::size_t i = ConvDim; i-- > 0;)
+            {
+                pos[s][i] = rest % len[i];
+                rest /= len[i];
+                off[s] += pos[s][i] * str[2 + i];
+            }
+        }
+    }
+};
+
+// Winograd F(m, 3) transforms: d -> BT d B, g -> G g GT, y -> AT y A.
+template <std::size_t M>
+struct winograd_f3;
+
+template <>
+struct winograd_f3<2>
+{
+    static constexpr std::size_t alpha = 4;
+    static const double (&bt())[4][4]
+    {
+        static constexpr double m[4][4] = {
+            {1, 0, -1, 0}, {0, 1, 1, 0}, {0, -1, 1, 0}, {0, 1, 0, -1}};
+        return m;
+    }
+    static const double (&g())[4][3]
+    {
+        static constexpr double m[4][3] = {{1, 0, 0}, {.5, .5, .5}, {.5, -.5, .5}, {0, 0, 1}};
+        return m;
+    }
+    static const double (&at())[2][4]
+    {
+        static constexpr double m[2][4] = {{1, 1, 1, 0}, {0, 1, -1, -1}};
+        return m;
+    }
+};
+
+template <>
+struct winograd_f3<4>
+{
+    static constexpr std::size_t alpha = 6;
+    static const double (&bt())[6][6]
+    {
+        static constexpr double m[6][6] = {{4, 0, -5, 0, 1, 0},
+                                           {0, -4, -4, 1, 1, 0},
+                                           {0, 4, -4, -1, 1, 0},
+                                           {0, -2, -1, 2, 1, 0},
+                                           {0, 2, -1, -2, 1, 0},
+                                           {0, 4, 0, -5, 0, 1}};
+        return m;
+    }
+    static const double (&g())[6][3]
+    {
+        static constexpr double m[6][3] = {{1. / 4, 0, 0},
+                                           {-1. / 6, -1. / 6, -1. / 6},
+                                           {-1. / 6, 1. / 6, -1. / 6},
+                                           {1. / 24, 1. / 12, 1. / 6},
+                                           {1. / 24, -1. / 12, 1. / 6},
+                                           {0, 0, 1}};
+        return m;
+    }
+    static const double (&at())[4][6]
+    {
+        static constexpr double m[4][6] = {
+            {1, 1, 1, 1, 1, 0}, {0, 1, -1, 2, -2, 0}, {0, 1, 1, 4, 4, 0}, {0, 1, -1, 8, -8, 1}};
+        return m;
+    }
+};
+
+} // namespace cpu_conv_detail
+
+// Forward convolution as one GEMM per group:
+// out[k, (n, os)] = wei[k, (c, ws)] * col[(c, ws), (n, os)],
+// where the im2col matrix is read on the fly from the input while the GEMM packs it.
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_forward_gemm(const tensor<Tin>& in,
+                                  const tensor<Twei>& wei,
+                                  tensor<Tout>& out,
+                                  const Range& pads,
+                                  const Range& strides,
+                                  const Range& dilations,
+                                  std::size_t group_count)
+{
+    const cpu_conv_detail::conv_shape<ConvDim> s{
+        in, wei, out, pads, strides, dilations, group_count};
+    const auto ws_len = s.wei_spatial();
+    const auto os_len = s.out_spatial();
+
+    for(std::size_t g = 0; g < s.groups; ++g)
+    {
+        const auto k0 = g * s.k_per_group;
+        const auto c0 = g * s.c_per_group;
+        host_gemm<double>(
+            s.k_per_group,
+            s.n * os_len,
+            s.c_per_group * ws_len,
+            [&](std::size_t k, std::size_t q) {
+                return double(wei.data[(k0 + k) * s.wei_str[0] + (q / ws_len) * s.wei_str[1] +
+                                       s.wei_off[q % ws_len]]);
+            },
+            [&](std::size_t q, std::size_t j) {
+                const auto off = s.in_window(j % os_len, q % ws_len);
+                if(off < 0)
+                    return 0.0;
+                return double(in.data[(j / os_len) * s.in_str[0] +
+                                      (c0 + q / ws_len) * s.in_str[1] + off]);
+            },
+            [&](std::size_t k, std::size_t j, double x) {
+                out.data[(j / os_len) * s.out_str[0] + (k0 + k) * s.out_str[1] +
+                         s.out_off[j % os_len]] = x;
+            });
+    }
+}
+
+// Backward data convolution as one GEMM per group, gathering the output gradient instead of
+// scattering columns: in[c, (n, is)] = wei[(k, ws), c] * out[(k, ws), (n, is)].
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_data_gemm(tensor<Tin>& in,
+                                        const tensor<Twei>& wei,
+                                        const tensor<Tout>& out,
+                                        const Range& pads,
+                                        const Range& strides,
+                                        const Range& dilations,
+                                        std::size_t group_count)
+{
+    const cpu_conv_detail::conv_shape<ConvDim> s{
+        in, wei, out, pads, strides, dilations, group_count};
+    const auto ws_len = s.wei_spatial();
+    const auto is_len = s.in_spatial();
+
+    for(std::size_t g = 0; g < s.groups; ++g)
+    {
+        const auto k0 = g * s.k_per_group;
+        const auto c0 = g * s.c_per_group;
+        host_gemm<double>(
+            s.c_per_group,
+            s.n * is_len,
+            s.k_per_group * ws_len,
+            [&](std::size_t c, std::size_t q) {
+                return double(wei.data[(k0 + q / ws_len) * s.wei_str[0] + c * s.wei_str[1] +
+                                       s.wei_off[q % ws_len]]);
+            },
+            [&](std::size_t q, std::size_t j) {
+                const auto off = s.out_window(j % is_len, q % ws_len);
+                if(off < 0)
+                    return 0.0;
+                return double(out.data[(j / is_len) * s.out_str[0] +
+                                       (k0 + q / ws_len) * s.out_str[1] + off]);
+            },
+            [&](std::size_t c, std::size_t j, double x) {
+                in.data[(j / is_len) * s.in_str[0] + (c0 + c) * s.in_str[1] +
+                        s.in_off[j % is_len]] = x;
+            });
+    }
+}
+
+// Backward weights convolution as one GEMM per group:
+// wei[k, (c, ws)] = out[k, (n, os)] * col[(n, os), (c, ws)].
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_weight_gemm(const tensor<Tin>& in,
+                                          tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count)
+{
+    const cpu_conv_detail::conv_shape<ConvDim> s{
+        in, wei, out, pads, strides, dilations, group_count};
+    const auto ws_len = s.wei_spatial();
+    const auto os_len = s.out_spatial();
+
+    for(std::size_t g = 0; g < s.groups; ++g)
+    {
+        const auto k0 = g * s.k_per_group;
+        const auto c0 = g * s.c_per_group;
+        host_gemm<double>(
+            s.k_per_group,
+            s.c_per_group * ws_len,
+            s.n * os_len,
+            [&](std::size_t k, std::size_t p) {
+                return double(out.data[(p / os_len) * s.out_str[0] + (k0 + k) * s.out_str[1] +
+                                       s.out_off[p % os_len]]);
+            },
+            [&](std::size_t p, std::size_t q) {
+                const auto off = s.in_window(p % os_len, q % ws_len);
+                if(off < 0)
+                    return 0.0;
+                return double(in.data[(p / os_len) * s.in_str[0] +
+                                      (c0 + q / ws_len) * s.in_str[1] + off]);
+            },
+            [&](std::size_t k, std::size_t q, double x) {
+                wei.data[(k0 + k) * s.wei_str[0] + (q / ws_len) * s.wei_str[1] +
+                         s.wei_off[q % ws_len]] = x;
+            });
+    }
+}
+
+// Forward 2D 3x3 stride 1 convolution with Winograd F(M, 3). For each of the alpha x alpha
+// points of the transformed tiles, the products over the channels are a GEMM. Images are
+// processed one at a time to bound the size of the transformed input.
+template <std::size_t M, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_forward_winograd(const tensor<Tin>& in,
+                                      const tensor<Twei>& wei,
+                                      tensor<Tout>& out,
+                                      const Range& pads,
+                                      const Range& strides,
+                                      const Range& dilations,
+                                      std::size_t group_count)
+{
+    using wino               = cpu_conv_detail::winograd_f3<M>;
+    constexpr std::size_t a  = wino::alpha;
+    constexpr std::size_t aa = a * a;
+    const auto& bt           = wino::bt();
+    const auto& gf           = wino::g();
+    const auto& at           = wino::at();
+
+    const cpu_conv_detail::conv_shape<2> s{in, wei, out, pads, strides, dilations, group_count};
+    const auto kg      = s.k_per_group;
+    const auto cg      = s.c_per_group;
+    const auto tiles_w = (s.out_len[1] + M - 1) / M;
+    const auto tiles   = std::size_t((s.out_len[0] + M - 1) / M * tiles_w);
+
+    std::vector<double> u(aa * kg * cg);
+    std::vector<double> v(aa * cg * tiles);
+    std::vector<double> m(aa * kg * tiles);
+
+    for(std::size_t g = 0; g < s.groups; ++g)
+    {
+        const auto k0 = g * kg;
+        const auto c0 = g * cg;
+
+        // u[xi][k][c] = G w GT
+        par_for(kg * cg, [&](std::size_t kc) {
+            const auto k = kc / cg;
+            const auto c = kc % cg;
+            double w[3][3];
+            for(std::size_t y = 0; y < 3; ++y)
+                for(std::size_t x = 0; x < 3; ++x)
+                    w[y][x] = double(wei.data[(k0 + k) * s.wei_str[0] + c * s.wei_str[1] +
+                                              y * s.wei_str[2] + x * s.wei_str[3]]);
+            double gw[a][3];
+            for(std::size_t i = 0; i < a; ++i)
+                for(std::size_t x = 0; x < 3; ++x)
+                    gw[i][x] = gf[i][0] * w[0][x] + gf[i][1] * w[1][x] +
+                               gf[i][2] * w[2][x];
+            for(std::size_t i = 0; i < a; ++i)
+                for(std::size_t j = 0; j < a; ++j)
+                    u[(i * a + j) * kg * cg + kc] = gw[i][0] * gf[j][0] +
+                                                    gw[i][1] * gf[j][1] +
+                                                    gw[i][2] * gf[j][2];
+        });
+
+        for(std::size_t n = 0; n < s.n; ++n)
+        {
+            // v[xi][c][t] = BT d B
+            par_for(cg * tiles, [&](std::size_t ct) {
+                const auto c  = ct / tiles;
+                const auto t  = ct % tiles;
+                const auto y0 = std::ptrdiff_t(t / tiles_w * M) - s.pads[0];
+                const auto x0 = std::ptrdiff_t(t % tiles_w * M) - s.pads[1];
+                double d[a][a];
+                for(std::size_t y = 0; y < a; ++y)
+                {
+                    for(std::size_t x = 0; x < a; ++x)
+                    {
+                        const auto iy = y0 + std::ptrdiff_t(y);
+                        const auto ix = x0 + std::ptrdiff_t(x);
+                        d[y][x] = iy < 0 || iy >= s.in_len[0] || ix < 0 || ix >= s.in_len[1]
+                                      ? 0.0
+                                      : double(in.data[n * s.in_str[0] + (c0 + c) * s.in_str[1] +
+                                                       iy * s.in_str[2] + ix * s.in_str[3]]);
+                    }
+                }
+                double bd[a][a];
+                for(std::size_t i = 0; i < a; ++i)
+                {
+                    for(std::size_t x = 0; x < a; ++x)
+                    {
+                        bd[i][x] = 0;
+                        for(std::size_t y = 0; y < a; ++y)
+                            bd[i][x] += bt[i][y] * d[y][x];
+                    }
+                }
+                for(std::size_t i = 0; i < a; ++i)
+                {
+                    for(std::size_t j = 0; j < a; ++j)
+                    {
+                        double sum = 0;
+                        for(std::size_t x = 0; x < a; ++x)
+                            sum += bd[i][x] * bt[j][x];
+                        v[((i * a + j) * cg + c) * tiles + t] = sum;
+                    }
+                }
+            });
+
+            // m[xi] = u[xi] v[xi]
+            par_for(aa, miopen::min_grain{1}, [&](std::size_t xi) {
+                const auto* uxi = &u[xi * kg * cg];
+                const auto* vxi = &v[xi * cg * tiles];
+                auto* mxi       = &m[xi * kg * tiles];
+                host_gemm<double>(
+                    kg,
+                    tiles,
+                    cg,
+                    [&](std::size_t k, std::size_t c) { return uxi[k * cg + c]; },
+                    [&](std::size_t c, std::size_t t) { return vxi[c * tiles + t]; },
+                    [&](std::size_t k, std::size_t t, double x) { mxi[k * tiles + t] = x; });
+            });
+
+            // y = AT m A
+            par_for(kg * tiles, [&](std::size_t kt) {
+                const auto k = kt / tiles;
+                const auto t = kt % tiles;
+                double am[M][a];
+                for(std::size_t i = 0; i < M; ++i)
+                {
+                    for(std::size_t x = 0; x < a; ++x)
+                    {
+                        am[i][x] = 0;
+                        for(std::size_t y = 0; y < a; ++y)
+                            am[i][x] += at[i][y] * m[((y * a + x) * kg + k) * tiles + t];
+                    }
+                }
+                for(std::size_t i = 0; i < M; ++i)
+                {
+                    const auto oy = t / tiles_w * M + i;
+                    if(std::ptrdiff_t(oy) >= s.out_len[0])
+                        break;
+                    for(std::size_t j = 0; j < M; ++j)
+                    {
+                        const auto ox = t % tiles_w * M + j;
+                        if(std::ptrdiff_t(ox) >= s.out_len[1])
+                            break;
+                        double sum = 0;
+                        for(std::size_t x = 0; x < a; ++x)
+                            sum += am[i][x] * at[j][x];
+                        out.data[n * s.out_str[0] + (k0 + k) * s.out_str[1] +
+                                 oy * s.out_str[2] + ox * s.out_str[3]] = sum;
+                    }
+                }
+            });
+        }
+    }
+}
+
+namespace cpu_conv_detail {
+
+// The direct loops are kept for tiny problems, where the setup of the other engines dominates.
+constexpr std::size_t direct_max_macs = 1 << 16;
+
+template <std::size_t ConvDim, typename Range>
+bool is_winograd_3x3(const conv_shape<ConvDim>& s,
+                     const Range& strides,
+                     const Range& dilations)
+{
+    if(ConvDim != 2)
+        return false;
+    for(std::size_t i = 0; i < ConvDim; ++i)
+        if(s.wei_len[i] != 3 || strides[i] != 1 || dilations[i] != 1)
+            return false;
+    return true;
+}
+
+template <std::size_t ConvDim>
+std::size_t macs(const conv_shape<ConvDim>& s)
+{
+    return s.n * s.groups * s.k_per_group * s.c_per_group * s.wei_spatial() * s.out_spatial();
+}
+
+} // namespace cpu_conv_detail
+
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_forward_impl(const tensor<Tin>& in,
+                                  const tensor<Twei>& wei,
+                                  tensor<Tout>& out,
+                                  const Range& pads,
+                                  const Range& strides,
+                                  const Range& dilations,
+                                  std::size_t group_count,
+                                  cpu_conv_engine engine = cpu_conv_engine::automatic)
+{
+    if(engine == cpu_conv_engine::automatic)
+    {
+        const cpu_conv_detail::conv_shape<ConvDim> s{
+            in, wei, out, pads, strides, dilations, group_count};
+        if(cpu_conv_detail::macs(s) <= cpu_conv_detail::direct_max_macs)
+            engine = cpu_conv_engine::direct;
+        else if(cpu_conv_detail::is_winograd_3x3(s, strides, dilations))
+            engine = cpu_conv_engine::winograd;
+        else
+            engine = cpu_conv_engine::gemm;
+    }
+
+    switch(engine)
+    {
+    case cpu_conv_engine::gemm:
+        cpu_convolution_forward_gemm<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+        break;
+    case cpu_conv_engine::winograd:
+    {
+        const cpu_conv_detail::conv_shape<ConvDim> s{
+            in, wei, out, pads, strides, dilations, group_count};
+        if(!cpu_conv_detail::is_winograd_3x3(s, strides, dilations))
+            MIOPEN_THROW("Winograd reference requires a 2D 3x3 filter with stride and dilation 1");
+        // F(4, 3) has 4 times fewer multiplications, but wastes more on small outputs.
+        if(s.out_len[0] >= 8 && s.out_len[1] >= 8)
+            cpu_convolution_forward_winograd<4>(
+                in, wei, out, pads, strides, dilations, group_count);
+        else
+            cpu_convolution_forward_winograd<2>(
+                in, wei, out, pads, strides, dilations, group_count);
+        break;
+    }
+    case cpu_conv_engine::automatic:
+    case cpu_conv_engine::direct:
+        cpu_convolution_forward_direct<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+        break;
+    }
+}
+
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_data_impl(tensor<Tin>& in,
+                                        const tensor<Twei>& wei,
+                                        const tensor<Tout>& out,
+                                        const Range& pads,
+                                        const Range& strides,
+                                        const Range& dilations,
+                                        std::size_t group_count,
+                                        cpu_conv_engine engine = cpu_conv_engine::automatic)
+{
+    if(engine == cpu_conv_engine::automatic)
+    {
+        const cpu_conv_detail::conv_shape<ConvDim> s{
+            in, wei, out, pads, strides, dilations, group_count};
+        engine = cpu_conv_detail::macs(s) <= cpu_conv_detail::direct_max_macs
+                     ? cpu_conv_engine::direct
+                     : cpu_conv_engine::gemm;
+    }
+
+    if(engine == cpu_conv_engine::gemm)
+        cpu_convolution_backward_data_gemm<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+    else if(engine == cpu_conv_engine::direct)
+        cpu_convolution_backward_data_direct<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+    else
+        MIOPEN_THROW("Unsupported backward data reference engine");
+}
+
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
+                                          tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count,
+                                          cpu_conv_engine engine = cpu_conv_engine::automatic)
+{
+    if(engine == cpu_conv_engine::automatic)
+    {
+        const cpu_conv_detail::conv_shape<ConvDim> s{
+            in, wei, out, pads, strides, dilations, group_count};
+        engine = cpu_conv_detail::macs(s) <= cpu_conv_detail::direct_max_macs
+                     ? cpu_conv_engine::direct
+                     : cpu_conv_engine::gemm;
+    }
+
+    if(engine == cpu_conv_engine::gemm)
+        cpu_convolution_backward_weight_gemm<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+    else if(engine == cpu_conv_engine::direct)
+        cpu_convolution_backward_weight_direct<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+    else
+        MIOPEN_THROW("Unsupported backward weights reference engine");
+}
+
 template <typename Tin, typename Twei, typename Tout, typename Range>
 void cpu_convolution_forward(std::size_t spatial_dim,
                              const tensor<Tin>& in,
@@ -302,28 +889,33 @@ void cpu_convolution_forward(std::size_t spatial_dim,
                              const Range& pads,
                              const Range& strides,
                              const Range& dilations,
-                             std::size_t group_count)
+                             std::size_t group_count,
+                             cpu_conv_engine engine = cpu_conv_engine::automatic)
 {
     switch(spatial_dim)
     {
     case 1:
     {
-        cpu_convolution_forward_impl<1>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_forward_impl<1>(
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 2:
     {
-        cpu_convolution_forward_impl<2>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_forward_impl<2>(
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 3:
     {
-        cpu_convolution_forward_impl<3>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_forward_impl<3>(
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 4:
     {
-        cpu_convolution_forward_impl<4>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_forward_impl<4>(
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     default: { MIOPEN_THROW("not belong to any case");
@@ -339,28 +931,33 @@ void cpu_convolution_backward_data(std::size_t spatial_dim,
                                    const Range& pads,
                                    const Range& strides,
                                    const Range& dilations,
-                                   std::size_t group_count)
+                                   std::size_t group_count,
+                                   cpu_conv_engine engine = cpu_conv_engine::automatic)
 {
     switch(spatial_dim)
     {
     case 1:
     {
-        cpu_convolution_backward_data_impl<1>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_impl<1>(
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 2:
     {
-        cpu_convolution_backward_data_impl<2>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_impl<2>(
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 3:
     {
-        cpu_convolution_backward_data_impl<3>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_impl<3>(
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 4:
     {
-        cpu_convolution_backward_data_impl<4>(in, wei, out, pads, strides, dilations, group_count);
+        cpu_convolution_backward_data_impl<4>(
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     default: { MIOPEN_THROW("not belong to any case");
@@ -376,32 +973,33 @@ void cpu_convolution_backward_weight(std::size_t spatial_dim,
                                      const Range& pads,
                                      const Range& strides,
                                      const Range& dilations,
-                                     std::size_t group_count)
+                                     std::size_t group_count,
+                                     cpu_conv_engine engine = cpu_conv_engine::automatic)
 {
     switch(spatial_dim)
     {
     case 1:
     {
         cpu_convolution_backward_weight_impl<1>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 2:
     {
         cpu_convolution_backward_weight_impl<2>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 3:
     {
         cpu_convolution_backward_weight_impl<3>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     case 4:
     {
         cpu_convolution_backward_weight_impl<4>(
-            in, wei, out, pads, strides, dilations, group_count);
+            in, wei, out, pads, strides, dilations, group_count, engine);
         break;
     }
     default: { MIOPEN_THROW("not belong to any case");
@@ -0,0 +1,245 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct WriteBehindData
+{
+    int x = 0;
+    int y = 0;
+
+    WriteBehindData() = default;
+    WriteBehindData(int x_, int y_) : x(x_), y(y_) {}
+
+    void Serialize(std::ostream& s) const { s << x << ',' << y; }
+
+    bool Deserialize(const std::string& s)
+    {
+        auto ss  = std::istringstream(s);
+        auto sep = ',';
+        return static_cast<bool>(ss >> x >> sep >> y);
+    }
+
+    bool operator==(const WriteBehindData& other) const { return x == other.x && y == other.y; }
+};
+
+static std::vector<std::string> ReadLines(const std::string& path)
+{
+    auto lines = std::vector<std::string>{};
+    auto file  = std::ifstream(path);
+    auto line  = std::string{};
+    while(std::getline(file, line))
+        lines.push_back(line);
+    return lines;
+}
+
+static void WriteAndExit(const std::string& path)
+{
+    PlainTextDb db(path);
+    EXPECT(db.Update(WriteBehindData(3, 4), "exit", WriteBehindData(5, 6)));
+    // No flush here: queued changes shall be written on exit.
+}
+
+/// Changes the record of CheckInterleaved() from another process.
+static void UpdateAndExit(const std::string& path)
+{
+    PlainTextDb db(path);
+    EXPECT(db.Update(WriteBehindData(1, 2), "0", WriteBehindData(7, 7)));
+    EXPECT(db.Update(WriteBehindData(1, 2), "child", WriteBehindData(8, 8)));
+}
+
+static void CheckVisibility()
+{
+    TempFile temp_file("miopen.tests.db_write_behind");
+    const auto key = WriteBehindData(1, 2);
+
+    {
+        PlainTextDb db(temp_file);
+        EXPECT(db.Update(key, "0", WriteBehindData(3, 4)));
+        EXPECT(db.Update(key, "1", WriteBehindData(5, 6)));
+        EXPECT(db.Update(WriteBehindData(7, 8), "0", WriteBehindData(9, 10)));
+    }
+
+    {
+        // Queued changes are visible to this process right away.
+        PlainTextDb db(temp_file);
+        auto read = WriteBehindData{};
+        EXPECT(db.Load(key, "0", read));
+        EXPECT(read == WriteBehindData(3, 4));
+        EXPECT(db.Load(key, "1", read));
+        EXPECT(read == WriteBehindData(5, 6));
+
+        EXPECT(db.Remove(key, "0"));
+        EXPECT(!db.Load(key, "0", read));
+        EXPECT(db.RemoveRecord(WriteBehindData(7, 8)));
+        EXPECT(!db.FindRecord(WriteBehindData(7, 8)));
+    }
+
+    PlainTextDb::FlushPendingWrites();
+
+    const auto lines = ReadLines(temp_file);
+    EXPECT_EQUAL(lines.size(), 1u);
+    EXPECT_EQUAL(lines.front(), std::string("1,2=1:5,6"));
+
+    std::remove(LockFilePath(temp_file.Path()).c_str());
+}
+
+static void CheckMultiThreaded()
+{
+    TempFile temp_file("miopen.tests.db_write_behind");
+    const auto threads_count = 8;
+    const auto records_count = 64;
+    auto threads             = std::vector<std::thread>{};
+
+    for(auto t = 0; t < threads_count; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            PlainTextDb db(temp_file);
+            for(auto i = 0; i < records_count; ++i)
+            {
+                EXPECT(db.Update(WriteBehindData(t, i), "0", WriteBehindData(i, t)));
+                EXPECT(db.Update(WriteBehindData(i, -1), std::to_string(t), WriteBehindData(t, i)));
+            }
+        });
+    }
+
+    for(auto& thread : threads)
+        thread.join();
+
+    // Export writes the queued changes first.
+    const auto records = PlainTextDb(temp_file).ExportRecords();
+    EXPECT_EQUAL(records.size(), static_cast<std::size_t>(threads_count * records_count + records_count));
+
+    PlainTextDb db(temp_file);
+    for(auto i = 0; i < records_count; ++i)
+    {
+        const auto record = db.FindRecord(WriteBehindData(i, -1));
+        EXPECT(record);
+        EXPECT_EQUAL(record->GetSize(), static_cast<std::size_t>(threads_count));
+    }
+
+    std::remove(LockFilePath(temp_file.Path()).c_str());
+}
+
+static void CheckExitFlush(const std::string& exe)
+{
+    TempFile temp_file("miopen.tests.db_write_behind");
+    const auto command = exe + " --write " + temp_file.Path();
+    EXPECT_EQUAL(std::system(command.c_str()), 0);
+
+    const auto lines = ReadLines(temp_file);
+    EXPECT_EQUAL(lines.size(), 1u);
+    EXPECT_EQUAL(lines.front(), std::string("3,4=exit:5,6"));
+
+    std::remove(LockFilePath(temp_file.Path()).c_str());
+}
+
+static void CheckInterleaved(const std::string& exe)
+{
+    TempFile temp_file("miopen.tests.db_write_behind");
+    const auto key = WriteBehindData(1, 2);
+
+    {
+        PlainTextDb db(temp_file);
+        EXPECT(db.Update(key, "0", WriteBehindData(0, 0)));
+        EXPECT(db.Update(key, "1", WriteBehindData(1, 1)));
+    }
+    PlainTextDb::FlushPendingWrites();
+
+    // Two instances queue changes of the same record, while another process changes it in the
+    // file. None of the changes shall be lost when the queue is written.
+    PlainTextDb first(temp_file);
+    PlainTextDb second(temp_file);
+    EXPECT(first.Update(key, "a", WriteBehindData(2, 2)));
+    EXPECT(second.Remove(key, "1"));
+
+    const auto command = exe + " --update " + temp_file.Path();
+    EXPECT_EQUAL(std::system(command.c_str()), 0);
+
+    EXPECT(second.Update(key, "b", WriteBehindData(3, 3)));
+    EXPECT(first.Remove(key, "a"));
+    EXPECT(first.Update(key, "c", WriteBehindData(4, 4)));
+
+    PlainTextDb::FlushPendingWrites();
+
+    const auto record = PlainTextDb(temp_file).FindRecord(key);
+    EXPECT(record);
+    EXPECT_EQUAL(record->GetSize(), 4u);
+
+    auto read = WriteBehindData{};
+    EXPECT(record->GetValues("0", read));
+    EXPECT(read == WriteBehindData(7, 7));
+    EXPECT(record->GetValues("child", read));
+    EXPECT(read == WriteBehindData(8, 8));
+    EXPECT(record->GetValues("b", read));
+    EXPECT(read == WriteBehindData(3, 3));
+    EXPECT(record->GetValues("c", read));
+    EXPECT(read == WriteBehindData(4, 4));
+    EXPECT(!record->GetValues("1", read));
+    EXPECT(!record->GetValues("a", read));
+
+    std::remove(LockFilePath(temp_file.Path()).c_str());
+}
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    setenv("MIOPEN_DB_WRITE_BEHIND", "1", 1);
+
+    if(argc == 3 && std::string(argv[1]) == "--write")
+    {
+        miopen::tests::WriteAndExit(argv[2]);
+        return 0;
+    }
+
+    if(argc == 3 && std::string(argv[1]) == "--update")
+    {
+        miopen::tests::UpdateAndExit(argv[2]);
+        return 0;
+    }
+
+    miopen::tests::CheckVisibility();
+    miopen::tests::CheckMultiThreaded();
+    miopen::tests::CheckExitFlush(argv[0]);
+    miopen::tests::CheckInterleaved(argv[0]);
+}
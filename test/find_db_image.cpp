@@ -0,0 +1,238 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/find_db_image.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+// clang-format off
+static const char* const find_db_text =
+    "2-3-4-1x1-5-3-4-8-0x0-1x1-1x1-0-NCHW-FP32-F="
+        "miopenConvolutionFwdAlgoDirect:ConvAsm1x1U,0.0123456789,0,miopenConvolutionFwdAlgoDirect,<unused>;"
+        "miopenConvolutionFwdAlgoGEMM:gemm,6.02447,7375872,MIOpenGEMM,1_0_12544_12544\n"
+    "\n"
+    "1-3-4-1x1-5-3-4-8-0x0-1x1-1x1-0-NCHW-FP32-B="
+        "miopenConvolutionBwdDataAlgoWinograd:ConvBinWinogradRxSf3x2,0.411457,0,miopenConvolutionBwdDataAlgoWinograd,<unused>;"
+        "miopenConvolutionBwdDataAlgoWinograd:ConvBinWinogradRxS,1.5,0,miopenConvolutionBwdDataAlgoWinograd,<unused>\n"
+    "2-3-4-1x1-5-3-4-8-0x0-1x1-1x1-0-NCHW-FP32-F="
+        "miopenConvolutionFwdAlgoGEMM:gemm,9,9,MIOpenGEMM,duplicate\n";
+// clang-format on
+
+static const char* const fwd_key = "2-3-4-1x1-5-3-4-8-0x0-1x1-1x1-0-NCHW-FP32-F";
+
+struct FindDbImageTest
+{
+    void run() const
+    {
+        auto writer = find_db_image::Writer{};
+        auto text   = std::istringstream{find_db_text};
+        auto error  = std::string{};
+        EXPECT(writer.Parse(text, error));
+        writer.SetSource(std::string{find_db_text}.size(), 42, md5(find_db_text));
+
+        auto out = std::ostringstream{};
+        writer.Write(out);
+        const auto image = out.str();
+
+        const auto view = find_db_image::View{image.data(), image.size()};
+        EXPECT(view.IsValid());
+        EXPECT_EQUAL(view.RecordCount(), 2u);
+        EXPECT_EQUAL(view.SourceSize(), std::string{find_db_text}.size());
+        EXPECT_EQUAL(view.SourceMtime(), 42);
+        EXPECT_EQUAL(view.SourceMd5(), md5(find_db_text));
+
+        const std::string fwd_key_str = fwd_key;
+        const auto fwd                = view.Find(fwd_key_str.data(), fwd_key_str.size());
+        EXPECT(fwd != nullptr);
+        EXPECT_EQUAL(fwd->item_count, 2u);
+        EXPECT_EQUAL(fwd->line, 1u);
+
+        const auto direct = view.ItemsBegin(*fwd);
+        EXPECT_EQUAL(view.String(direct->id), "miopenConvolutionFwdAlgoDirect");
+        EXPECT_EQUAL(view.String(direct->solver_id), "ConvAsm1x1U");
+
+        auto data = FindDbData{};
+        EXPECT(data.Deserialize(find_db_image::FormatItemValues(view, *direct)));
+        EXPECT_EQUAL(data.solver_id, "ConvAsm1x1U");
+        EXPECT_EQUAL(data.time, 0.0123456789f);
+        EXPECT_EQUAL(data.workspace, 0u);
+        EXPECT(data.kcache_key.IsUnused());
+
+        const auto gemm = direct + 1;
+        EXPECT(data.Deserialize(find_db_image::FormatItemValues(view, *gemm)));
+        EXPECT_EQUAL(data.workspace, 7375872u);
+        EXPECT_EQUAL(data.kcache_key.algorithm_name, "MIOpenGEMM");
+        EXPECT_EQUAL(data.kcache_key.network_config, "1_0_12544_12544");
+
+        // The first entry with the same id wins.
+        const std::string bwd_key = "1-3-4-1x1-5-3-4-8-0x0-1x1-1x1-0-NCHW-FP32-B";
+        const auto bwd            = view.Find(bwd_key.data(), bwd_key.size());
+        EXPECT(bwd != nullptr);
+        EXPECT_EQUAL(bwd->item_count, 1u);
+        EXPECT_EQUAL(view.String(view.ItemsBegin(*bwd)->solver_id), "ConvBinWinogradRxSf3x2");
+
+        for(const auto& missing : {std::string{"2-3-4"}, fwd_key_str + "X", std::string{"0"}})
+            EXPECT(view.Find(missing.data(), missing.size()) == nullptr);
+
+        EXPECT(!find_db_image::View(image.data(), image.size() - 8).IsValid());
+        CheckCorruption(image);
+
+        auto bad_text = std::istringstream{"key=id:solver,not_a_number,0,algo,config\n"};
+        EXPECT(!find_db_image::Writer{}.Parse(bad_text, error));
+
+        CheckFindItems();
+        CheckStaleness();
+    }
+
+    // Each out of range index or offset makes the whole image invalid.
+    static void CheckCorruption(const std::string& image)
+    {
+        auto header = find_db_image::Header{};
+        std::memcpy(&header, image.data(), sizeof(header));
+
+        const auto corrupt = [&](uint64_t offset, uint32_t value) {
+            auto copy = image;
+            std::memcpy(&copy[offset], &value, sizeof(value));
+            return find_db_image::View{copy.data(), copy.size()}.IsValid();
+        };
+
+        const auto record  = header.records_offset;
+        const auto item    = header.items_offset;
+        const auto str     = header.strings_offset;
+        const auto strings = header.string_count;
+        const auto items   = header.item_count;
+
+        EXPECT(!corrupt(record + offsetof(find_db_image::Record, key), strings));
+        EXPECT(!corrupt(record + offsetof(find_db_image::Record, first_item), items));
+        EXPECT(!corrupt(record + offsetof(find_db_image::Record, item_count), items + 1));
+        EXPECT(!corrupt(record + offsetof(find_db_image::Record, first_item), 0xFFFFFFFF));
+        EXPECT(!corrupt(item + offsetof(find_db_image::Item, id), strings));
+        EXPECT(!corrupt(item + offsetof(find_db_image::Item, solver_id), strings));
+        EXPECT(!corrupt(item + offsetof(find_db_image::Item, kcache_algorithm), strings));
+        EXPECT(!corrupt(item + offsetof(find_db_image::Item, kcache_network_config), strings));
+        EXPECT(!corrupt(str + offsetof(find_db_image::StringRef, size), 0xFFFFFFFF));
+        EXPECT(!corrupt(str + offsetof(find_db_image::StringRef, offset), 0xFFFFFFFF));
+        // The second record gets the key of the first one, so the keys are not sorted anymore.
+        auto first_key = uint32_t{};
+        std::memcpy(&first_key, &image[record], sizeof(first_key));
+        EXPECT(!corrupt(record + sizeof(find_db_image::Record), first_key));
+    }
+
+    // Writes a text db and the image of find_db_text, made when the text was dated 1000.
+    static std::string
+    WriteDb(const TmpDir& dir, const std::string& name, const std::string& text, std::time_t mtime)
+    {
+        const auto text_path = (dir.path / (name + ".txt")).string();
+        std::ofstream(text_path, std::ios::binary) << text;
+        boost::filesystem::last_write_time(text_path, mtime);
+
+        auto writer = find_db_image::Writer{};
+        auto source = std::istringstream{find_db_text};
+        auto error  = std::string{};
+        EXPECT(writer.Parse(source, error));
+        writer.SetSource(source.str().size(), 1000, md5(source.str()));
+
+        auto image = std::ofstream{(dir.path / (name + ".bin")).string(), std::ios::binary};
+        writer.Write(image);
+        return text_path;
+    }
+
+    static float GemmTime(const std::string& text_path)
+    {
+        auto items = std::vector<std::pair<std::string, FindDbData>>{};
+        EXPECT(ReadonlyRamDb::GetCached(text_path, true).FindItems(std::string{fwd_key}, items));
+        EXPECT_EQUAL(items.size(), 2u);
+        const auto gemm = std::find_if(items.begin(), items.end(), [](const auto& item) {
+            return item.first == "miopenConvolutionFwdAlgoGEMM";
+        });
+        EXPECT(gemm != items.end());
+        return gemm->second.time;
+    }
+
+    // Entries are taken from the image fields and match the ones parsed from the text.
+    static void CheckFindItems()
+    {
+        TmpDir dir{"find_db_image"};
+        const auto text_path = WriteDb(dir, "fdb", find_db_text, 1000);
+        const auto& db       = ReadonlyRamDb::GetCached(text_path, true);
+        auto items           = std::vector<std::pair<std::string, FindDbData>>{};
+        EXPECT(db.FindItems(std::string{fwd_key}, items));
+        EXPECT_EQUAL(items.size(), 2u);
+
+        const auto record = db.FindRecord(std::string{fwd_key});
+        EXPECT(record);
+        for(const auto& item : items)
+        {
+            auto parsed = FindDbData{};
+            EXPECT(record->GetValues(item.first, parsed));
+            EXPECT_EQUAL(item.second.solver_id, parsed.solver_id);
+            EXPECT_EQUAL(item.second.time, parsed.time);
+            EXPECT_EQUAL(item.second.workspace, parsed.workspace);
+            EXPECT_EQUAL(item.second.kcache_key.algorithm_name, parsed.kcache_key.algorithm_name);
+            EXPECT_EQUAL(item.second.kcache_key.network_config, parsed.kcache_key.network_config);
+        }
+
+        EXPECT(!db.FindItems(std::string{"2-3-4"}, items));
+    }
+
+    // The image holds the gemm time 6.02447. The edited text has the same size, but 6.02448.
+    static void CheckStaleness()
+    {
+        TmpDir dir{"find_db_image"};
+        auto edited_text = std::string{find_db_text};
+        edited_text[edited_text.find("6.02447") + 6] = '8';
+
+        // The timestamp matches, so the image is used.
+        EXPECT_EQUAL(GemmTime(WriteDb(dir, "same", find_db_text, 1000)), 6.02447f);
+        // A copy with a new timestamp: the digest matches, the image is still used.
+        EXPECT_EQUAL(GemmTime(WriteDb(dir, "copied", find_db_text, 2000)), 6.02447f);
+        // An edit of the same size: the digest differs, the text is used.
+        EXPECT_EQUAL(GemmTime(WriteDb(dir, "edited", edited_text, 2000)), 6.02448f);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { run_test<miopen::tests::FindDbImageTest>(); }
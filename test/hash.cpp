@@ -0,0 +1,80 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/fast_hash.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/simple_hash.hpp>
+
+#include "test.hpp"
+
+#include <string>
+
+void check_md5()
+{
+    EXPECT(miopen::md5("") == "d41d8cd98f00b204e9800998ecf8427e");
+    EXPECT(miopen::md5("abc") == "900150983cd24fb0d6963f7d28e17f72");
+
+    // Feeding the pieces one by one hashes the same as hashing them concatenated, across the
+    // 64-byte block boundaries as well.
+    const auto text = std::string(1000, 'x') + "-gfx906:" + std::string(100, 'y');
+    for(const auto split : {0, 1, 63, 64, 65, 1000})
+    {
+        miopen::Md5Hasher hasher;
+        hasher.Update(text.substr(0, split)).Update(text.substr(split));
+        EXPECT(hasher.HexDigest() == miopen::md5(text));
+        EXPECT(hasher.HexDigest() == miopen::md5(""));
+    }
+}
+
+void check_fast_hash()
+{
+    // MurmurHash3_x64_128 reference values.
+    EXPECT(miopen::fast_hash("") == miopen::Hash128{});
+    EXPECT(miopen::fast_hash("hello").ToString() == "5b1e906a48ae1d19cbd8a7b341bd9b02");
+    EXPECT(miopen::fast_hash("The quick brown fox jumps over the lazy dog").ToString() ==
+           "7a433ca9c49a9347e34bbc7bbc071b6c");
+
+    const auto text = std::string(1000, 'x') + "-gfx906:" + std::string(100, 'y');
+    for(const auto split : {0, 1, 15, 16, 17, 1000})
+    {
+        miopen::FastHasher hasher;
+        hasher.Update(text.substr(0, split)).Update(text.substr(split));
+        EXPECT(hasher.Finalize() == miopen::fast_hash(text));
+    }
+
+    const auto ab = miopen::FastHasher{}.UpdatePiece("a").UpdatePiece("b").Finalize();
+    EXPECT(ab != miopen::FastHasher{}.UpdatePiece("ab").UpdatePiece("").Finalize());
+    EXPECT(ab != miopen::FastHasher{}.UpdatePiece("b").UpdatePiece("a").Finalize());
+
+    const auto hash = miopen::SimpleHash{};
+    EXPECT(hash({"conv", "fwd"}) != hash({"fwd", "conv"}));
+    EXPECT(hash({"same", "same"}) != hash({"other", "other"}));
+}
+
+int main()
+{
+    check_md5();
+    check_fast_hash();
+}
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <half.hpp>
+#include <miopen/bfloat16.hpp>
+
+#include "host_gemm.hpp"
+#include "test.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+template <class T>
+std::vector<T> make_matrix(std::size_t rows, std::size_t stride, int seed)
+{
+    std::vector<T> m(rows * stride);
+    std::srand(seed);
+    for(auto& x : m)
+        x = static_cast<T>(static_cast<float>(std::rand() % 17 - 8) / 8);
+    return m;
+}
+
+template <class Acc, class T>
+void check_host_gemm(std::size_t m, std::size_t n, std::size_t k, bool ta, bool tb)
+{
+    const auto lda = (ta ? m : k) + 3;
+    const auto ldb = (tb ? k : n) + 1;
+    const auto ldc = n + 2;
+    const auto a   = make_matrix<T>(ta ? k : m, lda, 1);
+    const auto b   = make_matrix<T>(tb ? n : k, ldb, 2);
+    auto c         = make_matrix<float>(m, ldc, 3);
+    auto ref       = c;
+
+    host_gemm<Acc>(ta, tb, m, n, k, 0.5, a.data(), lda, b.data(), ldb, 2.0, c.data(), ldc);
+
+    for(std::size_t i = 0; i < m; ++i)
+    {
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            double x = 0;
+            for(std::size_t p = 0; p < k; ++p)
+                x += static_cast<double>(ta ? a[p * lda + i] : a[i * lda + p]) *
+                     static_cast<double>(tb ? b[j * ldb + p] : b[p * ldb + j]);
+            ref[i * ldc + j] = static_cast<float>(2.0 * ref[i * ldc + j] + 0.5 * x);
+        }
+    }
+
+    // The inputs are multiples of 1/8, so the products and the sums are exact.
+    for(std::size_t i = 0; i < c.size(); ++i)
+        EXPECT_EQUAL(c[i], ref[i]);
+}
+
+template <class Acc, class T>
+void check_host_gemm_sizes()
+{
+    for(std::size_t m : {1, 7, 8, 9, 130})
+        for(std::size_t n : {1, 15, 16, 17, 300})
+            for(std::size_t k : {1, 255, 256, 257})
+                for(int t = 0; t < 4; ++t)
+                    check_host_gemm<Acc, T>(m, n, k, (t & 1) != 0, (t & 2) != 0);
+}
+
+void check_host_gemm_accessors()
+{
+    // Each element of C must be stored exactly once.
+    const std::size_t m = 70;
+    const std::size_t n = 90;
+    std::vector<int> stores(m * n, 0);
+    host_gemm<double>(
+        m,
+        n,
+        5,
+        [](std::size_t i, std::size_t) { return static_cast<double>(i); },
+        [](std::size_t, std::size_t j) { return static_cast<double>(j); },
+        [&](std::size_t i, std::size_t j, double x) {
+            EXPECT_EQUAL(x, 5.0 * i * j);
+            stores[i * n + j]++;
+        });
+    for(auto s : stores)
+        EXPECT_EQUAL(s, 1);
+}
+
+int main()
+{
+    check_host_gemm_sizes<float, float>();
+    check_host_gemm_sizes<double, float>();
+    check_host_gemm_sizes<double, double>();
+    check_host_gemm_sizes<float, half_float::half>();
+    check_host_gemm_sizes<float, bfloat16>();
+    check_host_gemm_accessors();
+}
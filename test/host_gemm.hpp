@@ -0,0 +1,288 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_TEST_HOST_GEMM_HPP
+#define GUARD_MIOPEN_TEST_HOST_GEMM_HPP
+
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MIOPEN_HOST_GEMM_X86_DISPATCH 1
+#else
+#define MIOPEN_HOST_GEMM_X86_DISPATCH 0
+#endif
+
+/// Host GEMM shared by the CPU references of the tests and of the driver.
+///
+/// C is split into tiles computed on the par_for() pool. For each tile, panels of A and B are
+/// packed into contiguous buffers of the accumulation type, which also converts fp16/bf16 inputs
+/// and handles transposed layouts, and the tile is computed by a register blocked micro-kernel.
+/// The micro-kernel is built for AVX-512, AVX2 and the baseline ISA, and the one to use is
+/// selected at run time.
+namespace host_gemm_detail {
+
+template <class Acc>
+struct Blocking;
+
+template <>
+struct Blocking<float>
+{
+    static constexpr std::size_t mr = 8;
+    static constexpr std::size_t nr = 16;
+    static constexpr std::size_t mc = 128;
+    static constexpr std::size_t kc = 256;
+    static constexpr std::size_t nc = 512;
+    typedef float Vec __attribute__((vector_size(nr * sizeof(float))));
+};
+
+template <>
+struct Blocking<double>
+{
+    static constexpr std::size_t mr = 8;
+    static constexpr std::size_t nr = 8;
+    static constexpr std::size_t mc = 128;
+    static constexpr std::size_t kc = 256;
+    static constexpr std::size_t nc = 256;
+    typedef double Vec __attribute__((vector_size(nr * sizeof(double))));
+};
+
+inline std::size_t div_ceil(std::size_t x, std::size_t y) { return (x + y - 1) / y; }
+
+/// Adds the product of kc columns of a packed A micro-panel and kc rows of a packed B
+/// micro-panel to an mr x nr block of C. One row of the block is held in a single vector.
+template <class Acc>
+inline __attribute__((always_inline)) void
+MicroKernelImpl(std::size_t kc, const Acc* a, const Acc* b, Acc* c, std::size_t ldc)
+{
+    constexpr auto mr = Blocking<Acc>::mr;
+    constexpr auto nr = Blocking<Acc>::nr;
+    using Vec         = typename Blocking<Acc>::Vec;
+
+    Vec acc[mr] = {};
+    for(std::size_t p = 0; p < kc; ++p)
+    {
+        Vec bv;
+        std::memcpy(&bv, b + p * nr, sizeof(bv));
+        for(std::size_t i = 0; i < mr; ++i)
+            acc[i] += a[p * mr + i] * bv;
+    }
+    for(std::size_t i = 0; i < mr; ++i)
+    {
+        Vec cv;
+        std::memcpy(&cv, c + i * ldc, sizeof(cv));
+        cv += acc[i];
+        std::memcpy(c + i * ldc, &cv, sizeof(cv));
+    }
+}
+
+template <class Acc>
+void MicroKernelBase(std::size_t kc, const Acc* a, const Acc* b, Acc* c, std::size_t ldc)
+{
+    MicroKernelImpl(kc, a, b, c, ldc);
+}
+
+#if MIOPEN_HOST_GEMM_X86_DISPATCH
+template <class Acc>
+__attribute__((target("avx2"))) void
+MicroKernelAvx2(std::size_t kc, const Acc* a, const Acc* b, Acc* c, std::size_t ldc)
+{
+    MicroKernelImpl(kc, a, b, c, ldc);
+}
+
+template <class Acc>
+__attribute__((target("avx512f"))) void
+MicroKernelAvx512(std::size_t kc, const Acc* a, const Acc* b, Acc* c, std::size_t ldc)
+{
+    MicroKernelImpl(kc, a, b, c, ldc);
+}
+#endif
+
+template <class Acc>
+using MicroKernel = void (*)(std::size_t, const Acc*, const Acc*, Acc*, std::size_t);
+
+template <class Acc>
+MicroKernel<Acc> SelectMicroKernel()
+{
+#if MIOPEN_HOST_GEMM_X86_DISPATCH
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f"))
+        return &MicroKernelAvx512<Acc>;
+    if(__builtin_cpu_supports("avx2"))
+        return &MicroKernelAvx2<Acc>;
+#endif
+    return &MicroKernelBase<Acc>;
+}
+
+/// Packs rows [i0, i0 + mc) and columns [p0, p0 + kc) of A into micro-panels of mr rows stored
+/// column by column. Rows past the end of A are filled with zeros.
+template <class Acc, class AF>
+void PackA(AF& a, std::size_t m, std::size_t i0, std::size_t mc, std::size_t p0, std::size_t kc,
+           Acc* dst)
+{
+    constexpr auto mr = Blocking<Acc>::mr;
+    for(std::size_t ir = 0; ir < mc; ir += mr)
+    {
+        for(std::size_t p = 0; p < kc; ++p)
+        {
+            for(std::size_t i = 0; i < mr; ++i)
+            {
+                const auto row = i0 + ir + i;
+                *dst++ = row < m ? static_cast<Acc>(a(row, p0 + p)) : Acc{0};
+            }
+        }
+    }
+}
+
+/// Packs rows [p0, p0 + kc) and columns [j0, j0 + nc) of B into micro-panels of nr columns
+/// stored row by row. Columns past the end of B are filled with zeros.
+template <class Acc, class BF>
+void PackB(BF& b, std::size_t n, std::size_t p0, std::size_t kc, std::size_t j0, std::size_t nc,
+           Acc* dst)
+{
+    constexpr auto nr = Blocking<Acc>::nr;
+    for(std::size_t jr = 0; jr < nc; jr += nr)
+    {
+        for(std::size_t p = 0; p < kc; ++p)
+        {
+            for(std::size_t j = 0; j < nr; ++j)
+            {
+                const auto col = j0 + jr + j;
+                *dst++ = col < n ? static_cast<Acc>(b(p0 + p, col)) : Acc{0};
+            }
+        }
+    }
+}
+
+} // namespace host_gemm_detail
+
+/// C = A * B, where A is m x k and B is k x n. Elements are read with a(i, kk) and b(kk, j),
+/// converted to Acc and accumulated in Acc. Each result is passed exactly once to
+/// c(i, j, value), so that the caller can apply alpha and beta.
+template <class Acc, class AF, class BF, class CF>
+void host_gemm(std::size_t m, std::size_t n, std::size_t k, AF a, BF b, CF c)
+{
+    static_assert(std::is_same<Acc, float>{} || std::is_same<Acc, double>{},
+                  "Accumulation is supported in fp32 and fp64");
+    using namespace host_gemm_detail;
+    using B = Blocking<Acc>;
+
+    if(m == 0 || n == 0)
+        return;
+
+    static const auto micro_kernel = SelectMicroKernel<Acc>();
+
+    // Narrow the tiles of C when there are too few of them to keep the pool busy.
+    const auto threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    const auto m_tiles = div_ceil(m, B::mc);
+    const auto n_split = div_ceil(threads, m_tiles);
+    const auto nc      = std::min(B::nc, div_ceil(div_ceil(n, n_split), B::nr) * B::nr);
+    const auto n_tiles = div_ceil(n, nc);
+
+    const auto tile = [&](std::size_t t) {
+        const auto i0  = (t / n_tiles) * B::mc;
+        const auto j0  = (t % n_tiles) * nc;
+        const auto mc  = std::min(B::mc, m - i0);
+        const auto ncc = std::min(nc, n - j0);
+        const auto mcp = div_ceil(mc, B::mr) * B::mr;
+        const auto ncp = div_ceil(ncc, B::nr) * B::nr;
+
+        std::vector<Acc> a_panel(mcp * B::kc);
+        std::vector<Acc> b_panel(B::kc * ncp);
+        std::vector<Acc> c_tile(mcp * ncp, Acc{0});
+
+        for(std::size_t p0 = 0; p0 < k; p0 += B::kc)
+        {
+            const auto kc = std::min(B::kc, k - p0);
+            PackA(a, m, i0, mcp, p0, kc, a_panel.data());
+            PackB(b, n, p0, kc, j0, ncp, b_panel.data());
+
+            for(std::size_t jr = 0; jr < ncp; jr += B::nr)
+            {
+                for(std::size_t ir = 0; ir < mcp; ir += B::mr)
+                {
+                    micro_kernel(
+                        kc, &a_panel[ir * kc], &b_panel[jr * kc], &c_tile[ir * ncp + jr], ncp);
+                }
+            }
+        }
+
+        for(std::size_t i = 0; i < mc; ++i)
+            for(std::size_t j = 0; j < ncc; ++j)
+                c(i0 + i, j0 + j, c_tile[i * ncp + j]);
+    };
+
+    const auto tiles = m_tiles * n_tiles;
+    if(tiles > 1 && m * n * k >= 64 * 64 * 64)
+        miopen::par_for(tiles, miopen::min_grain{1}, tile);
+    else
+        for(std::size_t t = 0; t < tiles; ++t)
+            tile(t);
+}
+
+/// Strided, row major GEMM: C = alpha * op(A) * op(B) + beta * C, where op(A) is m x k and
+/// op(B) is k x n.
+template <class Acc, class TA, class TB, class TC>
+void host_gemm(bool transpose_a,
+               bool transpose_b,
+               std::size_t m,
+               std::size_t n,
+               std::size_t k,
+               double alpha,
+               const TA* a,
+               std::size_t lda,
+               const TB* b,
+               std::size_t ldb,
+               double beta,
+               TC* c,
+               std::size_t ldc)
+{
+    const auto c_out = [&](std::size_t i, std::size_t j, Acc x) {
+        auto& dst = c[i * ldc + j];
+        dst       = static_cast<TC>(static_cast<Acc>(beta) * static_cast<Acc>(dst) +
+                              static_cast<Acc>(alpha) * x);
+    };
+    const auto a_n = [&](std::size_t i, std::size_t p) { return a[i * lda + p]; };
+    const auto a_t = [&](std::size_t i, std::size_t p) { return a[p * lda + i]; };
+    const auto b_n = [&](std::size_t p, std::size_t j) { return b[p * ldb + j]; };
+    const auto b_t = [&](std::size_t p, std::size_t j) { return b[j * ldb + p]; };
+
+    if(!transpose_a && !transpose_b)
+        host_gemm<Acc>(m, n, k, a_n, b_n, c_out);
+    else if(transpose_a && !transpose_b)
+        host_gemm<Acc>(m, n, k, a_t, b_n, c_out);
+    else if(!transpose_a && transpose_b)
+        host_gemm<Acc>(m, n, k, a_n, b_t, c_out);
+    else
+        host_gemm<Acc>(m, n, k, a_t, b_t, c_out);
+}
+
+#endif // GUARD_MIOPEN_TEST_HOST_GEMM_HPP
@@ -0,0 +1,192 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/invoker_cache.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/lru_cache.hpp>
+#include <miopen/problem_key.hpp>
+
+#include "test.hpp"
+
+#include <string>
+
+static miopen::ProblemKey MakeKey(int batch_size)
+{
+    auto key         = miopen::ProblemKey{};
+    key.spatial_dims = 2;
+    key.batch_size   = batch_size;
+    key.direction    = 'F';
+    key.SetLayout("NCHW");
+    key.UpdateHash();
+    return key;
+}
+
+static void check_lru_order()
+{
+    auto cache = miopen::LruCache<int, std::string>{2};
+    cache.GetOrInsert(1) = "one";
+    cache.GetOrInsert(2) = "two";
+    // Refreshes 1, so that 2 is the least recently used one.
+    EXPECT(cache.Find(1) != nullptr);
+    cache.GetOrInsert(3) = "three";
+
+    EXPECT_EQUAL(cache.Size(), 2u);
+    EXPECT(cache.Peek(2) == nullptr);
+    EXPECT(*cache.Peek(1) == "one");
+    EXPECT(*cache.Peek(3) == "three");
+
+    // Peek does not refresh: 1 is still older than 3.
+    cache.GetOrInsert(4);
+    EXPECT(cache.Peek(1) == nullptr);
+    EXPECT(cache.Peek(3) != nullptr);
+
+    const auto stats = cache.GetStats([](int, const std::string& value) { return value.size(); });
+    EXPECT_EQUAL(stats.evictions, 2u);
+    EXPECT_EQUAL(stats.entries, 2u);
+    EXPECT_EQUAL(stats.capacity, 2u);
+    EXPECT_EQUAL(stats.bytes, std::string{"three"}.size());
+
+    EXPECT(cache.Erase(3));
+    EXPECT(!cache.Erase(3));
+    EXPECT_EQUAL(cache.Size(), 1u);
+}
+
+static void check_lru_capacity()
+{
+    auto unbounded = miopen::LruCache<int, int>{};
+    for(auto i = 0; i < 1000; ++i)
+        unbounded.GetOrInsert(i) = i;
+    EXPECT_EQUAL(unbounded.Size(), 1000u);
+
+    unbounded.SetCapacity(10);
+    EXPECT_EQUAL(unbounded.Size(), 10u);
+    for(auto i = 990; i < 1000; ++i)
+        EXPECT(unbounded.Peek(i) != nullptr && *unbounded.Peek(i) == i);
+
+    unbounded.SetCapacity(0);
+    for(auto i = 0; i < 100; ++i)
+        unbounded.GetOrInsert(i);
+    EXPECT_EQUAL(unbounded.Size(), 110u);
+}
+
+static void check_invoker_cache()
+{
+    auto calls   = 0;
+    auto invoker = miopen::Invoker{[&](const miopen::Handle&, const boost::any&) { ++calls; }};
+
+    auto cache      = miopen::InvokerCache{};
+    auto generation = cache.GetGeneration();
+    cache.SetCapacity(2);
+    EXPECT(cache.GetGeneration() != generation);
+    generation = cache.GetGeneration();
+    cache.Register({MakeKey(1), "SolverA"}, invoker);
+    cache.Register({MakeKey(1), "SolverB"}, invoker);
+    cache.SetAsFound1_0(MakeKey(1), "AlgoA", "SolverA");
+    cache.Register({MakeKey(2), "SolverA"}, invoker);
+    EXPECT_EQUAL(cache.GetGeneration(), generation);
+
+    EXPECT(cache[{MakeKey(1), "SolverB"}]);
+    EXPECT(!cache[{MakeKey(2), "SolverB"}]);
+    EXPECT(cache.GetFound1_0(MakeKey(1), "AlgoA"));
+
+    // Problem 2 is the least recently used one.
+    cache.Register({MakeKey(3), "SolverA"}, invoker);
+    EXPECT(cache.GetGeneration() != generation);
+    EXPECT(!cache[{MakeKey(2), "SolverA"}]);
+    EXPECT(cache.GetFound1_0(MakeKey(1), "AlgoA"));
+    EXPECT(cache[{MakeKey(3), "SolverA"}]);
+
+    // Problem 1 is the least recently used one now. An evicted problem can be registered again.
+    cache.Register({MakeKey(2), "SolverA"}, invoker);
+    EXPECT(cache[{MakeKey(2), "SolverA"}]);
+    EXPECT(!cache[{MakeKey(1), "SolverA"}]);
+    EXPECT(!cache.GetFound1_0(MakeKey(1), "AlgoA"));
+    CHECK(throws([&] { cache.SetAsFound1_0(MakeKey(1), "AlgoA", "SolverA"); }));
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQUAL(stats.hits, 5u);
+    EXPECT_EQUAL(stats.misses, 4u);
+    EXPECT_EQUAL(stats.evictions, 2u);
+    EXPECT_EQUAL(stats.entries, 2u);
+    EXPECT_EQUAL(stats.capacity, 2u);
+    EXPECT(stats.bytes > 0);
+    EXPECT_EQUAL(calls, 0);
+
+    // The code objects the invokers keep alive are counted once per registered invoker.
+    auto sized = miopen::InvokerCache{};
+    sized.Register({MakeKey(1), "SolverA"}, invoker, 1000);
+    sized.Register({MakeKey(1), "SolverA"}, invoker, 1000);
+    const auto bookkeeping = sized.GetStats().bytes - 1000;
+    sized.Register({MakeKey(1), "SolverB"}, invoker, 500);
+    EXPECT(sized.GetStats().bytes >= bookkeeping + 1500);
+    EXPECT(sized.GetStats().bytes < bookkeeping + 2000);
+}
+
+// Kernels of the algorithms without invokers can only be built by Find, and those of fusion plans
+// by compiling the plan, so they are not evicted.
+static void check_pinned_kernels()
+{
+    auto cache = miopen::KernelCache{};
+    cache.SetCapacity(1);
+    cache.AddKernel({"miopenConvolutionBwdWeightsAlgoWinograd", "wrw"}, miopen::Kernel{}, 0);
+    cache.AddKernel({"miopenConvolutionFwdAlgoFFT", "fft"}, miopen::Kernel{}, 0);
+    cache.AddKernel({"miopenConvolutionFwdAlgoDirect", "a"}, miopen::Kernel{}, 0);
+    cache.AddKernel({"miopenConvolutionFwdAlgoDirect", "b"}, miopen::Kernel{}, 0);
+
+    EXPECT(cache.HasKernels("miopenConvolutionBwdWeightsAlgoWinograd", "wrw"));
+    EXPECT(cache.HasKernels("miopenConvolutionFwdAlgoFFT", "fft"));
+    EXPECT(!cache.HasKernels("miopenConvolutionFwdAlgoDirect", "a"));
+    EXPECT(cache.HasKernels("miopenConvolutionFwdAlgoDirect", "b"));
+    EXPECT_EQUAL(cache.GetKernels("miopenConvolutionFwdAlgoFFT", "fft").size(), 1u);
+
+    cache.AddKernel({"miopenConvolutionDirectBiasActiv", "fusion"}, miopen::Kernel{}, 0);
+    cache.PinKernels("miopenConvolutionDirectBiasActiv", "fusion");
+    cache.AddKernel({"miopenConvolutionFwdAlgoDirect", "c"}, miopen::Kernel{}, 0);
+    EXPECT(cache.HasKernels("miopenConvolutionDirectBiasActiv", "fusion"));
+    EXPECT(!cache.HasKernels("miopenConvolutionFwdAlgoDirect", "b"));
+    EXPECT(cache.HasKernels("miopenConvolutionFwdAlgoDirect", "c"));
+    // Kernels added later for a pinned key are pinned as well.
+    cache.AddKernel({"miopenConvolutionDirectBiasActiv", "fusion"}, miopen::Kernel{}, 1);
+    EXPECT_EQUAL(cache.GetKernels("miopenConvolutionDirectBiasActiv", "fusion").size(), 2u);
+
+    // The kernels are returned by value, as adding kernels may evict their group meanwhile.
+    const auto kernels = cache.GetKernels("miopenConvolutionFwdAlgoDirect", "c");
+    cache.AddKernel({"miopenConvolutionFwdAlgoDirect", "d"}, miopen::Kernel{}, 0);
+    EXPECT(!cache.HasKernels("miopenConvolutionFwdAlgoDirect", "c"));
+    EXPECT_EQUAL(kernels.size(), 1u);
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQUAL(stats.evictions, 3u);
+    EXPECT_EQUAL(stats.entries, 4u);
+}
+
+int main()
+{
+    check_lru_order();
+    check_lru_capacity();
+    check_invoker_cache();
+    check_pinned_kernels();
+}
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/kernel_model.hpp>
+
+#include "test.hpp"
+
+#include <cstddef>
+#include <vector>
+
+using miopen::solver::DeviceModel;
+using miopen::solver::KernelModel;
+
+static KernelModel Kernel(std::size_t block_size,
+                          std::size_t grid_size,
+                          std::size_t lds_bytes,
+                          std::size_t vgprs,
+                          std::size_t acc_vgprs = 0)
+{
+    auto kernel       = KernelModel{};
+    kernel.block_size = block_size;
+    kernel.grid_size  = grid_size;
+    kernel.lds_bytes  = lds_bytes;
+    kernel.vgprs      = vgprs;
+    kernel.acc_vgprs  = acc_vgprs;
+    return kernel;
+}
+
+static void check_infeasible()
+{
+    const auto device = DeviceModel{};
+
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 65536, 64), device) == 1);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 65537, 64), device) == 0);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 0, 256), device) == 1);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 0, 257), device) == 0);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(4096, 64, 0, 16), device) == 0);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(0, 64, 0, 16), device) == 0);
+    EXPECT(miopen::solver::GetKernelScore(Kernel(256, 64, 65537, 64), device) == 0.0f);
+}
+
+static void check_occupancy()
+{
+    auto device = DeviceModel{};
+
+    // 4 waves per workgroup, one per SIMD.
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 0, 64), device) == 4);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 0, 62), device) == 4);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 16384, 64), device) == 4);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 32768, 64), device) == 2);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(64, 64, 0, 16), device) == 40);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 0, 16), device) == 10);
+
+    // Accumulation registers take VGPRs unless the device has AGPRs.
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 0, 64, 128), device) == 1);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 0, 64, 256), device) == 0);
+    device.has_acc_vgprs = true;
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 0, 64, 128), device) == 2);
+    EXPECT(miopen::solver::GetWorkgroupsPerCu(Kernel(256, 64, 0, 64, 256), device) == 1);
+}
+
+static void check_score()
+{
+    const auto device = DeviceModel{};
+    const auto score  = [&](const KernelModel& kernel) {
+        return miopen::solver::GetKernelScore(kernel, device);
+    };
+
+    // A grid one workgroup larger than the device leaves almost all compute units idle for
+    // half the time.
+    EXPECT(score(Kernel(256, 128, 0, 64)) > score(Kernel(256, 129, 0, 64)));
+    // Too few waves cannot hide the latencies.
+    EXPECT(score(Kernel(256, 128, 0, 64)) > score(Kernel(256, 64, 0, 64)));
+    EXPECT(score(Kernel(256, 128, 0, 64)) == score(Kernel(256, 256, 0, 64)));
+
+    auto padded            = Kernel(256, 128, 0, 64);
+    padded.tile_efficiency = 0.5f;
+    EXPECT(score(padded) < score(Kernel(256, 128, 0, 64)));
+
+    auto reusing  = Kernel(256, 128, 0, 64);
+    reusing.reuse = 64.0f;
+    EXPECT(score(reusing) > score(Kernel(256, 128, 0, 64)));
+}
+
+static void check_gemm_model()
+{
+    const auto model =
+        miopen::solver::GetBlockwiseGemmModel(100, 256, 64, 128, 8, 256, 4, 12288, 4);
+    EXPECT(model.block_size == 256);
+    EXPECT(model.grid_size == 4);
+    EXPECT(model.lds_bytes == 12288);
+    EXPECT(model.tile_efficiency == 100.0f / 128.0f);
+    EXPECT(model.reuse > 64.0f && model.reuse < 128.0f);
+    EXPECT(model.vgprs > 0);
+
+    // Larger tiles reuse more of the data read into LDS.
+    const auto small = miopen::solver::GetBlockwiseGemmModel(256, 256, 32, 32, 8, 64, 64, 2048, 4);
+    const auto large =
+        miopen::solver::GetBlockwiseGemmModel(256, 256, 128, 128, 8, 256, 4, 8192, 4);
+    EXPECT(large.reuse > small.reuse);
+    EXPECT(large.tile_efficiency == 1.0f);
+}
+
+static void check_rank()
+{
+    const auto device  = DeviceModel{};
+    const auto kernels = std::vector<KernelModel>{
+        Kernel(256, 64, 0, 64),      // 0: one wave per SIMD
+        Kernel(256, 64, 65537, 64),  // 1: does not fit into LDS
+        Kernel(256, 128, 0, 64),     // 2: best
+        Kernel(256, 129, 0, 64),     // 3: tail
+        Kernel(256, 256, 0, 64),     // 4: as good as 2
+        Kernel(256, 128, 0, 300),    // 5: too many VGPRs
+    };
+
+    const auto all = miopen::solver::RankKernels(kernels, device, 0);
+    EXPECT(all == std::vector<std::size_t>({2, 4, 3, 0}));
+
+    const auto top = miopen::solver::RankKernels(kernels, device, 3);
+    EXPECT(top == std::vector<std::size_t>({2, 4, 3}));
+
+    EXPECT(miopen::solver::RankKernels(kernels, device, 100).size() == 4);
+    EXPECT(miopen::solver::RankKernels({}, device, 3).empty());
+}
+
+int main()
+{
+    check_infeasible();
+    check_occupancy();
+    check_score();
+    check_gemm_model();
+    check_rank();
+}
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/kernel.hpp>
+#include <miopen/md5.hpp>
+
+#include "test.hpp"
+
+#include <string>
+
+void check_kernel_src_view()
+{
+    const auto& view = miopen::GetKernelSrcView("MIOpenSoftmax.cl");
+    CHECK(!view.empty());
+    CHECK(view.md5() != nullptr);
+    CHECK(miopen::md5(view.str()) == view.md5());
+    CHECK(view.str() == miopen::GetKernelSrc("MIOpenSoftmax.cl"));
+    // The views refer to the embedded arrays, which stay in place between calls.
+    CHECK(miopen::GetKernelSrcView("MIOpenSoftmax.cl").data() == view.data());
+    CHECK(throws([]() { miopen::GetKernelSrcView("NoSuchKernel.cl"); }));
+}
+
+void check_kernel_inc_view()
+{
+    for(const auto& inc : miopen::GetKernelIncList())
+    {
+        const auto& view = miopen::GetKernelIncView(inc);
+        CHECK(view.md5() != nullptr);
+        CHECK(miopen::md5(view.str()) == view.md5());
+        CHECK(view.str() == miopen::GetKernelInc(inc));
+    }
+    CHECK(throws([]() { miopen::GetKernelIncView("no_such_include.h"); }));
+}
+
+void check_kernel_src_digest()
+{
+    const auto& view = miopen::GetKernelSrcView("MIOpenSoftmax.cl");
+    CHECK(miopen::GetKernelSrcDigest("MIOpenSoftmax.cl") == view.md5());
+    CHECK(miopen::GetKernelSrcDigest("NoSuchKernel.cl").empty());
+
+    // HIP sources are built with the include files, which their digest covers as well.
+    const auto hip_kernel =
+        "gridwise_convolution_backward_data_implicit_gemm_v1r1_nchw_kcyx_nkhw.cpp";
+    const auto hip_digest = miopen::GetKernelSrcDigest(hip_kernel);
+    CHECK(hip_digest.size() == 32);
+    CHECK(hip_digest != miopen::GetKernelSrcView(hip_kernel).md5());
+    CHECK(hip_digest == miopen::GetKernelSrcDigest(hip_kernel));
+}
+
+void check_runtime_source_view()
+{
+    const std::string src = "__kernel void f() {}";
+    const miopen::KernelSourceView view{src};
+    CHECK(view.data() == src.data());
+    CHECK(view.size() == src.size());
+    CHECK(view.md5() == nullptr);
+}
+
+int main()
+{
+    check_kernel_src_view();
+    check_kernel_inc_view();
+    check_kernel_src_digest();
+    check_runtime_source_view();
+}
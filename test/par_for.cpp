@@ -0,0 +1,90 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/par_for.hpp>
+
+#include "test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+void check_par_for_visits_all()
+{
+    for(std::size_t n : {0, 1, 7, 64, 1000, 100003})
+    {
+        std::vector<int> visits(n, 0);
+        miopen::par_for(n, [&](auto i) { visits[i]++; });
+        EXPECT(std::all_of(visits.begin(), visits.end(), [](int v) { return v == 1; }));
+
+        // Uses the pool regardless of the number of cores of the machine running the test.
+        std::vector<int> visits_mt(n, 0);
+        miopen::par_for_impl(n, 4, [&](auto i) { visits_mt[i]++; });
+        EXPECT(std::all_of(visits_mt.begin(), visits_mt.end(), [](int v) { return v == 1; }));
+    }
+}
+
+void check_par_for_nested()
+{
+    const std::size_t outer = 64;
+    const std::size_t inner = 256;
+    std::vector<std::atomic<std::size_t>> sums(outer);
+    for(auto& sum : sums)
+        sum = 0;
+
+    miopen::par_for_impl(outer, 4, [&](auto i) {
+        miopen::par_for_impl(inner, 4, [&](auto j) { sums[i] += j; });
+    });
+
+    for(const auto& sum : sums)
+        EXPECT_EQUAL(sum.load(), inner * (inner - 1) / 2);
+}
+
+void check_par_for_exception()
+{
+    std::atomic<std::size_t> count{0};
+    CHECK(throws([&]() {
+        miopen::par_for_impl(1000, 4, [&](auto i) {
+            ++count;
+            if(i == 500)
+                throw std::runtime_error("par_for test");
+        });
+    }));
+    EXPECT(count <= 1000);
+
+    // The pool stays usable after a loop has failed.
+    std::atomic<std::size_t> after{0};
+    miopen::par_for_impl(1000, 4, [&](auto) { ++after; });
+    EXPECT_EQUAL(after.load(), 1000);
+}
+
+int main()
+{
+    check_par_for_visits_all();
+    check_par_for_nested();
+    check_par_for_exception();
+}
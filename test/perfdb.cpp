@@ -282,6 +282,34 @@ class DbFindTest : public DbTest
     }
 };
 
+class DbExternalChangeTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db for noticing changes made behind its back..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        PlainTextDb db(temp_file);
+        ValidateSingleEntry(key(), common_data(), db);
+
+        const std::array<std::pair<const std::string, TestData>, 1> changed_data{{
+            {id2(), value2()},
+        }};
+
+        RawWrite(temp_file, key(), changed_data);
+        ValidateSingleEntry(key(), changed_data, db);
+
+        TestData read;
+        EXPECT(!db.Load(key(), id0(), read));
+
+        ResetDb();
+        EXPECT(!db.FindRecord(key()));
+    }
+};
+
 class DbStoreTest : public DbTest
 {
     public:
@@ -411,6 +439,52 @@ class DbWriteTest : public DbTest
     }
 };
 
+class DbBulkTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db for bulk updates and export..." << std::endl;
+
+        ResetDb();
+        const TestData other_key(9, 10);
+
+        {
+            PlainTextDb db(temp_file);
+
+            EXPECT(db.Update(key(), id0(), value2()));
+        }
+
+        // Later records take precedence over earlier ones and over the ones in the db.
+        std::vector<DbRecord> records(3, DbRecord(key()));
+        EXPECT(records[0].SetValues(id0(), value0()));
+        records[1] = DbRecord(other_key);
+        EXPECT(records[1].SetValues(id0(), value2()));
+        EXPECT(records[2].SetValues(id1(), value1()));
+
+        {
+            PlainTextDb db(temp_file);
+
+            EXPECT(db.UpdateRecords(records));
+        }
+
+        TestData read0, read1;
+        EXPECT(records[0].GetValues(id0(), read0));
+        EXPECT(records[0].GetValues(id1(), read1));
+        EXPECT_EQUAL(value0(), read0);
+        EXPECT_EQUAL(value1(), read1);
+
+        ValidateSingleEntry(key(), common_data(), PlainTextDb(temp_file));
+
+        const auto exported = PlainTextDb(temp_file).ExportRecords();
+        EXPECT_EQUAL(exported.size(), 2u);
+        EXPECT_EQUAL(exported[0].GetKey(), records[0].GetKey());
+        EXPECT_EQUAL(exported[1].GetKey(), records[1].GetKey());
+        EXPECT(exported[1].GetValues(id0(), read0));
+        EXPECT_EQUAL(value2(), read0);
+    }
+};
+
 class DbOperationsTest : public DbTest
 {
     public:
@@ -1292,11 +1366,13 @@ struct PerfDbDriver : test_driver
         }
 
         DbFindTest().Run();
+        DbExternalChangeTest().Run();
         DbStoreTest().Run();
         DbUpdateTest().Run();
         DbRemoveTest().Run();
         DbReadTest().Run();
         DbWriteTest().Run();
+        DbBulkTest().Run();
         DbOperationsTest().Run();
         DbParallelTest().Run();
 
@@ -0,0 +1,156 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/convolution.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/problem_key.hpp>
+
+#include "test.hpp"
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+static_assert(std::is_trivially_copyable<miopen::ProblemKey>{}, "");
+
+struct KeyCase
+{
+    std::vector<std::size_t> in;
+    std::vector<std::size_t> weights;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+    int group_count;
+    miopenDataType_t type;
+    miopen::conv::Direction direction;
+    int bias;
+    // Keys written by previous versions, which have to stay readable.
+    std::string db_key;
+    std::string network_config;
+
+    miopen::ProblemDescription Make() const
+    {
+        const auto dims = in.size() - 2;
+        const auto conv = miopen::ConvolutionDescriptor{dims,
+                                                        miopenConvolution,
+                                                        miopenPaddingDefault,
+                                                        pads,
+                                                        strides,
+                                                        dilations,
+                                                        std::vector<int>(dims, 0),
+                                                        group_count};
+        const auto x = miopen::TensorDescriptor{type, in};
+        const auto w = miopen::TensorDescriptor{type, weights};
+        return {x, w, conv.GetForwardOutputTensor(x, w), conv, direction, bias};
+    }
+};
+
+// clang-format off
+const std::vector<KeyCase>& GetCases()
+{
+    static const std::vector<KeyCase> cases = {
+        {{8, 576, 4, 4}, {192, 576, 1, 1}, {0, 0}, {1, 1}, {1, 1}, 1, miopenFloat, miopen::conv::Direction::Forward, 0,
+         "576-4-4-1x1-192-4-4-8-0x0-1x1-1x1-0-NCHW-FP32-F",
+         "576x4x4x1x1x192x4x4x8xNCHWxFP32x0x0x1x1x1x1x1x1"},
+        {{16, 64, 56, 56}, {64, 64, 3, 3}, {1, 1}, {1, 1}, {1, 1}, 1, miopenHalf, miopen::conv::Direction::BackwardData, 0,
+         "64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP16-B",
+         "64x56x56x3x3x64x56x56x16xNCHWxFP16x1x1x1x1x1x1x1x0"},
+        {{4, 32, 28, 30}, {64, 8, 3, 5}, {1, 2}, {2, 1}, {1, 2}, 4, miopenBFloat16, miopen::conv::Direction::BackwardWeights, 0,
+         "64-14-26-3x5-32-28-30-4-1x2-2x1-1x2-0-NCHW-BF16-W_g4",
+         "64x14x26x3x5x32x28x30x4xNCHWxBF16x1x2x2x1x1x2x4x0"},
+        {{2, 16, 8, 10, 12}, {16, 16, 3, 3, 3}, {1, 1, 1}, {1, 2, 2}, {1, 1, 1}, 1, miopenFloat, miopen::conv::Direction::Forward, 1,
+         "16-8-10-12-3x3x3-16-8-5-6-2-1x1x1-1x2x2-1x1x1-1-NCHW-FP32-F",
+         "16x8x10x12x3x3x3x16x8x5x6x2xNCHWxFP32x1x1x1x1x2x2x1x1x1x1x1"},
+        {{2, 32, 8, 10, 12}, {32, 1, 3, 1, 3}, {0, 1, 2}, {1, 1, 1}, {2, 1, 1}, 32, miopenFloat, miopen::conv::Direction::BackwardData, 0,
+         "32-4-12-14-3x1x3-32-8-10-12-2-0x1x2-1x1x1-2x1x1-0-NCHW-FP32-B_g32",
+         "32x4x12x14x3x1x3x32x8x10x12x2xNCHWxFP32x0x1x2x1x1x1x2x1x1x32x0"},
+    };
+    return cases;
+}
+// clang-format on
+
+template <class TProblem>
+std::string Serialize(const TProblem& problem)
+{
+    std::ostringstream ss;
+    problem.Serialize(ss);
+    return ss.str();
+}
+
+void check_text_forms()
+{
+    for(const auto& c : GetCases())
+    {
+        const auto problem = c.Make();
+        EXPECT_EQUAL(Serialize(problem), c.db_key);
+        EXPECT_EQUAL(Serialize(problem.conv_problem), c.db_key);
+        EXPECT_EQUAL(problem.BuildConfKey().ToString(), c.network_config);
+        EXPECT_EQUAL(problem.conv_problem.BuildConfKey().ToString(), c.network_config);
+        EXPECT_EQUAL(problem.MakeKey().ToDbKey(), c.db_key);
+    }
+}
+
+void check_identity()
+{
+    std::unordered_map<miopen::ProblemKey, std::size_t, miopen::ProblemKey::Hasher> index;
+    const auto& cases = GetCases();
+
+    for(std::size_t i = 0; i < cases.size(); ++i)
+    {
+        const auto key = cases[i].Make().MakeKey();
+        EXPECT(key == cases[i].Make().conv_problem.MakeKey());
+        EXPECT(key.GetHash() == cases[i].Make().MakeKey().GetHash());
+        EXPECT(index.emplace(key, i).second);
+    }
+
+    for(std::size_t i = 0; i < cases.size(); ++i)
+    {
+        const auto key   = cases[i].Make().MakeKey();
+        const auto found = index.find(key);
+        EXPECT(found != index.end() && found->second == i);
+    }
+
+    // Directions that share a network config string are still different problems.
+    auto wrw      = cases[1];
+    wrw.direction = miopen::conv::Direction::BackwardWeights;
+    EXPECT(wrw.Make().BuildConfKey().ToString() == cases[1].network_config);
+    EXPECT(wrw.Make().MakeKey() != cases[1].Make().MakeKey());
+
+    auto copy = cases[0].Make().MakeKey();
+    EXPECT(copy == cases[0].Make().MakeKey());
+    copy.batch_size += 1;
+    copy.UpdateHash();
+    EXPECT(copy != cases[0].Make().MakeKey());
+    EXPECT(index.find(copy) == index.end());
+}
+
+int main()
+{
+    check_text_forms();
+    check_identity();
+}
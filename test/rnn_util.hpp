@@ -34,8 +34,9 @@
 #include <vector>
 #include <cstdlib>
 
+#include "host_gemm.hpp"
+
 #define RNN_MM_TRANSPOSE 1
-#define RNN_MM_USEPARAGEMM 0
 
 inline void createTensorDescArray(std::vector<miopen::TensorDescriptor>& td,
                                   std::vector<miopenTensorDescriptor_t>& ptd,
@@ -158,9 +159,6 @@ void RNN_mm_cpu(const Dtype* a_ptr,
                 double d_alpha,
                 double d_beta)
 {
-
-    auto alpha = Dtype(d_alpha);
-    auto beta  = Dtype(d_beta);
     if((!(a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE) &&
         ((a_cols != b_rows) || (a_rows != c_rows) || (b_cols != c_cols))) ||
        ((a_flags & RNN_MM_TRANSPOSE) && (b_flags & RNN_MM_TRANSPOSE) &&
@@ -176,134 +174,19 @@ void RNN_mm_cpu(const Dtype* a_ptr,
     }
 
     size_t inner_loop = (!(a_flags & RNN_MM_TRANSPOSE)) ? a_cols : a_rows;
-#if(!RNN_MM_USEPARAGEMM)
-    if(!(a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE))
-    {
-
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                double mm_e = 0;
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[m * b_stride + k];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if((a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-
-                double mm_e = 0;
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[m * a_stride + n] * b_ptr[m * b_stride + k];
-#if 0
-					if (
-						(n == 0 && k == 33
-						|| n == 1 && k == 32
-						|| n == 3 && k == 1
-						|| n == 4 && k == 0
-
-						)
-						&& a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] != 0
-						)
-					{
-                        std::cout << "C:mm: " << n << ", " << k << ", " << m << ", " <<
-							mm_e, a_ptr[m*a_stride + n] << ", " <<
-                                b_ptr[m*b_stride + k] << ", " <<
-                                a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] << std::endl;
-					}
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if(!(a_flags & RNN_MM_TRANSPOSE) && (b_flags & RNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                double mm_e = 0;
-
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[k * b_stride + m];
-#if 0
-					if (n == 0 && k == 6 && a_ptr[n*a_stride + m] * b_ptr[k*b_stride + m] != 0)
-					{
-                        std::cout << m << ", " << mm_e << ", " << ", " << a_ptr[n*a_stride + m] << ", " << b_ptr[k*b_stride + m] << std::endl;
-					}
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                double mm_e = 0;
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    c_ptr[n * c_stride + k] += a_ptr[m * a_stride + n] * b_ptr[k * b_stride + m];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-#else
-    auto c_out = [&](int i, int j, double x) {
-        c_ptr[i * c_stride + j] = beta * c_ptr[i * c_stride + j] + alpha * x;
-    };
-
-    if(!(a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE))
-    {
-        gemm(c_rows,
-             c_cols,
-             inner_loop,
-             with_stride(a_ptr, a_stride),
-             with_stride(b_ptr, b_stride),
-             c_out);
-    }
-    else if((a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE))
-    {
-        gemm(c_rows,
-             c_cols,
-             inner_loop,
-             miopen::flip(with_stride(a_ptr, a_stride)),
-             with_stride(b_ptr, b_stride),
-             c_out);
-    }
-    else if(!(a_flags & RNN_MM_TRANSPOSE) && (b_flags & RNN_MM_TRANSPOSE))
-    {
-        gemm(c_rows,
-             c_cols,
-             inner_loop,
-             with_stride(a_ptr, a_stride),
-             miopen::flip(with_stride(b_ptr, b_stride)),
-             c_out);
-    }
-    else
-    {
-        gemm(c_rows,
-             c_cols,
-             inner_loop,
-             miopen::flip(with_stride(a_ptr, a_stride)),
-             miopen::flip(with_stride(b_ptr, b_stride)),
-             c_out);
-#endif
-    }
+    host_gemm<double>((a_flags & RNN_MM_TRANSPOSE) != 0,
+                      (b_flags & RNN_MM_TRANSPOSE) != 0,
+                      c_rows,
+                      c_cols,
+                      inner_loop,
+                      d_alpha,
+                      a_ptr,
+                      a_stride,
+                      b_ptr,
+                      b_stride,
+                      d_beta,
+                      c_ptr,
+                      c_stride);
 }
 
 #endif
@@ -0,0 +1,192 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/search_checkpoint.hpp>
+#include <miopen/search_strategy.hpp>
+#include <miopen/temp_file.hpp>
+
+#include "test.hpp"
+
+#include <cstddef>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using miopen::solver::SearchCheckpoint;
+using miopen::solver::SearchCheckpointDb;
+using miopen::solver::SearchCheckpointer;
+using miopen::solver::SearchOptions;
+using miopen::solver::SearchPlanner;
+using miopen::solver::SearchResult;
+
+static const std::size_t total = 100;
+
+/// Candidates divisible by 7 fail, the time is minimal at 43.
+static bool Fails(std::size_t i) { return i % 7 == 0; }
+static float Time(std::size_t i) { return 1.0f + (i > 43 ? i - 43 : 43 - i); }
+
+static SearchOptions Options(std::size_t shard = 0, std::size_t shards = 1)
+{
+    auto options   = SearchOptions{};
+    options.shard  = shard;
+    options.shards = shards;
+    return options;
+}
+
+/// Runs the search until max_evaluations are done, as a process that gets killed would, or to
+/// the end. Returns the candidates measured by this run.
+static std::vector<std::size_t> Search(const SearchCheckpointDb& db,
+                                       const SearchOptions& options,
+                                       std::size_t max_evaluations,
+                                       SearchResult& result)
+{
+    SearchPlanner planner{options, std::vector<std::vector<float>>(total)};
+    // Save after every evaluation.
+    SearchCheckpointer checkpointer{db, planner, options, total, 1e-9f};
+    auto measured = std::vector<std::size_t>{};
+    std::size_t i;
+    while(measured.size() < max_evaluations && planner.Next(i))
+    {
+        measured.push_back(i);
+        planner.Report(i, !Fails(i), Time(i));
+        checkpointer.Report(i, !Fails(i), Time(i));
+    }
+    if(measured.size() < max_evaluations)
+        checkpointer.Finish();
+    result = planner.GetResult();
+    return measured;
+}
+
+void check_serialization()
+{
+    auto checkpoint   = SearchCheckpoint{};
+    checkpoint.total  = 1728;
+    checkpoint.shard  = 2;
+    checkpoint.shards = 4;
+    checkpoint.evaluated.push_back({5, true, 0.0123f});
+    checkpoint.evaluated.push_back({9, false, 0.0f});
+
+    auto ss = std::ostringstream{};
+    checkpoint.Serialize(ss);
+    EXPECT(ss.str() == "1728,2,4,0,5/0.0123,9/-");
+
+    auto loaded = SearchCheckpoint{};
+    EXPECT(loaded.Deserialize(ss.str()));
+    EXPECT(loaded.total == 1728 && loaded.shard == 2 && loaded.shards == 4 && !loaded.done);
+    EXPECT(loaded.evaluated.size() == 2);
+    EXPECT(loaded.evaluated[0].candidate == 5 && loaded.evaluated[0].succeeded);
+    EXPECT(loaded.evaluated[0].time == 0.0123f);
+    EXPECT(loaded.evaluated[1].candidate == 9 && !loaded.evaluated[1].succeeded);
+
+    for(const auto& corrupt : {"", "1728,2,4", "1728,4,4,0", "10,0,1,0,12/1", "10,0,1,0,1/x"})
+        EXPECT(!loaded.Deserialize(corrupt));
+}
+
+void check_shards()
+{
+    // The shards split the space, and restored candidates are not picked again.
+    auto picked = std::set<std::size_t>{};
+    for(std::size_t shard = 0; shard < 3; ++shard)
+    {
+        SearchPlanner planner{Options(shard, 3), std::vector<std::vector<float>>(total)};
+        EXPECT(planner.Restore(shard, true, 1.0f));
+        EXPECT(!planner.Restore(shard, true, 1.0f));
+        EXPECT(!planner.Restore(shard + 1, true, 1.0f));
+        std::size_t i;
+        while(planner.Next(i))
+        {
+            EXPECT(i % 3 == shard);
+            EXPECT(picked.insert(i).second);
+            planner.Report(i, true, 2.0f);
+        }
+        EXPECT(planner.GetResult().evaluated == (total - shard + 2) / 3);
+        EXPECT(planner.GetResult().best == shard);
+    }
+    EXPECT(picked.size() == total - 3);
+}
+
+void check_resume()
+{
+    const miopen::TempFile file{"miopen.tests.search_checkpoint"};
+    const auto db = SearchCheckpointDb{file.Path(), "problem", "Solver"};
+
+    // Killed after 30 evaluations, then resumed.
+    auto result        = SearchResult{};
+    const auto killed  = Search(db, Options(), 30, result);
+    const auto resumed = Search(db, Options(), total, result);
+    EXPECT(killed.size() == 30);
+    EXPECT(resumed.size() == total - 30);
+    EXPECT(result.evaluated == total);
+    EXPECT(result.failed == (total + 6) / 7);
+    EXPECT(result.best == 43);
+
+    // The search is over, so the checkpoint is removed.
+    EXPECT(db.Load().empty());
+
+    // Checkpoints of other solvers and of other search spaces are not used.
+    const auto other = SearchCheckpointDb{file.Path(), "problem", "Solver2"};
+    Search(other, Options(), 10, result);
+    EXPECT(db.Load().empty());
+    EXPECT(other.Load().size() == 1);
+
+    auto stale  = SearchCheckpoint{};
+    stale.total = 50;
+    stale.evaluated.push_back({1, true, 1.0f});
+    db.Save(stale);
+    Search(db, Options(), 1, result);
+    EXPECT(result.evaluated == 1);
+}
+
+void check_merge()
+{
+    const miopen::TempFile file{"miopen.tests.search_checkpoint"};
+    const auto db = SearchCheckpointDb{file.Path(), "problem", "Solver"};
+
+    // Three workers search a shard each, one of them is killed. The search of the whole space
+    // only measures what the killed worker has not.
+    auto result = SearchResult{};
+    EXPECT(Search(db, Options(0, 3), total, result).size() == 34);
+    EXPECT(Search(db, Options(1, 3), 10, result).size() == 10);
+    EXPECT(Search(db, Options(2, 3), total, result).size() == 33);
+    EXPECT(result.best != 43);
+    EXPECT(db.Load().size() == 3);
+
+    const auto measured = Search(db, Options(), total, result);
+    EXPECT(measured.size() == 33 - 10);
+    for(const auto i : measured)
+        EXPECT(i % 3 == 1);
+    EXPECT(result.evaluated == total);
+    EXPECT(result.best == 43);
+    EXPECT(db.Load().empty());
+}
+
+int main()
+{
+    check_serialization();
+    check_shards();
+    check_resume();
+    check_merge();
+}
@@ -0,0 +1,191 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/search_strategy.hpp>
+
+#include "test.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+using miopen::solver::SearchOptions;
+using miopen::solver::SearchResult;
+using miopen::solver::SearchStrategy;
+
+/// A tuning space of 16 x 16 x 4 configs with a single minimum, where a quarter of the configs
+/// fail, like the ones that do not fit into LDS.
+struct MockSpace
+{
+    std::vector<std::vector<float>> features;
+    std::vector<std::size_t> calls;
+
+    MockSpace()
+    {
+        for(auto a = 1; a <= 16; ++a)
+            for(auto b = 1; b <= 16; ++b)
+                for(auto c = 0; c < 4; ++c)
+                    features.push_back(
+                        {static_cast<float>(a), static_cast<float>(b), static_cast<float>(c)});
+    }
+
+    static bool Fails(const std::vector<float>& f) { return f[0] > 12; }
+
+    static float Time(const std::vector<float>& f)
+    {
+        return 1.0f + (f[0] - 11) * (f[0] - 11) + (f[1] - 5) * (f[1] - 5) + 3 * f[2];
+    }
+
+    SearchResult Run(const SearchOptions& options,
+                     const std::vector<std::vector<float>>& tuned = {})
+    {
+        calls.clear();
+        return miopen::solver::RunSearch(
+            options, features, tuned, [&](std::size_t i, float& time) {
+                calls.push_back(i);
+                if(Fails(features[i]))
+                    return false;
+                time = Time(features[i]);
+                return true;
+            });
+    }
+
+    bool AllDistinct() const
+    {
+        return std::set<std::size_t>(calls.begin(), calls.end()).size() == calls.size();
+    }
+};
+
+static SearchOptions Options(SearchStrategy strategy, std::size_t evaluations = 0)
+{
+    auto options               = SearchOptions{};
+    options.strategy           = strategy;
+    options.budget.evaluations = evaluations;
+    return options;
+}
+
+void check_features()
+{
+    EXPECT(miopen::solver::GetConfigFeatures("16,4,1,0") == (std::vector<float>{16, 4, 1, 0}));
+    EXPECT(miopen::solver::GetConfigFeatures("0.5:x2") == (std::vector<float>{0.5f, 2}));
+    EXPECT(miopen::solver::GetConfigFeatures("").empty());
+}
+
+void check_exhaustive()
+{
+    auto space        = MockSpace{};
+    const auto result = space.Run(Options(SearchStrategy::Exhaustive));
+    EXPECT(result.evaluated == space.features.size());
+    EXPECT(result.failed == space.features.size() / 4);
+    EXPECT(result.best_time == 1.0f);
+    for(std::size_t i = 0; i < space.calls.size(); ++i)
+        EXPECT(space.calls[i] == i);
+
+    // Stops after 10 evaluations which have not improved the best time.
+    auto options            = Options(SearchStrategy::Exhaustive);
+    options.budget.patience = 10;
+    const auto patient      = space.Run(options);
+    EXPECT(patient.evaluated < space.features.size());
+    EXPECT(patient.evaluated == patient.best + 1 + 10);
+}
+
+void check_budget()
+{
+    auto space = MockSpace{};
+    for(const auto strategy : {SearchStrategy::Exhaustive,
+                               SearchStrategy::Random,
+                               SearchStrategy::Annealing,
+                               SearchStrategy::Model})
+    {
+        const auto result = space.Run(Options(strategy, 100));
+        EXPECT(result.evaluated == 100);
+        EXPECT(space.calls.size() == 100);
+        EXPECT(space.AllDistinct());
+        EXPECT(result.best != SearchResult::none);
+        EXPECT(space.Time(space.features[result.best]) == result.best_time);
+
+        // Without a budget, every strategy eventually evaluates every config once.
+        const auto all = space.Run(Options(strategy));
+        EXPECT(all.evaluated == space.features.size());
+        EXPECT(space.AllDistinct());
+        EXPECT(all.best_time == 1.0f);
+    }
+}
+
+void check_outstanding()
+{
+    // Candidates may be taken ahead of their reports, e.g. to compile them in advance. The
+    // budget counts them when they are taken.
+    const auto space = MockSpace{};
+    for(const auto strategy : {SearchStrategy::Random, SearchStrategy::Model})
+    {
+        miopen::solver::SearchPlanner planner{Options(strategy, 10), space.features};
+        std::vector<std::size_t> outstanding(4);
+        auto taken = std::size_t{0};
+        for(auto& candidate : outstanding)
+            taken += planner.Next(candidate) ? 1 : 0;
+        EXPECT(taken == 4);
+        EXPECT(std::set<std::size_t>(outstanding.begin(), outstanding.end()).size() == 4);
+
+        std::size_t candidate;
+        while(planner.Next(candidate))
+        {
+            ++taken;
+            planner.Report(candidate, !space.Fails(space.features[candidate]), 1.0f);
+        }
+        EXPECT(taken == 10);
+    }
+}
+
+void check_convergence()
+{
+    // With a tenth of the evaluations, the guided strategies get close to the optimum, while
+    // the exhaustive one does not even reach it.
+    auto space = MockSpace{};
+    EXPECT(space.Run(Options(SearchStrategy::Exhaustive, 100)).best_time > 10.0f);
+    EXPECT(space.Run(Options(SearchStrategy::Annealing, 100)).best_time <= 4.0f);
+    EXPECT(space.Run(Options(SearchStrategy::Model, 100)).best_time <= 4.0f);
+}
+
+void check_model_prior()
+{
+    // Configs tuned for other problems are tried first.
+    auto space        = MockSpace{};
+    const auto tuned  = std::vector<std::vector<float>>{{11, 5, 0}, {11, 6, 0}, {10, 5, 0}};
+    const auto result = space.Run(Options(SearchStrategy::Model, 1), tuned);
+    EXPECT(result.best_time == 1.0f);
+}
+
+int main()
+{
+    check_features();
+    check_exhaustive();
+    check_budget();
+    check_outstanding();
+    check_convergence();
+    check_model_prior();
+}
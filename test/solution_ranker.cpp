@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/solution_ranker.hpp>
+
+#include "test.hpp"
+
+#include <string>
+#include <vector>
+
+static void check_parse()
+{
+    auto shape = miopen::ConvShape{};
+
+    EXPECT(miopen::ConvShape::Parse("64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-F", shape));
+    EXPECT(shape.kind == "2-NCHW-FP32-F");
+    EXPECT(shape.features.size() == 16);
+    EXPECT(shape.roofline > 0.0);
+
+    EXPECT(miopen::ConvShape::Parse(
+        "32-4-28-28-3x3x3-32-4-28-28-8-1x1x1-1x1x1-1x1x1-0-NCDHW-FP16-B", shape));
+    EXPECT(shape.kind == "3-NCDHW-FP16-B");
+    EXPECT(shape.features.size() == 22);
+
+    auto grouped = miopen::ConvShape{};
+    EXPECT(miopen::ConvShape::Parse("64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-W_g64",
+                                    grouped));
+    EXPECT(grouped.kind == "2-NCHW-FP32-W");
+
+    // Depthwise convolution does 64 times less arithmetic.
+    miopen::ConvShape::Parse("64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-W", shape);
+    EXPECT(grouped.roofline < shape.roofline);
+    EXPECT(grouped.Distance(shape) > 0.0);
+    EXPECT(shape.Distance(shape) == 0.0);
+
+    EXPECT(!miopen::ConvShape::Parse("", shape));
+    EXPECT(!miopen::ConvShape::Parse("gfx906_64", shape));
+    EXPECT(!miopen::ConvShape::Parse("64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-X", shape));
+    EXPECT(
+        !miopen::ConvShape::Parse("64-56-56-3x3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-F", shape));
+    EXPECT(
+        !miopen::ConvShape::Parse("64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-F_g0", shape));
+}
+
+static void check_rank()
+{
+    auto ranker = miopen::SolutionRanker{};
+    EXPECT(!ranker.Add("not a key", {{"gemm", 1.0f}}));
+
+    // Winograd is fast on 3x3 filters and GEMM on 1x1 ones.
+    EXPECT(ranker.Add("64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-F",
+                      {{"ConvBinWinograd3x3U", 1.0f}, {"gemm", 4.0f}}));
+    EXPECT(ranker.Add("128-28-28-3x3-128-28-28-16-1x1-1x1-1x1-0-NCHW-FP32-F",
+                      {{"ConvBinWinograd3x3U", 1.0f}, {"gemm", 4.0f}}));
+    EXPECT(ranker.Add("64-56-56-1x1-256-56-56-16-0x0-1x1-1x1-0-NCHW-FP32-F",
+                      {{"ConvOclDirectFwd1x1", 3.0f}, {"gemm", 1.0f}}));
+    EXPECT(ranker.Add("128-28-28-1x1-512-28-28-16-0x0-1x1-1x1-0-NCHW-FP32-F",
+                      {{"ConvOclDirectFwd1x1", 3.0f}, {"gemm", 1.0f}}));
+    // Other directions do not count.
+    EXPECT(ranker.Add("64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-B",
+                      {{"ConvBinWinograd3x3U", 9.0f}, {"gemm", 1.0f}}));
+    EXPECT(ranker.GetSamples().size() == 5);
+
+    const auto candidates =
+        std::vector<std::string>{"gemm", "ConvBinWinograd3x3U", "ConvOclDirectFwd1x1"};
+
+    auto ranked = ranker.Rank("96-40-40-3x3-96-40-40-16-1x1-1x1-1x1-0-NCHW-FP32-F", candidates);
+    EXPECT(ranked.size() == 3);
+    EXPECT(ranked[0].solver == "ConvBinWinograd3x3U");
+    EXPECT(ranked[1].solver == "gemm");
+    EXPECT(ranked[2].solver == "ConvOclDirectFwd1x1");
+    EXPECT(ranked[0].time > 0.0f);
+    EXPECT(ranked[0].time < ranked[1].time);
+    EXPECT(ranked[1].time < ranked[2].time);
+
+    // Only the applicable solvers are candidates.
+    ranked = ranker.Rank("96-40-40-1x1-384-40-40-16-0x0-1x1-1x1-0-NCHW-FP32-F",
+                         {"ConvOclDirectFwd1x1", "gemm"});
+    EXPECT(ranked.size() == 2);
+    EXPECT(ranked[0].solver == "gemm");
+
+    // A sample excluded from its own ranking.
+    const auto key = std::string{"64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-F"};
+    ranked         = ranker.Rank(key, {"ConvBinWinograd3x3U"}, key);
+    EXPECT(ranked.size() == 1);
+    EXPECT(ranked[0].time > 0.0f);
+
+    // Unknown problems and solvers.
+    ranked = ranker.Rank("64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP16-F", candidates);
+    EXPECT(ranked.size() == 3);
+    EXPECT(ranked[0].solver == "gemm");
+    EXPECT(ranked[0].time > 0.0f);
+    ranked = ranker.Rank("not a key", candidates);
+    EXPECT(ranked.size() == 3);
+    EXPECT(ranked[0].time < 0.0f);
+
+    // Nothing to rank.
+    EXPECT(miopen::SolutionRanker{}.Rank(key, {}).empty());
+}
+
+int main()
+{
+    check_parse();
+    check_rank();
+}
@@ -33,6 +33,7 @@
 
 #include <cstdlib>
 #include <functional>
+#include <limits>
 #include <sstream>
 #include <typeinfo>
 
@@ -167,12 +168,42 @@ class SolverTest
         EXPECT_EQUAL(searches, searchable_solver.searches_done());
     }
 
+    void RunParallel() const
+    {
+        const TempFile db_path("miopen.tests.solver.parallel");
+        PlainTextDb db(db_path);
+
+        const auto solvers = solver::SolverContainer<TrivialTestSolver,
+                                                     SearchableTestSolver,
+                                                     TrivialTestSolver,
+                                                     SearchableTestSolver,
+                                                     TrivialTestSolver>{};
+
+        for(const auto& in : {std::initializer_list<size_t>{0, 0, 0, 1}, {0, 0, 0, 0}})
+        {
+            const auto ctx = MakeContext(in);
+
+            for(const std::size_t limit : {std::numeric_limits<std::size_t>::max(),
+                                           std::size_t{1},
+                                           std::size_t{3}})
+            {
+                const auto serial = solvers.SearchForAllSolutions(ctx, db, limit);
+                const auto parallel =
+                    solvers.SearchForAllSolutionsParallel<solver::ConvSolution>(ctx, db, limit, 4);
+
+                EXPECT_EQUAL(serial.size(), parallel.size());
+                for(std::size_t i = 0; i < serial.size(); ++i)
+                {
+                    EXPECT_EQUAL(serial[i].solver_id, parallel[i].solver_id);
+                    EXPECT_EQUAL(serial[i].construction_params[0].kernel_file,
+                                 parallel[i].construction_params[0].kernel_file);
+                }
+            }
+        }
+    }
+
     private:
-    static void ConstructTest(const std::string& db_path,
-                              const char* expected_kernel,
-                              const std::initializer_list<size_t>& in,
-                              const std::function<void(ConvolutionContext&)>& context_filler =
-                                  [](ConvolutionContext&) {})
+    static ConvolutionContext MakeContext(const std::initializer_list<size_t>& in)
     {
         auto ctx = ConvolutionContext{TensorDescriptor{miopenFloat, in},
                                       TensorDescriptor{miopenFloat, in},
@@ -180,6 +211,16 @@ class SolverTest
                                       ConvolutionDescriptor{},
                                       conv::Direction::Forward};
         ctx.SetStream(&get_handle());
+        return ctx;
+    }
+
+    static void ConstructTest(const std::string& db_path,
+                              const char* expected_kernel,
+                              const std::initializer_list<size_t>& in,
+                              const std::function<void(ConvolutionContext&)>& context_filler =
+                                  [](ConvolutionContext&) {})
+    {
+        auto ctx = MakeContext(in);
         context_filler(ctx);
 
         const auto sol = FindSolution(ctx, db_path);
@@ -191,4 +232,8 @@ class SolverTest
 } // namespace tests
 } // namespace miopen
 
-int main() { miopen::tests::SolverTest().Run(); }
+int main()
+{
+    miopen::tests::SolverTest().Run();
+    miopen::tests::SolverTest().RunParallel();
+}
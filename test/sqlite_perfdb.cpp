@@ -458,6 +458,52 @@ class DbOperationsTest : public DbTest
     }
 };
 
+class DbImportExportTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db for bulk import and export..." << std::endl;
+
+        ResetDb();
+        const ProblemData p0(1);
+        const ProblemData p1(2);
+        TempFile source_file("miopen.tests.perfdb.source");
+        TempFile target_file("miopen.tests.perfdb.target");
+
+        {
+            SQLitePerfDb source(std::string(source_file), false, "gfx906", 64);
+            EXPECT(source.Update(p0, id0(), value0()));
+            EXPECT(source.Update(p1, id2(), value2()));
+        }
+
+        SolverData read;
+
+        {
+            SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+            EXPECT(db.Update(p0, id0(), value2()));
+            EXPECT(db.Update(p0, id1(), value1()));
+
+            // Records from the source replace the ones with the same config and solver.
+            EXPECT(db.ImportRecords(source_file));
+            EXPECT(db.Load(p1, id2(), read));
+            EXPECT_EQUAL(read, value2());
+
+            EXPECT(!db.ImportRecords(std::string(source_file) + ".missing"));
+            EXPECT(db.ExportRecords(target_file));
+        }
+
+        ValidateSingleEntry(
+            p0, common_data(), SQLitePerfDb(std::string(temp_file), false, "gfx906", 64));
+        ValidateSingleEntry(
+            p0, common_data(), SQLitePerfDb(std::string(target_file), false, "gfx906", 64));
+
+        SQLitePerfDb target(std::string(target_file), false, "gfx906", 64);
+        EXPECT(target.Load(p1, id2(), read));
+        EXPECT_EQUAL(read, value2());
+    }
+};
+
 class DbParallelTest : public DbTest
 {
     public:
@@ -1247,6 +1293,7 @@ struct PerfDbDriver : test_driver
         }
         DbFindTest().Run();
         DbOperationsTest().Run();
+        DbImportExportTest().Run();
         DbParallelTest().Run();
         DbMultiThreadedTest().Run();
         DbMultiThreadedReadTest().Run();
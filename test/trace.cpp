@@ -0,0 +1,212 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/trace.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include "test.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::string GetTrace()
+{
+    std::ostringstream ss;
+    miopen::trace::WriteChromeTrace(ss);
+    return ss.str();
+}
+
+static std::size_t Count(const std::string& text, const std::string& what)
+{
+    std::size_t count = 0;
+    for(auto pos = text.find(what); pos != std::string::npos; pos = text.find(what, pos + 1))
+        ++count;
+    return count;
+}
+
+void check_disabled()
+{
+    miopen::trace::Enable(false);
+    miopen::trace::Clear();
+
+    auto evaluated = false;
+    {
+        MIOPEN_TRACE_SPAN("test", "disabled");
+        MIOPEN_TRACE_SPAN_DETAIL("test", "disabled", (evaluated = true, std::string{"detail"}));
+    }
+    EXPECT(!evaluated);
+    EXPECT(Count(GetTrace(), "\"ph\":\"X\"") == 0);
+}
+
+void check_spans()
+{
+    miopen::trace::Enable(true);
+    miopen::trace::Clear();
+    {
+        MIOPEN_TRACE_SPAN("test", "outer");
+        {
+            MIOPEN_TRACE_SPAN_DETAIL("test", "inner", std::string{"say \"hi\"\n"});
+        }
+    }
+    miopen::trace::Enable(false);
+
+    const auto trace = GetTrace();
+    EXPECT(trace.front() == '{');
+    EXPECT(Count(trace, "\"ph\":\"X\"") == 2);
+    EXPECT(Count(trace, "\"name\":\"outer\",\"cat\":\"test\"") == 1);
+    EXPECT(Count(trace, "\"name\":\"inner\",\"cat\":\"test\"") == 1);
+    EXPECT(Count(trace, "\"args\":{\"detail\":\"say \\\"hi\\\"\\n\"}") == 1);
+    // Sorted by start time, so the enclosing span goes first.
+    EXPECT(trace.find("\"outer\"") < trace.find("\"inner\""));
+    EXPECT(Count(trace, "\"thread_name\"") == 1);
+}
+
+void check_threads()
+{
+    const auto threads = 4;
+    const auto spans   = 100;
+
+    miopen::trace::Enable(true);
+    miopen::trace::Clear();
+    // Threads started one after another reuse the buffers of the finished ones.
+    for(auto round = 0; round < 2; ++round)
+    {
+        std::vector<std::thread> workers;
+        for(auto i = 0; i < threads; ++i)
+        {
+            workers.emplace_back([&]() {
+                for(auto j = 0; j < spans; ++j)
+                    MIOPEN_TRACE_SPAN("test", "worker");
+            });
+        }
+        for(auto& worker : workers)
+            worker.join();
+    }
+    miopen::trace::Enable(false);
+
+    const auto trace = GetTrace();
+    EXPECT(Count(trace, "\"name\":\"worker\"") == 2 * threads * spans);
+    EXPECT(Count(trace, "\"thread_name\"") == 2 * threads);
+}
+
+void check_overflow()
+{
+    // The default capacity of a thread buffer.
+    const auto capacity = 16384;
+
+    miopen::trace::Enable(true);
+    miopen::trace::Clear();
+    std::thread([&]() {
+        {
+            MIOPEN_TRACE_SPAN("test", "first");
+        }
+        for(auto i = 0; i < capacity; ++i)
+            MIOPEN_TRACE_SPAN("test", "next");
+    }).join();
+    miopen::trace::Enable(false);
+
+    const auto trace = GetTrace();
+    EXPECT(Count(trace, "\"name\":\"next\"") == capacity);
+    // The oldest event has been overwritten.
+    EXPECT(Count(trace, "\"name\":\"first\"") == 0);
+}
+
+void check_enabled_after_pool()
+{
+    const auto n = 64;
+
+    // The threads of the pool start before the trace registry exists and record into it until
+    // they exit, after the static objects constructed later have been destroyed.
+    auto& pool = miopen::ThreadPool::Get();
+    miopen::trace::Enable(true);
+    miopen::trace::Clear();
+    std::atomic<int> running{n};
+    for(auto i = 0; i < n; ++i)
+    {
+        pool.Submit([&]() {
+            {
+                MIOPEN_TRACE_SPAN("test", "pooled");
+            }
+            --running;
+        });
+    }
+    while(running != 0)
+        std::this_thread::yield();
+    miopen::trace::Enable(false);
+
+    EXPECT(Count(GetTrace(), "\"name\":\"pooled\"") == n);
+}
+
+void check_collect_while_recording()
+{
+    const auto threads = 4;
+    const auto spans   = 2000;
+
+    miopen::trace::Enable(true);
+    miopen::trace::Clear();
+    // Events are appended without a lock, so reading them meanwhile must see whole events only.
+    std::atomic<int> running{threads};
+    std::vector<std::thread> workers;
+    for(auto i = 0; i < threads; ++i)
+    {
+        workers.emplace_back([&]() {
+            for(auto j = 0; j < spans; ++j)
+                MIOPEN_TRACE_SPAN_DETAIL("test", "recorded", std::to_string(j));
+            --running;
+        });
+    }
+    auto last = std::size_t{0};
+    while(running != 0)
+    {
+        const auto count = Count(GetTrace(), "\"name\":\"recorded\"");
+        EXPECT(count >= last);
+        last = count;
+    }
+    for(auto& worker : workers)
+        worker.join();
+    miopen::trace::Enable(false);
+
+    EXPECT(Count(GetTrace(), "\"name\":\"recorded\"") == threads * spans);
+}
+
+int main()
+{
+#if MIOPEN_ENABLE_TRACE
+    // First, as the registry must not exist yet.
+    check_enabled_after_pool();
+#endif
+    check_disabled();
+#if MIOPEN_ENABLE_TRACE
+    check_spans();
+    check_threads();
+    check_overflow();
+    check_collect_while_recording();
+#endif
+}
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_cache.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void PrintHelp()
+{
+    std::cout << "Usage: MIOpenCacheCompact {<option>}" << std::endl;
+    std::cout << "Deduplicates identical kernel binaries in user kernel caches and removes the "
+                 "binaries no kernel refers to anymore."
+              << std::endl;
+    std::cout << "Option format: -<option name>[ <option value>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "-p[ath] <path>: kernel database or kernel cache directory to compact. May be "
+                 "repeated. Defaults to the user kernel cache directory."
+              << std::endl;
+}
+
+[[gnu::noreturn]] void WrongUsage(const std::string& error)
+{
+    std::cout << "Wrong usage: " << error << std::endl;
+    std::cout << std::endl;
+    PrintHelp();
+    std::exit(1);
+}
+
+int main(int argsn, char** args)
+{
+    std::vector<boost::filesystem::path> paths;
+
+    for(int i = 1; i < argsn; ++i)
+    {
+        std::string arg(args[i] + 1);
+        std::transform(arg.begin(), arg.end(), arg.begin(), ::tolower);
+
+        if(arg == "h" || arg == "help")
+        {
+            PrintHelp();
+            return 0;
+        }
+
+        if(i + 1 >= argsn)
+            WrongUsage("value is missing for " + arg);
+
+        if(arg == "p" || arg == "path")
+            paths.push_back(args[++i]);
+        else
+            WrongUsage("unknown argument - " + arg);
+    }
+
+    if(paths.empty())
+    {
+        const auto user_cache = miopen::GetCachePath(false);
+        if(user_cache.empty())
+        {
+            std::cerr << "The user kernel cache is disabled" << std::endl;
+            return 1;
+        }
+        paths.push_back(user_cache);
+    }
+
+    auto success = true;
+    for(const auto& path : paths)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        try
+        {
+            const auto freed = miopen::CompactBinaryCache(path);
+            const auto time =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+            std::cout << "Compacted " << path.string() << ": " << freed << " bytes freed in "
+                      << time.count() << " s" << std::endl;
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << "Unable to compact " << path.string() << ": " << ex.what() << std::endl;
+            success = false;
+        }
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+void PrintHelp()
+{
+    std::cout << "Usage: MIOpenDbMerge {<option>}" << std::endl;
+    std::cout << "Merges performance or find databases, e.g. the outputs of tuning on several "
+                 "machines, into one database."
+              << std::endl;
+    std::cout << "Databases with the .txt extension are merged as text databases, the rest as "
+                 "SQLite performance databases."
+              << std::endl;
+    std::cout << "Records of later sources take precedence over the earlier ones and over the "
+                 "ones already in the target."
+              << std::endl;
+    std::cout << "Option format: -<option name>[ <option value>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "[REQUIRED] -s[ource] <path>: database to merge. May be repeated." << std::endl;
+    std::cout << "[REQUIRED] -t[arget] <path>: database to merge into. Created if missing."
+              << std::endl;
+}
+
+[[gnu::noreturn]] void WrongUsage(const std::string& error)
+{
+    std::cout << "Wrong usage: " << error << std::endl;
+    std::cout << std::endl;
+    PrintHelp();
+    std::exit(1);
+}
+
+static bool IsTextDb(const std::string& path) { return boost::algorithm::ends_with(path, ".txt"); }
+
+static bool MergeTextDbs(const std::vector<std::string>& source_paths,
+                         const std::string& target_path)
+{
+    auto records = std::vector<miopen::DbRecord>{};
+
+    for(const auto& source_path : source_paths)
+    {
+        auto source_records = miopen::PlainTextDb{source_path, true}.ExportRecords();
+        std::cout << source_path << ": " << source_records.size() << " records" << std::endl;
+        std::move(source_records.begin(), source_records.end(), std::back_inserter(records));
+    }
+
+    return miopen::PlainTextDb{target_path}.UpdateRecords(records);
+}
+
+#if MIOPEN_ENABLE_SQLITE
+static bool MergeSQLiteDbs(const std::vector<std::string>& source_paths,
+                           const std::string& target_path)
+{
+    auto target = miopen::SQLitePerfDb{target_path, false, "", 0};
+
+    for(const auto& source_path : source_paths)
+    {
+        std::cout << source_path << std::endl;
+        if(!target.ImportRecords(source_path))
+            return false;
+    }
+
+    return true;
+}
+#endif
+
+int main(int argsn, char** args)
+{
+    if(argsn == 1)
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    std::vector<std::string> source_paths;
+    std::string target_path;
+
+    for(int i = 1; i < argsn; ++i)
+    {
+        std::string arg(args[i] + 1);
+        std::transform(arg.begin(), arg.end(), arg.begin(), ::tolower);
+
+        if(i + 1 >= argsn)
+            WrongUsage("value is missing for " + arg);
+
+        if(arg == "s" || arg == "source")
+            source_paths.push_back(args[++i]);
+        else if(arg == "t" || arg == "target")
+            target_path = boost::filesystem::absolute(args[++i]).string();
+        else
+            WrongUsage("unknown argument - " + arg);
+    }
+
+    if(source_paths.empty() || target_path.empty())
+        WrongUsage("source and target are required");
+
+    const auto is_text = IsTextDb(target_path);
+    if(std::any_of(source_paths.begin(), source_paths.end(), [&](const std::string& path) {
+           return IsTextDb(path) != is_text;
+       }))
+        WrongUsage("sources and target shall be of the same database format");
+
+#if !MIOPEN_ENABLE_SQLITE
+    if(!is_text)
+    {
+        std::cerr << "MIOpen is built without SQLite support" << std::endl;
+        return 1;
+    }
+#endif
+
+    const auto start = std::chrono::steady_clock::now();
+    auto success     = false;
+
+    try
+    {
+#if MIOPEN_ENABLE_SQLITE
+        success = is_text ? MergeTextDbs(source_paths, target_path)
+                          : MergeSQLiteDbs(source_paths, target_path);
+#else
+        success = MergeTextDbs(source_paths, target_path);
+#endif
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+    }
+
+    if(!success)
+    {
+        std::cerr << "Unable to merge into: " << target_path << std::endl;
+        return 1;
+    }
+
+    const auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    std::cout << "Merged " << source_paths.size() << " databases into " << target_path << " in "
+              << time.count() << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,216 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/solution_ranker.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+void PrintHelp()
+{
+    std::cout << "Usage: MIOpenFallbackEval {<option>}" << std::endl;
+    std::cout << "Validates the solution ranking of the immediate mode fallback on find databases."
+              << std::endl;
+    std::cout << "Each record is ranked by the rest of its database (leave-one-out) and the "
+                 "solution ranked first is compared to the fastest of them measured."
+              << std::endl;
+    std::cout << "As in the library, only GEMM and the solvers which support invokers are "
+                 "ranked."
+              << std::endl;
+    std::cout << "Option format: -<option name>[ <option value>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "[REQUIRED] -d[b] <path>: find database (*.fdb.txt). May be repeated."
+              << std::endl;
+}
+
+[[gnu::noreturn]] void WrongUsage(const std::string& error)
+{
+    std::cout << "Wrong usage: " << error << std::endl;
+    std::cout << std::endl;
+    PrintHelp();
+    std::exit(1);
+}
+
+struct Accuracy
+{
+    std::size_t problems  = 0;
+    std::size_t hits      = 0;
+    std::size_t near_hits = 0;
+    double log_slowdown   = 0.0;
+    std::size_t gemm      = 0;
+    double gemm_slowdown  = 0.0;
+    /// Against the fastest of all measured solvers, including those the fallback cannot offer.
+    double find_slowdown  = 0.0;
+
+    void Add(float best, float chosen, float gemm_time, float best_of_all)
+    {
+        ++problems;
+        find_slowdown += std::log(chosen / best_of_all);
+        if(chosen <= best)
+            ++hits;
+        if(chosen <= 1.1f * best)
+            ++near_hits;
+        log_slowdown += std::log(chosen / best);
+        if(gemm_time > 0.0f)
+        {
+            ++gemm;
+            gemm_slowdown += std::log(gemm_time / best);
+        }
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const Accuracy& a)
+    {
+        stream << a.problems << " problems, best ranked first: " << 100.0 * a.hits / a.problems
+               << "%, within 10% of the best: " << 100.0 * a.near_hits / a.problems
+               << "%, slowdown: " << std::exp(a.log_slowdown / a.problems);
+        if(a.gemm != 0)
+            stream << " (GEMM only: " << std::exp(a.gemm_slowdown / a.gemm) << ")";
+        stream << ", slowdown vs. all solvers: " << std::exp(a.find_slowdown / a.problems);
+        return stream;
+    }
+};
+
+static miopen::conv::Direction GetDirection(char direction)
+{
+    switch(direction)
+    {
+    case 'F': return miopen::conv::Direction::Forward;
+    case 'B': return miopen::conv::Direction::BackwardData;
+    default: return miopen::conv::Direction::BackwardWeights;
+    }
+}
+
+// The fallback of the library offers only these, the other solvers need a find-db record to run.
+static bool IsOffered(const std::string& solver, miopen::conv::Direction direction)
+{
+    if(solver == "gemm")
+        return true;
+    const auto id = miopen::solver::Id{solver};
+    return id.IsValid() && miopen::CheckInvokerSupport(id.GetAlgo(direction));
+}
+
+static void Evaluate(const std::string& path)
+{
+    miopen::SolutionRanker ranker;
+    ranker.Load(path);
+
+    auto total        = Accuracy{};
+    auto by_direction = std::map<char, Accuracy>{};
+
+    for(const auto& sample : ranker.GetSamples())
+    {
+        const auto direction = GetDirection(sample.shape.kind.back());
+        std::vector<std::string> candidates;
+        auto best        = 0.0f;
+        auto gemm_time   = 0.0f;
+        auto best_of_all = 0.0f;
+        for(const auto& time : sample.times)
+        {
+            if(!(time.second > 0.0f))
+                continue;
+            if(best_of_all == 0.0f || time.second < best_of_all)
+                best_of_all = time.second;
+            if(!IsOffered(time.first, direction))
+                continue;
+            candidates.push_back(time.first);
+            if(best == 0.0f || time.second < best)
+                best = time.second;
+            if(time.first == "gemm")
+                gemm_time = time.second;
+        }
+        // There is nothing to choose from.
+        if(candidates.size() < 2)
+            continue;
+
+        // GEMM is the first candidate, as in the library.
+        std::stable_partition(candidates.begin(), candidates.end(), [](const std::string& s) {
+            return s == "gemm";
+        });
+        const auto ranked = ranker.Rank(sample.key, candidates, sample.key);
+        const auto chosen = std::find_if(sample.times.begin(),
+                                         sample.times.end(),
+                                         [&](const std::pair<std::string, float>& time) {
+                                             return time.first == ranked.front().solver;
+                                         })
+                                ->second;
+
+        total.Add(best, chosen, gemm_time, best_of_all);
+        by_direction[sample.shape.kind.back()].Add(best, chosen, gemm_time, best_of_all);
+    }
+
+    std::cout << path << ": " << ranker.GetSamples().size() << " records" << std::endl;
+    for(const auto& direction : by_direction)
+        std::cout << "  " << direction.first << ": " << direction.second << std::endl;
+    std::cout << "  all: " << total << std::endl;
+}
+
+int main(int argsn, char** args)
+{
+    if(argsn == 1)
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    std::vector<std::string> paths;
+
+    for(int i = 1; i < argsn; ++i)
+    {
+        std::string arg(args[i] + 1);
+        std::transform(arg.begin(), arg.end(), arg.begin(), ::tolower);
+
+        if(i + 1 >= argsn)
+            WrongUsage("value is missing for " + arg);
+
+        if(arg == "d" || arg == "db")
+            paths.push_back(args[++i]);
+        else
+            WrongUsage("unknown argument - " + arg);
+    }
+
+    if(paths.empty())
+        WrongUsage("a database is required");
+
+    try
+    {
+        for(const auto& path : paths)
+            Evaluate(path);
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}